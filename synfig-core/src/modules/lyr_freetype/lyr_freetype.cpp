@@ -41,6 +41,11 @@
 
 #include <pango/pangocairo.h>
 
+#include <climits>
+#include <cstdlib>
+#include <list>
+#include <map>
+
 #include "lyr_freetype.h"
 
 #include <synfig/localization.h>
@@ -77,23 +82,219 @@ SYNFIG_LAYER_SET_CVS_ID(Layer_Freetype,"$Id$");
 
 /* === P R O C E D U R E S ================================================= */
 
-/*Glyph::~Glyph()
+namespace {
+
+//! Guards FreeType library, shared faces and the glyph cache
+synfig::RecMutex freetype_mutex;
+
+/*!	\class GlyphCache
+**	\brief Loaded outlines and rendered bitmaps of glyphs
+**
+**	Glyphs are keyed by face, char size, glyph index and hinting mode.
+**	Entries are not evicted while text is rendered, so cached glyphs
+**	stay valid until trim() is called at the end of the render.
+**	Memory limit may be changed by SYNFIG_TEXT_GLYPH_CACHE_MB
+**	environment variable (default is 32 Mb).
+*/
+class GlyphCache
 {
-	if(glyph)FT_Done_Glyph(glyph);
-}
+public:
+	struct Key
+	{
+		FT_Face face;
+		int res_x, res_y;
+		FT_UInt index;
+		bool grid_fit;
+
+		Key(FT_Face face, int res_x, int res_y, FT_UInt index, bool grid_fit):
+			face(face), res_x(res_x), res_y(res_y), index(index), grid_fit(grid_fit) { }
+
+		bool operator< (const Key &other) const
+		{
+			if (face != other.face) return face < other.face;
+			if (res_x != other.res_x) return res_x < other.res_x;
+			if (res_y != other.res_y) return res_y < other.res_y;
+			if (index != other.index) return index < other.index;
+			return grid_fit < other.grid_fit;
+		}
+	};
+
+	struct Entry
+	{
+		FT_Glyph outline;
+		FT_BitmapGlyph bitmap;
+		FT_Vector advance;
+		size_t size;
+		std::list<Key>::iterator lru_position;
+	};
+
+private:
+	typedef std::map<Key, Entry> Map;
+
+	Map glyphs;
+	std::list<Key> lru;
+	size_t size;
+	size_t max_size;
+
+	void erase(Map::iterator i)
+	{
+		if (i->second.bitmap) FT_Done_Glyph((FT_Glyph)i->second.bitmap);
+		if (i->second.outline) FT_Done_Glyph(i->second.outline);
+		size -= i->second.size;
+		lru.erase(i->second.lru_position);
+		glyphs.erase(i);
+	}
+
+public:
+	GlyphCache(): size(0), max_size(32*1024*1024)
+	{
+		if (const char *s = getenv("SYNFIG_TEXT_GLYPH_CACHE_MB"))
+			max_size = (size_t)std::max(0, atoi(s))*1024*1024;
+	}
+
+	//! Face should have char size which matches the key
+	const Entry* get(const Key &key)
+	{
+		Map::iterator i = glyphs.find(key);
+		if (i != glyphs.end())
+		{
+			lru.splice(lru.begin(), lru, i->second.lru_position);
+			return &i->second;
+		}
+
+		FT_Error error;
+		if(key.grid_fit)
+			error = FT_Load_Glyph( key.face, key.index, FT_LOAD_DEFAULT);
+		else
+			error = FT_Load_Glyph( key.face, key.index, FT_LOAD_DEFAULT|FT_LOAD_NO_HINTING );
+		if (error) return NULL;
+
+		Entry entry;
+		error = FT_Get_Glyph( key.face->glyph, &entry.outline );
+		if (error) return NULL;
+		entry.advance = key.face->glyph->advance;
+		entry.size = sizeof(Entry) + 2*sizeof(Key);
+		if (entry.outline->format == FT_GLYPH_FORMAT_OUTLINE)
+		{
+			const FT_Outline &outline = ((FT_OutlineGlyph)entry.outline)->outline;
+			entry.size += sizeof(FT_OutlineGlyphRec)
+			            + outline.n_points*(sizeof(FT_Vector) + sizeof(char))
+			            + outline.n_contours*sizeof(short);
+		}
+
+		// keep outline, it used to calculate height of lines
+		FT_Glyph image = entry.outline;
+		entry.bitmap = NULL;
+		if (!FT_Glyph_To_Bitmap( &image, ft_render_mode_normal, 0, 0 ))
+		{
+			entry.bitmap = (FT_BitmapGlyph)image;
+			entry.size += sizeof(FT_BitmapGlyphRec)
+			            + entry.bitmap->bitmap.rows*abs(entry.bitmap->bitmap.pitch);
+		}
+
+		lru.push_front(key);
+		entry.lru_position = lru.begin();
+		size += entry.size;
+		return &(glyphs[key] = entry);
+	}
+
+	//! Removes glyphs of face before it will be closed
+	void forget_face(FT_Face face)
+	{
+		Map::iterator i = glyphs.lower_bound(Key(face, INT_MIN, INT_MIN, 0, false));
+		while(i != glyphs.end() && i->first.face == face)
+			erase(i++);
+	}
+
+	//! Removes least recently used glyphs to fit into memory limit
+	void trim()
+	{
+		while(size > max_size && !lru.empty())
+			erase(glyphs.find(lru.back()));
+	}
+};
+
+/*!	\class FaceCache
+**	\brief Opened faces shared between all text layers of the process
+**
+**	Few recently released faces are kept opened, so layers which
+**	switch fonts or are recreated (cloned for rendering) don't search
+**	and load font files again.
 */
-void
-TextLine::clear_and_free()
+class FaceCache
 {
-	std::vector<Glyph>::iterator iter;
-	for(iter=glyph_table.begin();iter!=glyph_table.end();++iter)
+public:
+	static const size_t max_unused_faces = 16;
+
+private:
+	struct Entry
+	{
+		FT_Face face;
+		int refs;
+		Entry(): face(NULL), refs(0) { }
+	};
+
+	typedef std::map<String, Entry> Map;
+
+	Map faces;
+	std::list<String> unused;
+
+public:
+	FT_Face acquire(const String &key)
+	{
+		Map::iterator i = faces.find(key);
+		if (i == faces.end())
+			return NULL;
+		if (i->second.refs++ == 0)
+			unused.remove(key);
+		return i->second.face;
+	}
+
+	void add(const String &key, FT_Face face)
+	{
+		Entry &entry = faces[key];
+		assert(!entry.face);
+		entry.face = face;
+		entry.refs = 1;
+	}
+
+	void release(FT_Face face, GlyphCache &glyph_cache)
 	{
-		if(iter->glyph)FT_Done_Glyph(iter->glyph);
-		iter->glyph=0;
+		for(Map::iterator i = faces.begin(); i != faces.end(); ++i)
+		{
+			if (i->second.face != face) continue;
+			if (--i->second.refs > 0) return;
+
+			unused.push_front(i->first);
+			while(unused.size() > max_unused_faces)
+			{
+				Map::iterator j = faces.find(unused.back());
+				glyph_cache.forget_face(j->second.face);
+				FT_Done_Face(j->second.face);
+				faces.erase(j);
+				unused.pop_back();
+			}
+			return;
+		}
 	}
-	glyph_table.clear();
+};
+
+// Caches are never destroyed, layers may be released
+// by other static destructors at the exit
+GlyphCache& glyph_cache()
+{
+	static GlyphCache *cache = new GlyphCache();
+	return *cache;
 }
 
+FaceCache& face_cache()
+{
+	static FaceCache *cache = new FaceCache();
+	return *cache;
+}
+
+} // END of anonymous namespace
+
 /* === M E T H O D S ======================================================= */
 
 Layer_Freetype::Layer_Freetype()
@@ -133,7 +334,10 @@ Layer_Freetype::Layer_Freetype()
 Layer_Freetype::~Layer_Freetype()
 {
 	if(face)
-		FT_Done_Face(face);
+	{
+		synfig::RecMutex::Lock lock(freetype_mutex);
+		face_cache().release(face, glyph_cache());
+	}
 }
 
 void
@@ -366,12 +570,27 @@ Layer_Freetype::new_face(const String &newfont)
 	if(face && font==newfont)
 		return true;
 
+	synfig::RecMutex::Lock lock(freetype_mutex);
+
 	if(face)
 	{
-		FT_Done_Face(face);
+		face_cache().release(face, glyph_cache());
 		face=0;
 	}
 
+	// relative names are also searched in the directory of canvas
+	String key = newfont;
+	if(get_canvas())
+		key += '\n' + get_canvas()->get_file_path();
+
+	face=face_cache().acquire(key);
+	if(face)
+	{
+		font=newfont;
+		needs_sync_=true;
+		return true;
+	}
+
 	error=FT_New_Face(ft_library,newfont.c_str(),face_index,&face);
 	if(error)error=FT_New_Face(ft_library,(newfont+".ttf").c_str(),face_index,&face);
 
@@ -469,6 +688,7 @@ Layer_Freetype::new_face(const String &newfont)
 		return false;
 	}
 
+	face_cache().add(key, face);
 	font=newfont;
 
 	needs_sync_=true;
@@ -712,8 +932,6 @@ Layer_Freetype::accelerated_render(Context context,Surface *surface,int quality,
 	synfig::Point origin=param_origin.get(Point());
 	synfig::Vector orient=param_orient.get(Vector());
 
-	static synfig::RecMutex freetype_mutex;
-
 	if(needs_sync_)
 		const_cast<Layer_Freetype*>(this)->sync();
 
@@ -762,12 +980,14 @@ Layer_Freetype::accelerated_render(Context context,Surface *surface,int quality,
 	synfig::RecMutex::Lock lock(freetype_mutex);
 
 #define CHAR_RESOLUTION		(64)
+	const int res_x = round_to_int(abs(size[0]*pw*CHAR_RESOLUTION));
+	const int res_y = round_to_int(abs(size[1]*ph*CHAR_RESOLUTION));
 	error = FT_Set_Char_Size(
 		face,						// handle to face object
 		(int)CHAR_RESOLUTION,	// char_width in 1/64th of points
 		(int)CHAR_RESOLUTION,	// char_height in 1/64th of points
-		round_to_int(abs(size[0]*pw*CHAR_RESOLUTION)),						// horizontal device resolution
-		round_to_int(abs(size[1]*ph*CHAR_RESOLUTION)) );						// vertical device resolution
+		res_x,						// horizontal device resolution
+		res_y );						// vertical device resolution
 
 	// Here is where we can compensate for the
 	// error in freetype's rendering engine.
@@ -782,7 +1002,7 @@ Layer_Freetype::accelerated_render(Context context,Surface *surface,int quality,
 		if(cb)cb->warning(string("Layer_Freetype:")+_("Unable to set face size.")+strprintf(" (err=%d)",error));
 	}
 
-	FT_GlyphSlot  slot = face->glyph;  // a small shortcut
+	GlyphCache &glyphs = glyph_cache();
 	FT_UInt       glyph_index(0);
 	FT_UInt       previous(0);
 	int u,v;
@@ -873,32 +1093,28 @@ Layer_Freetype::accelerated_render(Context context,Surface *surface,int quality,
         curr_glyph.pos.x = bx;
         curr_glyph.pos.y = by;
 
-        // load glyph image into the slot. DO NOT RENDER IT !!
-        if(grid_fit)
-			error = FT_Load_Glyph( face, glyph_index, FT_LOAD_DEFAULT);
-		else
-			error = FT_Load_Glyph( face, glyph_index, FT_LOAD_DEFAULT|FT_LOAD_NO_HINTING );
-        if (error) continue;  // ignore errors, jump to next glyph
-
-        // extract glyph image and store it in our table
-        error = FT_Get_Glyph( face->glyph, &curr_glyph.glyph );
-        if (error) continue;  // ignore errors, jump to next glyph
+		// take loaded and rendered glyph from cache
+		const GlyphCache::Entry *cached = glyphs.get(GlyphCache::Key(face, res_x, res_y, glyph_index, grid_fit));
+		if (!cached) continue;  // ignore errors, jump to next glyph
+		curr_glyph.glyph = cached->outline;
+		curr_glyph.bitmap = cached->bitmap;
+		const FT_Vector &advance = cached->advance;
 
         // record current glyph index
         previous = glyph_index;
 
 		// Update the line width
-		lines.front().width=bx+slot->advance.x;
+		lines.front().width=bx+advance.x;
 
 		// increment pen position
 		if(multiplier>1)
-			bx += round_to_int(slot->advance.x*multiplier*compress)-bx%round_to_int(slot->advance.x*multiplier*compress);
+			bx += round_to_int(advance.x*multiplier*compress)-bx%round_to_int(advance.x*multiplier*compress);
 		else
-			bx += round_to_int(slot->advance.x*compress*multiplier);
+			bx += round_to_int(advance.x*compress*multiplier);
 
-		//bx += round_to_int(slot->advance.x*compress*multiplier);
-		//by += round_to_int(slot->advance.y*compress);
-		by += slot->advance.y*multiplier;
+		//bx += round_to_int(advance.x*compress*multiplier);
+		//by += round_to_int(advance.y*compress);
+		by += advance.y*multiplier;
 
 		lines.front().glyph_table.push_back(curr_glyph);
 
@@ -969,20 +1185,15 @@ Layer_Freetype::accelerated_render(Context context,Surface *surface,int quality,
 			std::vector<Glyph>::iterator iter2;
 			for(iter2=iter->glyph_table.begin();iter2!=iter->glyph_table.end();++iter2)
 			{
-				FT_Glyph  image(iter2->glyph);
 				FT_Vector pen;
-				FT_BitmapGlyph  bit;
+				FT_BitmapGlyph  bit(iter2->bitmap);
+				if(!bit) continue;
 
 				pen.x = bx + iter2->pos.x;
 				pen.y = by + iter2->pos.y;
 
 				//synfig::info("GLYPH: line %d, pen.x=%d, pen,y=%d",curr_line,(pen.x+32)>>6,(pen.y+32)>>6);
 
-				error = FT_Glyph_To_Bitmap( &image, ft_render_mode_normal,0/*&pen*/, 1 );
-				if(error) { FT_Done_Glyph( image ); continue; }
-
-				bit = (FT_BitmapGlyph)image;
-
 				for(v=0;v<(int)bit->bitmap.rows;v++)
 					for(u=0;u<(int)bit->bitmap.width;u++)
 					{
@@ -999,13 +1210,11 @@ Layer_Freetype::accelerated_render(Context context,Surface *surface,int quality,
 							(*surface)[y][x]=Color::blend(color,(*src_surface)[y][x],myamount*get_amount(),get_blend_method());
 						}
 					}
-
-				FT_Done_Glyph( image );
 			}
-			//iter->clear_and_free();
 		}
 	}
 
+	glyphs.trim();
 	return true;
 }
 
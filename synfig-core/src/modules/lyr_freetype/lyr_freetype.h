@@ -74,9 +74,11 @@ using namespace std;
 using namespace etl;
 
 
+//! Positioned glyph, outline and bitmap are owned by the glyph cache
 struct Glyph
 {
 	FT_Glyph glyph;
+	FT_BitmapGlyph bitmap;
 	FT_Vector pos;
 	//int width;
 };
@@ -86,7 +88,6 @@ struct TextLine
 	std::vector<Glyph> glyph_table;
 
 	TextLine():width(0) { }
-	void clear_and_free();
 
 	int actual_height()const
 	{
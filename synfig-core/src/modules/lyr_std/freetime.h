@@ -60,6 +60,7 @@ public:
 	virtual ValueBase get_param(const String & param)const;
 	virtual Vocab get_param_vocab()const;
 	virtual void set_time_vfunc(IndependentContext context, Time time)const;
+	virtual bool uses_time()const { return true; }
 };
 
 }; // END of namespace lyr_std
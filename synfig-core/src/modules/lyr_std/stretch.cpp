@@ -267,6 +267,7 @@ Layer_Stretch::build_rendering_task_vfunc(Context context)const
 		  * Matrix().set_scale(amount)
 		  * Matrix().set_translate(center);
 	task_transformation->transformation = affine_transformation;
-	task_transformation->sub_task() = context.build_rendering_task();
+	Context sub_context(context, context.get_params().transformed(affine_transformation->matrix));
+	task_transformation->sub_task() = sub_context.build_rendering_task();
 	return task_transformation;
 }
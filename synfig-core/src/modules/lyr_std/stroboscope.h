@@ -69,6 +69,7 @@ public:
 	virtual Vocab get_param_vocab()const;
 
 	virtual void set_time_vfunc(IndependentContext context, Time time)const;
+	virtual bool uses_time()const { return true; }
 };
 
 }; // END of namespace lyr_std
@@ -82,6 +82,7 @@ public:
 	virtual void reset_version();
 
 	virtual void set_time_vfunc(IndependentContext context, Time time)const;
+	virtual bool uses_time()const { return true; }
 };
 
 }; // END of namespace lyr_std
@@ -33,10 +33,12 @@
 #include "trgt_bmp.h"
 #include <synfig/general.h>
 #include <synfig/localization.h>
+#include <synfig/surface.h>
 
 #include <cstdio>
 #include <algorithm>
 #include <functional>
+#include <vector>
 #endif
 
 /* === U S I N G =========================================================== */
@@ -180,10 +182,7 @@ bmp::start_frame(synfig::ProgressCallback *callback)
 	rowspan=4*((w*(channels(pf)*8)+31)/32);
 	if(multi_image)
 	{
-		String newfilename(filename_sans_extension(filename) +
-						   sequence_separator +
-						   etl::strprintf("%04d",imagecount) +
-						   filename_extension(filename));
+		String newfilename(get_sequence_filename(filename, sequence_separator, imagecount));
 		file=fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE);
 		if(callback)callback->task(newfilename+_(" (animated)"));
 	}
@@ -200,6 +199,48 @@ bmp::start_frame(synfig::ProgressCallback *callback)
 		return false;
 	}
 
+	String error=write_header(file, rowspan);
+	if(!error.empty())
+	{
+		if(callback)callback->error(error);
+		else synfig::error(error);
+		return false;
+	}
+
+	delete [] buffer;
+	buffer=new unsigned char[rowspan];
+
+	delete [] color_buffer;
+	color_buffer=new Color[desc.get_w()];
+
+	return true;
+}
+
+Color *
+bmp::start_scanline(int /*scanline*/)
+{
+	return color_buffer;
+}
+
+bool
+bmp::end_scanline()
+{
+	if(!file)
+		return false;
+
+	convert_color_format(buffer, color_buffer, desc.get_w(), pf, gamma());
+
+	if(!fwrite(buffer,1,rowspan,file))
+		return false;
+
+	return true;
+}
+
+String
+bmp::write_header(FILE *file, int rowspan)const
+{
+	int w=desc.get_w(),h=desc.get_h();
+
 	synfig::BITMAPFILEHEADER fileheader;
 	synfig::BITMAPINFOHEADER infoheader;
 
@@ -217,52 +258,55 @@ bmp::start_frame(synfig::ProgressCallback *callback)
 	infoheader.biBitCount=little_endian_short((short)(channels(pf)*8));
 	infoheader.biCompression=little_endian(0);
 	infoheader.biSizeImage=little_endian(0);
-	infoheader.biXPelsPerMeter=little_endian((int)rend_desc().get_x_res());
-	infoheader.biYPelsPerMeter=little_endian((int)rend_desc().get_y_res()); // pels per meter...?
+	infoheader.biXPelsPerMeter=little_endian((int)desc.get_x_res());
+	infoheader.biYPelsPerMeter=little_endian((int)desc.get_y_res()); // pels per meter...?
 	infoheader.biClrUsed=little_endian(0);
 	infoheader.biClrImportant=little_endian(0);
 
 	fprintf(file,"BM");
 
 	if(!fwrite(&fileheader.bfSize,sizeof(synfig::BITMAPFILEHEADER)-4,1,file))
-	{
-		if(callback)callback->error(_("Unable to write file header to file"));
-		else synfig::error(_("Unable to write file header to file"));
-		return false;
-	}
+		return _("Unable to write file header to file");
 
 	if(!fwrite(&infoheader,sizeof(synfig::BITMAPINFOHEADER),1,file))
-	{
-		if(callback)callback->error(_("Unable to write info header"));
-		else synfig::error(_("Unable to write info header"));
-		return false;
-	}
-
-	delete [] buffer;
-	buffer=new unsigned char[rowspan];
+		return _("Unable to write info header");
 
-	delete [] color_buffer;
-	color_buffer=new Color[desc.get_w()];
-
-	return true;
+	return String();
 }
 
-Color *
-bmp::start_scanline(int /*scanline*/)
+bool
+bmp::can_write_frames_async()const
 {
-	return color_buffer;
+	return multi_image;
 }
 
 bool
-bmp::end_scanline()
+bmp::write_frame(const Surface &surface, int frame)
 {
-	if(!file)
+	int w=desc.get_w(),h=desc.get_h();
+	if(surface.get_w()!=w || surface.get_h()!=h)
 		return false;
 
-	convert_color_format(buffer, color_buffer, desc.get_w(), pf, gamma());
+	String newfilename(get_sequence_filename(filename, sequence_separator, frame));
+	FILE *frame_file=fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE);
+	if(!frame_file)
+		throw String(_("Unable to open file")) + " " + newfilename;
 
-	if(!fwrite(buffer,1,rowspan,file))
-		return false;
+	int frame_rowspan=4*((w*(channels(pf)*8)+31)/32);
+	String error=write_header(frame_file, frame_rowspan);
+	if(!error.empty())
+	{
+		fclose(frame_file);
+		throw error;
+	}
 
-	return true;
+	std::vector<unsigned char> row(frame_rowspan);
+	bool success=true;
+	for(int y = 0; success && y < h; ++y)
+	{
+		convert_color_format(&row.front(), surface[y], w, pf, gamma());
+		success=fwrite(&row.front(),1,frame_rowspan,frame_file)==(size_t)frame_rowspan;
+	}
+
+	return fclose(frame_file)==0 && success;
 }
@@ -52,6 +52,9 @@ private:
 	synfig::PixelFormat pf;
 	synfig::String sequence_separator;
 
+	//! Writes file and info headers, returns error message on failure
+	synfig::String write_header(FILE *file, int rowspan)const;
+
 public:
 	bmp(const char *filename, const synfig::TargetParam& /* params */);
 	virtual ~bmp();
@@ -62,6 +65,9 @@ public:
 	virtual synfig::Color * start_scanline(int scanline);
 	virtual bool end_scanline();
 
+	virtual bool writes_frame_per_file()const { return true; }
+	virtual bool can_write_frames_async()const;
+	virtual bool write_frame(const synfig::Surface &surface, int frame);
 };
 
 /* === E N D =============================================================== */
@@ -123,8 +123,8 @@ FilledRect::set_shape_param(const synfig::String & param, const synfig::ValueBas
 bool
 FilledRect::set_param(const String & param, const ValueBase &value)
 {
-	if (set_shape_param(param, value))
-		{ force_sync(); return true; }
+	if (import_shape_param(param, value))
+		return true;
 
 	IMPORT_VALUE_PLUS(param_feather_x,
 		{
@@ -110,8 +110,8 @@ SimpleCircle::set_shape_param(const synfig::String & param, const synfig::ValueB
 bool
 SimpleCircle::set_param(const String & param, const ValueBase &value)
 {
-	if (set_shape_param(param, value))
-		{ force_sync(); return true; }
+	if (import_shape_param(param, value))
+		return true;
 
 	if ( param == "color" )
 		return Layer_Shape::set_param(param, value);
@@ -35,6 +35,7 @@
 #include <ETL/stringf>
 #include "mptr_ffmpeg.h"
 #include <cstdio>
+#include <cstdlib>
 #include <sys/types.h>
 #include <synfig/general.h>
 #include <synfig/localization.h>
@@ -85,102 +86,127 @@ bool ffmpeg_mptr::is_animated()
 	return true;
 }
 
-bool
-ffmpeg_mptr::seek_to(int frame)
+void
+ffmpeg_mptr::close_decoder()
 {
-	if(frame<cur_frame || !file)
+	if(file)
 	{
-		if(file)
-		{
 #if defined(WIN32_PIPE_TO_PROCESSES)
-			pclose(file);
+		pclose(file);
 #elif defined(UNIX_PIPE_TO_PROCESSES)
-			fclose(file);
-			int status;
-			waitpid(pid,&status,0);
+		fclose(file);
+		int status;
+		waitpid(pid,&status,0);
 #endif
-		}
+	}
+	file=NULL;
+	pid=-1;
+	cur_frame=-1;
+}
+
+bool
+ffmpeg_mptr::open_decoder(int frame)
+{
+	// decoder_mutex should be locked
+	close_decoder();
+
+	{
+		// new process may decode frames which previous one failed to decode
+		Glib::Threads::Mutex::Lock lock(mutex);
+		end_frame = INT_MAX;
+	}
+
+	// seek position in seconds, formatted without locale-dependent decimal separator,
+	// frames before the start of the video are taken from the start
+	int msec = std::max(0, (int)((double)frame*1000.0/fps));
+	string time = strprintf("%d.%03d", msec/1000, msec%1000);
 
 #if defined(WIN32_PIPE_TO_PROCESSES)
 
-		string command;
-		
-		String binary_path = synfig::get_binary_path("");
-		if (binary_path != "")
-			binary_path = etl::dirname(binary_path)+ETL_DIRECTORY_SEPARATOR;
-		binary_path += "ffmpeg.exe";
+	string command;
 
-		command=strprintf("\"%s\" -ss 00:00:00.%d -i \"%s\" -an -f image2pipe -vcodec ppm -\n",binary_path.c_str(),frame,identifier.filename.c_str());
-		
-		// This covers the dumb cmd.exe behavior.
-		// See: http://eli.thegreenplace.net/2011/01/28/on-spaces-in-the-paths-of-programs-and-files-on-windows/
-		command = "\"" + command + "\"";
+	String binary_path = synfig::get_binary_path("");
+	if (binary_path != "")
+		binary_path = etl::dirname(binary_path)+ETL_DIRECTORY_SEPARATOR;
+	binary_path += "ffmpeg.exe";
 
-		file=popen(command.c_str(),POPEN_BINARY_READ_TYPE);
+	command=strprintf("\"%s\" -ss %s -i \"%s\" -an -f image2pipe -vcodec ppm -\n",binary_path.c_str(),time.c_str(),identifier.filename.c_str());
+
+	// This covers the dumb cmd.exe behavior.
+	// See: http://eli.thegreenplace.net/2011/01/28/on-spaces-in-the-paths-of-programs-and-files-on-windows/
+	command = "\"" + command + "\"";
+
+	file=popen(command.c_str(),POPEN_BINARY_READ_TYPE);
 
 #elif defined(UNIX_PIPE_TO_PROCESSES)
 
-		int p[2];
+	int p[2];
 
-		if (pipe(p)) {
-			cerr<<"Unable to open pipe to ffmpeg (no pipe)"<<endl;
-			return false;
-		};
+	if (pipe(p)) {
+		cerr<<"Unable to open pipe to ffmpeg (no pipe)"<<endl;
+		return false;
+	};
 
-		pid = fork();
+	pid = fork();
 
-		if (pid == -1) {
-			cerr<<"Unable to open pipe to ffmpeg (pid == -1)"<<endl;
-			return false;
-		}
+	if (pid == -1) {
+		cerr<<"Unable to open pipe to ffmpeg (pid == -1)"<<endl;
+		return false;
+	}
 
-		if (pid == 0){
-			// Child process
-			// Close pipein, not needed
-			close(p[0]);
-			// Dup pipein to stdout
-			if( dup2( p[1], STDOUT_FILENO ) == -1 ){
-				cerr<<"Unable to open pipe to ffmpeg (dup2( p[1], STDOUT_FILENO ) == -1)"<<endl;
-				return false;
-			}
-			// Close the unneeded pipein
-			close(p[1]);
-			string time = strprintf("00:00:00.%d",frame);
-			execlp("ffmpeg", "ffmpeg", "-ss", time.c_str(), "-i", identifier.filename.c_str(), "-an", "-f", "image2pipe", "-vcodec", "ppm", "-", (const char *)NULL);
-			// We should never reach here unless the exec failed
-			cerr<<"Unable to open pipe to ffmpeg (exec failed)"<<endl;
+	if (pid == 0){
+		// Child process
+		// Close pipein, not needed
+		close(p[0]);
+		// Dup pipein to stdout
+		if( dup2( p[1], STDOUT_FILENO ) == -1 ){
+			cerr<<"Unable to open pipe to ffmpeg (dup2( p[1], STDOUT_FILENO ) == -1)"<<endl;
 			_exit(1);
-		} else {
-			// Parent process
-			// Close pipeout, not needed
-			close(p[1]);
-			// Save pipein to file handle, will read from it later
-			file = fdopen(p[0], "rb");
 		}
+		// Close the unneeded pipein
+		close(p[1]);
+		execlp("ffmpeg", "ffmpeg", "-ss", time.c_str(), "-i", identifier.filename.c_str(), "-an", "-f", "image2pipe", "-vcodec", "ppm", "-", (const char *)NULL);
+		// We should never reach here unless the exec failed
+		cerr<<"Unable to open pipe to ffmpeg (exec failed)"<<endl;
+		_exit(1);
+	} else {
+		// Parent process
+		// Close pipeout, not needed
+		close(p[1]);
+		// Save pipein to file handle, will read from it later
+		file = fdopen(p[0], "rb");
+	}
 
 #else
 	#error There are no known APIs for creating child processes
 #endif
 
-		if(!file)
-		{
-			cerr<<"Unable to open pipe to ffmpeg"<<endl;
-			return false;
-		}
-		cur_frame=-1;
+	if(!file)
+	{
+		cerr<<"Unable to open pipe to ffmpeg"<<endl;
+		return false;
 	}
+	cur_frame=frame-1;
+	return true;
+}
+
+bool
+ffmpeg_mptr::seek_to(int frame)
+{
+	// keep the running decoder when requested frame is a little ahead,
+	// decoding of several frames is cheaper than restart of ffmpeg
+	if(!file || frame<=cur_frame || frame>cur_frame+max_forward_decode)
+		if(!open_decoder(frame))
+			return false;
 
 	while(cur_frame<frame-1)
-	{
-		cerr<<"Seeking to..."<<frame<<'('<<cur_frame<<')'<<endl;
-		if(!grab_frame())
+		if(!grab_frame(NULL))
 			return false;
-	}
 	return true;
 }
 
 bool
-ffmpeg_mptr::grab_frame(void)
+ffmpeg_mptr::grab_frame(Frame *frame)
 {
 	if(!file)
 	{
@@ -204,44 +230,175 @@ ffmpeg_mptr::grab_frame(void)
 	}
 
 	fgetc(file);
-	fscanf(file,"%d %d\n",&w,&h);
+	if (fscanf(file,"%d %d\n",&w,&h) != 2 || w <= 0 || h <= 0)
+		return false;
 	fscanf(file,"%f",&divisor);
 	fgetc(file);
 
 	if(feof(file))
 		return false;
 
-	int x;
-	int y;
-	frame.set_wh(w,h);
-	for(y=0;y<frame.get_h();y++)
-		for(x=0;x<frame.get_w();x++)
+	size_t size = (size_t)w*(size_t)h*3;
+	if (frame)
+	{
+		frame->w = w;
+		frame->h = h;
+		frame->data.resize(size);
+		if (fread(&frame->data.front(), 1, size, file) != size)
+			return false;
+	}
+	else
+	{
+		// skip frame
+		unsigned char buffer[4096];
+		for(size_t s = size; s > 0; )
 		{
-			if(feof(file))
+			size_t chunk = std::min(s, sizeof(buffer));
+			if (fread(buffer, 1, chunk, file) != chunk)
 				return false;
-/*
-			frame[y][x]=Color(
-				(float)(unsigned char)fgetc(file)/divisor,
-				(float)(unsigned char)fgetc(file)/divisor,
-				(float)(unsigned char)fgetc(file)/divisor,
-				1.0
-*/
-			float r=gamma().r_U8_to_F32((unsigned char)fgetc(file));
-			float g=gamma().g_U8_to_F32((unsigned char)fgetc(file));
-			float b=gamma().b_U8_to_F32((unsigned char)fgetc(file));
-			frame[y][x]=Color(
-				r,
-				g,
-				b,
-				1.0
-			);
+			s -= chunk;
 		}
+	}
+
 	cur_frame++;
 	return true;
 }
 
+bool
+ffmpeg_mptr::decode(int index, Frame &frame)
+{
+	// decoder_mutex should be locked
+	if (seek_to(index) && grab_frame(&frame))
+		return true;
+	close_decoder();
+	return false;
+}
+
+void
+ffmpeg_mptr::convert(const Frame &frame, synfig::Surface &surface) const
+{
+	const Gamma &gamma = this->gamma();
+	surface.set_wh(frame.w, frame.h);
+	const unsigned char *src = &frame.data.front();
+	for(int y = 0; y < frame.h; ++y)
+	{
+		Color *dest = surface[y];
+		for(Color *end = dest + frame.w; dest != end; ++dest, src += 3)
+			*dest = Color(
+				gamma.r_U8_to_F32(src[0]),
+				gamma.g_U8_to_F32(src[1]),
+				gamma.b_U8_to_F32(src[2]),
+				1.0 );
+	}
+}
+
+bool
+ffmpeg_mptr::find_frame(int index, synfig::Surface &surface)
+{
+	// mutex should be locked
+	FrameMap::iterator i = frames.find(index);
+	if (i == frames.end())
+		return false;
+	lru.splice(lru.begin(), lru, i->second.lru_position);
+	convert(i->second, surface);
+	return true;
+}
+
+void
+ffmpeg_mptr::put_frame(int index, Frame &frame)
+{
+	// mutex should be locked
+	if (frames.count(index))
+		return;
+
+	frame_size = frame.data.size();
+	// frame which is bigger than the whole cache is not stored (cache may be disabled by zero size)
+	if (frame_size > max_cache_size)
+		return;
+
+	while(!lru.empty() && cache_size + frame_size > max_cache_size)
+	{
+		FrameMap::iterator i = frames.find(lru.back());
+		cache_size -= i->second.data.size();
+		frames.erase(i);
+		lru.pop_back();
+	}
+
+	Frame &f = frames[index];
+	f.w = frame.w;
+	f.h = frame.h;
+	f.data.swap(frame.data);
+	lru.push_front(index);
+	f.lru_position = lru.begin();
+	cache_size += frame_size;
+}
+
+int
+ffmpeg_mptr::get_frame_to_prefetch() const
+{
+	// mutex should be locked
+	if (stop || requested_frame < 0)
+		return -1;
+
+	// don't prefetch more than cache can hold, requested frame should stay in cache
+	int count = prefetch_frames;
+	if (frame_size > 0)
+		count = std::min(count, (int)(max_cache_size/frame_size) - 1);
+
+	for(int i = 1; i <= count; ++i)
+	{
+		int index = requested_frame + i;
+		if (index >= end_frame)
+			break;
+		if (!frames.count(index))
+			return index;
+	}
+	return -1;
+}
+
+void
+ffmpeg_mptr::prefetch()
+{
+	Glib::Threads::Mutex::Lock lock(mutex);
+	while(!stop)
+	{
+		int index = get_frame_to_prefetch();
+		if (index < 0)
+			{ cond.wait(mutex); continue; }
+		lock.release();
+
+		Frame frame;
+		bool decoded = false;
+		bool cached = false;
+		{
+			Glib::Threads::Mutex::Lock decoder_lock(decoder_mutex);
+			{
+				Glib::Threads::Mutex::Lock cache_lock(mutex);
+				cached = frames.count(index) || stop;
+			}
+			if (!cached)
+				decoded = decode(index, frame);
+		}
+
+		lock.acquire();
+		if (decoded)
+			put_frame(index, frame);
+		else
+		if (!cached)
+			end_frame = std::min(end_frame, index); // probably end of file
+	}
+}
+
 ffmpeg_mptr::ffmpeg_mptr(const synfig::FileSystem::Identifier &identifier):
-	synfig::Importer(identifier)
+	synfig::Importer(identifier),
+	cache_size(0),
+	max_cache_size(256*1024*1024),
+	frame_size(0),
+	prefetch_frames(8),
+	requested_frame(-1),
+	end_frame(INT_MAX),
+	stop(false),
+	prefetch_thread(NULL)
 {
 	pid=-1;
 #ifdef HAVE_TERMIOS_H
@@ -250,20 +407,24 @@ ffmpeg_mptr::ffmpeg_mptr(const synfig::FileSystem::Identifier &identifier):
 	file=NULL;
 	fps=23.98;
 	cur_frame=-1;
+
+	if (const char *s = getenv("SYNFIG_FFMPEG_IMPORT_CACHE_MB"))
+		max_cache_size = (size_t)std::max(0, atoi(s))*1024*1024;
+	if (const char *s = getenv("SYNFIG_FFMPEG_IMPORT_PREFETCH"))
+		prefetch_frames = std::max(0, atoi(s));
 }
 
 ffmpeg_mptr::~ffmpeg_mptr()
 {
-	if(file)
 	{
-#if defined(WIN32_PIPE_TO_PROCESSES)
-		pclose(file);
-#elif defined(UNIX_PIPE_TO_PROCESSES)
-		fclose(file);
-		int status;
-		waitpid(pid,&status,0);
-#endif
+		Glib::Threads::Mutex::Lock lock(mutex);
+		stop = true;
+		cond.broadcast();
 	}
+	if (prefetch_thread)
+		prefetch_thread->join();
+
+	close_decoder();
 #ifdef HAVE_TERMIOS_H
 	tcsetattr(0,TCSANOW,&oldtty);
 #endif
@@ -273,14 +434,33 @@ bool
 ffmpeg_mptr::get_frame(synfig::Surface &surface, const synfig::RendDesc &/*renddesc*/, Time time, synfig::ProgressCallback *)
 {
 	int i=(int)(time*fps);
-	if(i!=cur_frame)
+
 	{
-		if(!seek_to(i))
-			return false;
-		if(!grab_frame())
-			return false;
+		Glib::Threads::Mutex::Lock lock(mutex);
+		requested_frame = i;
+		if (!prefetch_thread && prefetch_frames > 0)
+			prefetch_thread = Glib::Threads::Thread::create(
+				sigc::mem_fun(*this, &ffmpeg_mptr::prefetch) );
+		cond.signal();
+		if (find_frame(i, surface))
+			return true;
+	}
+
+	Glib::Threads::Mutex::Lock decoder_lock(decoder_mutex);
+	{
+		// frame may be decoded by prefetch thread while we waited for decoder
+		Glib::Threads::Mutex::Lock lock(mutex);
+		if (find_frame(i, surface))
+			return true;
 	}
 
-	surface=frame;
+	Frame frame;
+	if (!decode(i, frame))
+		return false;
+	convert(frame, surface);
+
+	Glib::Threads::Mutex::Lock lock(mutex);
+	put_frame(i, frame);
+	cond.signal();
 	return true;
 }
@@ -32,6 +32,11 @@
 #include <synfig/importer.h>
 #include <sys/types.h>
 #include <cstdio>
+#include <climits>
+#include <list>
+#include <map>
+#include <vector>
+#include <glibmm/threads.h>
 #include "string.h"
 #ifdef HAVE_TERMIOS_H
 #include <termios.h>
@@ -49,18 +54,57 @@ class ffmpeg_mptr : public synfig::Importer
 {
 	SYNFIG_IMPORTER_MODULE_EXT
 public:
+	//! Maximal count of frames to decode and skip instead of restarting of decoder with seek
+	static const int max_forward_decode = 100;
+
 private:
+	//! Decoded frame in raw 8-bit RGB format, four times smaller than Surface
+	struct Frame
+	{
+		int w, h;
+		std::vector<unsigned char> data;
+		std::list<int>::iterator lru_position;
+		Frame(): w(0), h(0) { }
+	};
+
+	typedef std::map<int, Frame> FrameMap;
+
+	// decoder session, guarded by decoder_mutex
+	Glib::Threads::Mutex decoder_mutex;
 	pid_t pid;
 	FILE *file;
 	int cur_frame;
-	synfig::Surface frame;
 	float fps;
 #ifdef HAVE_TERMIOS_H
 	struct termios oldtty;
 #endif
 
+	// frame cache and prefetch state, guarded by mutex,
+	// lock decoder_mutex first when both mutexes are required
+	Glib::Threads::Mutex mutex;
+	Glib::Threads::Cond cond;
+	FrameMap frames;
+	std::list<int> lru;
+	size_t cache_size;
+	size_t max_cache_size;
+	size_t frame_size;
+	int prefetch_frames;
+	int requested_frame;
+	int end_frame;
+	bool stop;
+	Glib::Threads::Thread *prefetch_thread;
+
+	void close_decoder();
+	bool open_decoder(int frame);
 	bool seek_to(int frame);
-	bool grab_frame(void);
+	bool grab_frame(Frame *frame);
+	bool decode(int index, Frame &frame);
+
+	void convert(const Frame &frame, synfig::Surface &surface) const;
+	bool find_frame(int index, synfig::Surface &surface);
+	void put_frame(int index, Frame &frame);
+	int get_frame_to_prefetch() const;
+	void prefetch();
 
 public:
 	ffmpeg_mptr(const synfig::FileSystem::Identifier &identifier);
@@ -35,6 +35,7 @@
 
 #include <synfig/localization.h>
 #include <synfig/general.h>
+#include <synfig/color/pixelformat.h>
 
 #include <ETL/stringf>
 #include "trgt_ffmpeg.h"
@@ -79,6 +80,9 @@ SYNFIG_TARGET_SET_EXT(ffmpeg_trgt,"mpg");
 SYNFIG_TARGET_SET_VERSION(ffmpeg_trgt,"0.1");
 SYNFIG_TARGET_SET_CVS_ID(ffmpeg_trgt,"$Id$");
 
+//! Frames rendered ahead of the encoder, including the frame which is being written
+static const size_t max_queued_frames = 3;
+
 /* === M E T H O D S ======================================================= */
 
 ffmpeg_trgt::ffmpeg_trgt(const char *Filename, const synfig::TargetParam &params):
@@ -87,12 +91,45 @@ ffmpeg_trgt::ffmpeg_trgt(const char *Filename, const synfig::TargetParam &params
 	multi_image(false),
 	file(NULL),
 	filename(Filename),
-	buffer(NULL),
 	color_buffer(NULL),
-	bitrate()
+	bitrate(),
+	pixel_format(PF_RGB),
+	bit_depth(8),
+	frame(NULL),
+	frame_offset(0),
+	stop(false),
+	write_failed(false),
+	writer_thread(NULL)
 {
 	set_alpha_mode(TARGET_ALPHA_MODE_FILL);
 
+	// raw 16-bit samples are written in native byte order
+	const unsigned short one = 1;
+	const char *endian = *(const unsigned char*)&one ? "le" : "be";
+
+	const String &format = params.pixel_format;
+	if (format == "rgb24" || format == "rgba")
+	{
+		raw_format = format;
+	}
+	else
+	if (format == "rgb48" || format == "rgba64")
+	{
+		raw_format = format + endian;
+		bit_depth = 16;
+	}
+	else
+	if (!format.empty())
+	{
+		synfig::warning("ffmpeg_trgt: unknown pixel format '%s', send PPM images", format.c_str());
+	}
+
+	if (format == "rgba" || format == "rgba64")
+		pixel_format = PF_RGB|PF_A;
+
+	if (FLAGS(pixel_format, PF_A))
+		set_alpha_mode(TARGET_ALPHA_MODE_KEEP);
+
 	// Set default video codec and bitrate if they weren't given.
 	if (params.video_codec == "none")
 		video_codec = "mpeg1video";
@@ -107,6 +144,8 @@ ffmpeg_trgt::ffmpeg_trgt(const char *Filename, const synfig::TargetParam &params
 
 ffmpeg_trgt::~ffmpeg_trgt()
 {
+	stop_writer();
+
 	if(file)
 	{
 		etl::yield();
@@ -120,8 +159,63 @@ ffmpeg_trgt::~ffmpeg_trgt()
 #endif
 	}
 	file=NULL;
-	delete [] buffer;
 	delete [] color_buffer;
+
+	delete frame;
+	for(std::deque<Frame*>::iterator i = queue.begin(); i != queue.end(); ++i)
+		delete *i;
+	for(std::vector<Frame*>::iterator i = free_frames.begin(); i != free_frames.end(); ++i)
+		delete *i;
+}
+
+int
+ffmpeg_trgt::get_row_size()const
+{
+	return desc.get_w()*channels(pixel_format)*(bit_depth/8);
+}
+
+void
+ffmpeg_trgt::write_frames()
+{
+	Glib::Threads::Mutex::Lock lock(mutex);
+	while(true)
+	{
+		while(queue.empty() && !stop)
+			cond.wait(mutex);
+		if (queue.empty())
+			break;
+
+		// frame stays in queue while it's written, so queue limit includes it
+		Frame *f = queue.front();
+		bool failed = write_failed;
+		lock.release();
+		if (!failed)
+			failed = fwrite(&f->front(), 1, f->size(), file) != f->size() || fflush(file) != 0;
+		lock.acquire();
+
+		queue.pop_front();
+		free_frames.push_back(f);
+		if (failed && !write_failed)
+		{
+			synfig::error(_("Unable to write frame to ffmpeg"));
+			write_failed = true;
+		}
+		cond.broadcast();
+	}
+}
+
+void
+ffmpeg_trgt::stop_writer()
+{
+	if (!writer_thread)
+		return;
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		stop = true;
+		cond.broadcast();
+	}
+	writer_thread->join();
+	writer_thread = NULL;
 }
 
 bool
@@ -226,10 +320,23 @@ ffmpeg_trgt::init(ProgressCallback *cb=NULL)
 	
 	std::vector<String> vargs;
 	vargs.push_back(ffmpeg_binary_path);
-	vargs.push_back("-f");
-	vargs.push_back("image2pipe");
-	vargs.push_back("-vcodec");
-	vargs.push_back("ppm");
+	if (raw_format.empty())
+	{
+		vargs.push_back("-f");
+		vargs.push_back("image2pipe");
+		vargs.push_back("-vcodec");
+		vargs.push_back("ppm");
+	}
+	else
+	{
+		// raw frames need no parsing, but ffmpeg should know their layout
+		vargs.push_back("-f");
+		vargs.push_back("rawvideo");
+		vargs.push_back("-pix_fmt");
+		vargs.push_back(raw_format);
+		vargs.push_back("-s");
+		vargs.push_back(strprintf("%dx%d", desc.get_w(), desc.get_h()));
+	}
 	vargs.push_back("-r");
 	vargs.push_back(strprintf("%f", desc.get_frame_rate()));
 	vargs.push_back("-i");
@@ -284,6 +391,11 @@ ffmpeg_trgt::init(ProgressCallback *cb=NULL)
 		return false;
 	};
 
+#ifdef F_SETPIPE_SZ
+	// bigger pipe lets ffmpeg read previous frame while next one is being written
+	fcntl(p[1], F_SETPIPE_SZ, 1024*1024);
+#endif
+
 	pid = fork();
 
 	if (pid == -1) {
@@ -341,14 +453,32 @@ ffmpeg_trgt::init(ProgressCallback *cb=NULL)
 		return false;
 	}
 
+	// frames are written by separate thread, so ffmpeg encodes
+	// previous frames while the next one is being rendered
+	writer_thread = Glib::Threads::Thread::create(
+		sigc::mem_fun(*this, &ffmpeg_trgt::write_frames) );
+
 	return true;
 }
 
 void
 ffmpeg_trgt::end_frame()
 {
-	//fprintf(file, " ");
-	fflush(file);
+	if (frame)
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		queue.push_back(frame);
+		frame = NULL;
+		cond.broadcast();
+
+		// wait until the last frame is written, so failure
+		// is reported by render() instead of the destructor
+		if (imagecount >= desc.get_frame_end())
+			while(!queue.empty() && !write_failed)
+				cond.wait(mutex);
+		if (write_failed)
+			throw String(_("Unable to write frame to ffmpeg"));
+	}
 	imagecount++;
 }
 
@@ -357,15 +487,34 @@ ffmpeg_trgt::start_frame(synfig::ProgressCallback */*callback*/)
 {
 	int w=desc.get_w(),h=desc.get_h();
 
-	if(!file)
+	if(!file || !writer_thread)
 		return false;
 
-	fprintf(file, "P6\n");
-	fprintf(file, "%d %d\n", w, h);
-	fprintf(file, "%d\n", 255);
+	if (!frame)
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		while(queue.size() >= max_queued_frames && !write_failed)
+			cond.wait(mutex);
+		if (write_failed)
+			return false;
+		if (free_frames.empty())
+		{
+			frame = new Frame();
+		}
+		else
+		{
+			frame = free_frames.back();
+			free_frames.pop_back();
+		}
+	}
+
+	String header;
+	if (raw_format.empty())
+		header = strprintf("P6\n%d %d\n%d\n", w, h, 255);
+	frame->resize(header.size() + (size_t)get_row_size()*h);
+	copy(header.begin(), header.end(), frame->begin());
+	frame_offset = header.size();
 
-	delete [] buffer;
-	buffer=new unsigned char[3*w];
 	delete [] color_buffer;
 	color_buffer=new Color[w];
 
@@ -381,13 +530,19 @@ ffmpeg_trgt::start_scanline(int /*scanline*/)
 bool
 ffmpeg_trgt::end_scanline()
 {
-	if(!file)
+	if(!file || !frame)
 		return false;
 
-	convert_color_format(buffer, color_buffer, desc.get_w(), PF_RGB, gamma());
-
-	if(!fwrite(buffer,1,desc.get_w()*3,file))
+	size_t row_size = get_row_size();
+	if (frame_offset + row_size > frame->size())
 		return false;
 
+	unsigned char *row = &(*frame)[frame_offset];
+	if (bit_depth == 16)
+		convert_color_format_u16((unsigned short*)row, color_buffer, desc.get_w(), pixel_format, gamma());
+	else
+		convert_color_format(row, color_buffer, desc.get_w(), pixel_format, gamma());
+	frame_offset += row_size;
+
 	return true;
 }
@@ -35,6 +35,9 @@
 #include <synfig/targetparam.h>
 #include <sys/types.h>
 #include <cstdio>
+#include <deque>
+#include <vector>
+#include <glibmm/threads.h>
 
 /* === M A C R O S ========================================================= */
 
@@ -53,10 +56,35 @@ private:
 	bool multi_image;
 	FILE *file;
 	synfig::String filename;
-	unsigned char *buffer;
 	synfig::Color *color_buffer;
 	std::string video_codec;
 	int bitrate;
+
+	//! Format of rawvideo passed to ffmpeg, frames are sent as PPM images when empty
+	synfig::String raw_format;
+	synfig::PixelFormat pixel_format;
+	int bit_depth;
+
+	//! Whole frame which is ready to be sent into the pipe: PPM image or raw video frame
+	typedef std::vector<unsigned char> Frame;
+
+	//! Frame which is being rendered now
+	Frame *frame;
+	size_t frame_offset;
+
+	// frames queue of writer thread, guarded by mutex
+	Glib::Threads::Mutex mutex;
+	Glib::Threads::Cond cond;
+	//! front frame is being written into the pipe
+	std::deque<Frame*> queue;
+	std::vector<Frame*> free_frames;
+	bool stop;
+	bool write_failed;
+	Glib::Threads::Thread *writer_thread;
+
+	int get_row_size()const;
+	void write_frames();
+	void stop_writer();
 public:
 	ffmpeg_trgt(const char *filename,
 				const synfig::TargetParam& params);
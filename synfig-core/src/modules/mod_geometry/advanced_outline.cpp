@@ -57,7 +57,7 @@ using namespace etl;
 
 
 /* === M A C R O S ========================================================= */
-#define SAMPLES		50
+#define MAX_SAMPLES		1000
 #define ROUND_END_FACTOR	(4)
 #define CUSP_THRESHOLD		(0.40)
 #define SPIKE_AMOUNT		(4)
@@ -369,7 +369,31 @@ Advanced_Outline::sync_vfunc()
 		// TODO: step should be a function of the current situation
 		// i.e.: where in the bline, and where in wplist so we could go
 		// faster or slower when needed.
-		Real step(1.0/SAMPLES/bline_size);
+		// For now the step is chosen by the most curved bezier, so
+		// the polygon is smooth enough for the resolution of canvas.
+		Real step;
+		{
+			Real max_width(0.0);
+			for(witer=wplist.begin(); witer!=wplist.end(); witer++)
+				max_width=max(max_width, fabs(witer->get_width()));
+			max_width=fabs(gv*(expand_+width_*0.5*max_width));
+
+			const Real tolerance(get_flatness_tolerance());
+			int samples(1);
+			for(vector<BLinePoint>::const_iterator i=bline.begin(); i!=bend; i++)
+			{
+				vector<BLinePoint>::const_iterator n(i+1);
+				if(n==bend)
+				{
+					if(!blineloop) break;
+					n=bline.begin();
+				}
+				hermite<Vector> curve(i->get_vertex(), n->get_vertex(), i->get_tangent2(), n->get_tangent1());
+				samples=max(samples, rendering::Contour::cubic_segments(
+					curve[0], curve[3], curve[1], curve[2], max_width, tolerance, MAX_SAMPLES ));
+			}
+			step=1.0/samples/bline_size;
+		}
 		//////////////////// prepare the widhtpoints from the dash list
 		if(dash_enabled)
 		{
@@ -1298,6 +1322,14 @@ Advanced_Outline::bezier_to_bline(Real bezier_pos, Real origin, Real bezier_size
 	return origin+bezier_pos*bezier_size;
 }
 
+int
+Advanced_Outline::tip_samples(const hermite<Vector> &curve) const
+{
+	// count of samples for each half of round tip
+	return (rendering::Contour::cubic_segments(
+		curve[0], curve[3], curve[1], curve[2], 0.0, get_flatness_tolerance(), MAX_SAMPLES ) + 1)/2;
+}
+
 void
 Advanced_Outline::add_tip(std::vector<Point> &side_a, std::vector<Point> &side_b, const Point vertex, const Vector tangent, const WidthPoint wp, const Real gv)
 {
@@ -1318,8 +1350,10 @@ Advanced_Outline::add_tip(std::vector<Point> &side_a, std::vector<Point> &side_b
 			);
 			side_a.push_back(vertex);
 			side_b.push_back(vertex);
-			for(float n=0.0f;n<0.499999f;n+=2.0f/SAMPLES)
+			const int samples(tip_samples(curve));
+			for(int i=0;i<samples;i++)
 			{
+				const float n(0.5f*i/samples);
 				side_a.push_back(curve(0.5+n));
 				side_b.push_back(curve(0.5-n));
 			}
@@ -1370,8 +1404,10 @@ Advanced_Outline::add_tip(std::vector<Point> &side_a, std::vector<Point> &side_b
 				tangent*w*ROUND_END_FACTOR,
 				-tangent*w*ROUND_END_FACTOR
 			);
-			for(float n=0.0f;n<0.499999f;n+=2.0f/SAMPLES)
+			const int samples(tip_samples(curve));
+			for(int i=0;i<samples;i++)
 			{
+				const float n(0.5f*i/samples);
 				side_a.push_back(curve(1-n));
 				side_b.push_back(curve(n));
 			}
@@ -1477,8 +1513,10 @@ Advanced_Outline::add_cusp(std::vector<Point> &side_a, std::vector<Point> &side_
 					Point(-tangent*w*Angle::sin(angle*0+offset).get(),tangent*w*Angle::cos(angle*0+offset).get()),
 					Point(-tangent*w*Angle::sin(angle*1+offset).get(),tangent*w*Angle::cos(angle*1+offset).get())
 				);
-				for(float n=0.0f;n<0.999999f;n+=4.0f/SAMPLES)
-					side_a.push_back(curve(n));
+				const int samples(rendering::Contour::cubic_segments(
+					curve[0], curve[3], curve[1], curve[2], 0.0, get_flatness_tolerance(), MAX_SAMPLES ));
+				for(int i=0;i<samples;i++)
+					side_a.push_back(curve((float)i/samples));
 			}
 			if(cross < 0)
 			{
@@ -1498,8 +1536,10 @@ Advanced_Outline::add_cusp(std::vector<Point> &side_a, std::vector<Point> &side_
 					Point(-tangent*w*Angle::sin(angle*1+offset).get(),tangent*w*Angle::cos(angle*1+offset).get()),
 					Point(-tangent*w*Angle::sin(angle*0+offset).get(),tangent*w*Angle::cos(angle*0+offset).get())
 				);
-				for(float n=0.0f;n<0.999999f;n+=4.0f/SAMPLES)
-					side_b.push_back(curve(n));
+				const int samples(rendering::Contour::cubic_segments(
+					curve[0], curve[3], curve[1], curve[2], 0.0, get_flatness_tolerance(), MAX_SAMPLES ));
+				for(int i=0;i<samples;i++)
+					side_b.push_back(curve((float)i/samples));
 			}
 			break;
 		}
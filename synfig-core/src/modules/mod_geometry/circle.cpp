@@ -96,8 +96,8 @@ Circle::set_shape_param(const synfig::String & param, const synfig::ValueBase &v
 bool
 Circle::set_param(const String &param, const ValueBase &value)
 {
-	if (set_shape_param(param, value))
-		{ force_sync(); return true; }
+	if (import_shape_param(param, value))
+		return true;
 
 	if ( param == "color"
 	  || param == "invert"
@@ -61,6 +61,7 @@ using namespace etl;
 /* === M A C R O S ========================================================= */
 
 #define SAMPLES		50
+#define MAX_SAMPLES		1000
 #define ROUND_END_FACTOR	(4)
 #define CUSP_THRESHOLD		(0.40)
 #define SPIKE_AMOUNT		(4)
@@ -236,6 +237,8 @@ Outline::sync_vfunc()
 	Vector last_tangent=iter->get_tangent1();
 	// Retrieve the parent canvas grow value
 	Real gv(exp(get_outline_grow_mark()));
+	// Max distance between curves and polygon
+	const Real tolerance(get_flatness_tolerance());
 	// if we are looped and drawing sharp cusps, we'll need a value for the incoming tangent
 	if (loop && sharp_cusps && last_tangent.is_equal_to(Vector::zero()))
 	{
@@ -321,13 +324,17 @@ Outline::sync_vfunc()
 		}
 
 		// Make the outline
+		const int samples(rendering::Contour::cubic_segments(
+			curve[0], curve[3], curve[1], curve[2],
+			std::max(fabs(iter_w), fabs(next_w)), tolerance, MAX_SAMPLES ));
 		if(homogeneous_width)
 		{
 			const float length(curve.length());
 			float dist(0);
 			Point lastpoint;
-			for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
+			for(int i=0;i<samples;i++)
 			{
+				const float n((float)i/samples);
 				const Vector d(deriv(n>CUSP_TANGENT_ADJUST?n:CUSP_TANGENT_ADJUST).perp().norm());
 				const Vector p(curve(n));
 
@@ -343,8 +350,9 @@ Outline::sync_vfunc()
 			}
 		}
 		else
-			for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
+			for(int i=0;i<samples;i++)
 			{
+				const float n((float)i/samples);
 				const Vector d(deriv(n>CUSP_TANGENT_ADJUST?n:CUSP_TANGENT_ADJUST).perp().norm());
 				const Vector p(curve(n));
 				const float w(((next_w-iter_w)*n+iter_w));
@@ -384,8 +392,10 @@ Outline::sync_vfunc()
 			-tangent*w*ROUND_END_FACTOR
 		);
 
-		for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
-			side_a.push_back(curve(n));
+		const int samples(rendering::Contour::cubic_segments(
+			curve[0], curve[3], curve[1], curve[2], 0.0, tolerance, MAX_SAMPLES ));
+		for(int i=0;i<samples;i++)
+			side_a.push_back(curve((float)i/samples));
 	}
 
 	for(;!side_b.empty();side_b.pop_back())
@@ -408,8 +418,10 @@ Outline::sync_vfunc()
 			tangent*w*ROUND_END_FACTOR
 		);
 
-		for(float n=0.0f;n<0.999999f;n+=1.0f/SAMPLES)
-			side_a.push_back(curve(n));
+		const int samples(rendering::Contour::cubic_segments(
+			curve[0], curve[3], curve[1], curve[2], 0.0, tolerance, MAX_SAMPLES ));
+		for(int i=0;i<samples;i++)
+			side_a.push_back(curve((float)i/samples));
 	}
 
 	set_stored_polygon(side_a);
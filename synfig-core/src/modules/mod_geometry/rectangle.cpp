@@ -102,8 +102,8 @@ Rectangle::set_shape_param(const synfig::String & param, const synfig::ValueBase
 bool
 Rectangle::set_param(const String & param, const ValueBase &value)
 {
-	if (set_shape_param(param, value))
-		{ force_sync(); return true; }
+	if (import_shape_param(param, value))
+		return true;
 
 	if ( param == "color"
 	  || param == "invert" )
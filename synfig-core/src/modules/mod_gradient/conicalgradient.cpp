@@ -64,6 +64,33 @@ SYNFIG_LAYER_SET_CVS_ID(ConicalGradient,"$Id$");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+class ConicalShape: public rendering::TaskGradient::Shape
+{
+public:
+	Point center;
+	Angle angle;
+
+	ConicalShape() { loop=true; }
+
+	virtual Real get_position(const Point &point, Real &supersample) const
+	{
+		const Point centered(point-center);
+		const Real dist(centered.mag());
+		if(fabs(centered[0])<fabs(supersample*0.5) && fabs(centered[1])<fabs(supersample*0.5))
+			supersample=0.5;
+		else if(dist>0.0)
+			supersample=supersample/dist/(PI*2);
+
+		Angle::rot a=Angle::tan(-centered[1],centered[0]).mod();
+		a+=angle;
+		return a.mod().get();
+	}
+};
+
+}
+
 /* === M E T H O D S ======================================================= */
 
 /* === E N T R Y P O I N T ================================================= */
@@ -132,84 +159,14 @@ ConicalGradient::get_param_vocab()const
 	return ret;
 }
 
-inline Color
-ConicalGradient::color_func(const Point &pos, float supersample)const
-{
-	Gradient gradient=param_gradient.get(Gradient());
-	Point center=param_center.get(Point());
-	Angle angle=param_angle.get(Angle());
-	bool symmetric=param_symmetric.get(bool());
-	
-	const Point centered(pos-center);
-	Angle::rot a=Angle::tan(-centered[1],centered[0]).mod();
-	a+=angle;
-	Real dist(a.mod().get());
-
-	dist-=floor(dist);
-
-	if(symmetric)
-	{
-		dist*=2.0;
-		supersample*=2.0;
-		if(dist>1)dist=2.0-dist;
-	}
-/*	if(dist+supersample*0.5>1.0)
-	{
-		Color pool(gradient(dist,supersample*0.5)*(1.0-(dist-supersample*0.5)));
-		pool+=gradient((dist+supersample*0.5)-1.0,supersample*0.5)*((dist+supersample*0.5)-1.0);
-		if(pool.get_a() && pool.is_valid())
-		{
-			pool.set_r(pool.get_r()/pool.get_a());
-			pool.set_g(pool.get_g()/pool.get_a());
-			pool.set_b(pool.get_b()/pool.get_a());
-			pool.set_a(pool.get_a()/supersample);
-		}
-		return pool;
-	}
-
-	if(dist-supersample*0.5<0.0)
-	{
-		Color pool(gradient(dist,supersample*0.5)*(dist+supersample*0.5));
-		pool+=gradient(1.0-(dist-supersample*0.5),supersample*0.5)*(-(dist-supersample*0.5));
-		if(pool.get_a() && pool.is_valid())
-		{
-			pool.set_r(pool.get_r()/pool.get_a());
-			pool.set_g(pool.get_g()/pool.get_a());
-			pool.set_b(pool.get_b()/pool.get_a());
-			pool.set_a(pool.get_a()/supersample);
-			return pool;
-		}
-	}
-*/
-	if(dist+supersample*0.5>1.0)
-	{
-		float  left(supersample*0.5-(dist-1.0));
-		float right(supersample*0.5+(dist-1.0));
-		Color pool(gradient(1.0-(left*0.5),left).premult_alpha()*left/supersample);
-		pool+=gradient(right*0.5,right).premult_alpha()*right/supersample;
-		return pool.demult_alpha();
-	}
-	if(dist-supersample*0.5<0.0)
-	{
-		float  left(supersample*0.5-dist);
-		float right(supersample*0.5+dist);
-		Color pool(gradient(right*0.5,right).premult_alpha()*right/supersample);
-		pool+=gradient(1.0-left*0.5,left).premult_alpha()*left/supersample;
-		return pool.demult_alpha();
-	}
-
-	return gradient(dist,supersample);
-}
-
-float
-ConicalGradient::calc_supersample(const synfig::Point &x, float pw,float ph)const
+rendering::TaskGradient::Shape::Handle
+ConicalGradient::create_shape()const
 {
-	Point center=param_center.get(Point());
-
-	Point adj(x-center);
-	if(abs(adj[0])<abs(pw*0.5) && abs(adj[1])<abs(ph*0.5))
-		return 0.5;
-	return (pw/Point(x-center).mag())/(PI*2);
+	etl::handle<ConicalShape> shape(new ConicalShape());
+	shape->center=param_center.get(Point());
+	shape->angle=param_angle.get(Angle());
+	shape->zigzag=param_symmetric.get(bool());
+	return shape;
 }
 
 synfig::Layer::Handle
@@ -219,7 +176,7 @@ ConicalGradient::hit_check(synfig::Context context, const synfig::Point &point)c
 		return const_cast<ConicalGradient*>(this);
 	if(get_amount()==0.0)
 		return context.hit_check(point);
-	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE) && color_func(point).get_a()>0.5)
+	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE) && create_shape()->get_color(compiled_gradient.get(param_gradient.get(Gradient())),point,0).get_a()>0.5)
 		return const_cast<ConicalGradient*>(this);
 	return context.hit_check(point);
 }
@@ -227,7 +184,7 @@ ConicalGradient::hit_check(synfig::Context context, const synfig::Point &point)c
 Color
 ConicalGradient::get_color(Context context, const Point &pos)const
 {
-	const Color color(color_func(pos));
+	const Color color(create_shape()->get_color(compiled_gradient.get(param_gradient.get(Gradient())),pos,0));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 		return color;
@@ -263,6 +220,9 @@ ConicalGradient::accelerated_render(Context context,Surface *surface,int quality
 	Point tl(renddesc.get_tl());
 	const int w(surface->get_w());
 	const int h(surface->get_h());
+	const rendering::TaskGradient::Shape::Handle shape(create_shape());
+	const Real min_supersample=quality>=9 ? 0.0 : shape->get_min_supersample(Rect(tl,renddesc.get_br()),pw);
+	const CompiledGradient gradient(compiled_gradient.get(param_gradient.get(Gradient()), min_supersample));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 	{
@@ -270,13 +230,13 @@ ConicalGradient::accelerated_render(Context context,Surface *surface,int quality
 		{
 			for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 				for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-					pen.put_value(color_func(pos,calc_supersample(pos,pw,ph)));
+					pen.put_value(shape->get_color(gradient,pos,pw));
 		}
 		else
 		{
 			for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 				for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-					pen.put_value(color_func(pos,0));
+					pen.put_value(shape->get_color(gradient,pos,0));
 		}
 	}
 	else
@@ -285,13 +245,13 @@ ConicalGradient::accelerated_render(Context context,Surface *surface,int quality
 		{
 			for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 				for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-					pen.put_value(Color::blend(color_func(pos,calc_supersample(pos,pw,ph)),pen.get_value(),get_amount(),get_blend_method()));
+					pen.put_value(Color::blend(shape->get_color(gradient,pos,pw),pen.get_value(),get_amount(),get_blend_method()));
 		}
 		else
 		{
 			for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 				for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-					pen.put_value(Color::blend(color_func(pos,0),pen.get_value(),get_amount(),get_blend_method()));
+					pen.put_value(Color::blend(shape->get_color(gradient,pos,0),pen.get_value(),get_amount(),get_blend_method()));
 		}
 	}
 
@@ -303,6 +263,16 @@ ConicalGradient::accelerated_render(Context context,Surface *surface,int quality
 }
 
 /////////
+rendering::Task::Handle
+ConicalGradient::build_composite_task_vfunc(ContextParams context_params)const
+{
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->shape=create_shape();
+	const Rect rect(get_canvas() ? get_canvas()->rend_desc().get_rect() : Rect::zero());
+	task->gradient=compiled_gradient.get(param_gradient.get(Gradient()), task->shape->get_min_supersample(rect, context_params.pixel_size));
+	return task;
+}
+
 bool
 ConicalGradient::accelerated_cairorender(Context context,cairo_t *cr,int quality, const RendDesc &renddesc, ProgressCallback *cb)const
 {
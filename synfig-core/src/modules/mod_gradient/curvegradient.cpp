@@ -200,292 +200,288 @@ find_closest(bool fast, const std::vector<synfig::BLinePoint>& bline,const Point
 	return ret;
 }
 
-/* === M E T H O D S ======================================================= */
+namespace {
 
-inline void
-CurveGradient::sync()
-{
-	std::vector<synfig::BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
-	curve_length_=calculate_distance(bline, bline_loop);
-}
-
-
-CurveGradient::CurveGradient():
-	Layer_Composite(1.0,Color::BLEND_COMPOSITE),
-	param_origin(ValueBase(Point(0,0))),
-	param_width(ValueBase(Real(0.25))),
-	param_bline(ValueBase(std::vector<synfig::BLinePoint>())),
-	param_gradient(Gradient(Color::black(), Color::white())),
-	param_loop(ValueBase(false)),
-	param_zigzag(ValueBase(false)),
-	param_perpendicular(ValueBase(false)),
-	param_fast(ValueBase(true))
+class CurveShape: public rendering::TaskGradient::Shape
 {
+public:
+	Point origin;
+	Real width;
 	std::vector<synfig::BLinePoint> bline;
-	bline.push_back(BLinePoint());
-	bline.push_back(BLinePoint());
-	bline.push_back(BLinePoint());
-	bline[0].set_vertex(Point(0,1));
-	bline[1].set_vertex(Point(0,-1));
-	bline[2].set_vertex(Point(1,0));
-	bline[0].set_tangent(bline[1].get_vertex()-bline[2].get_vertex()*0.5f);
-	bline[1].set_tangent(bline[2].get_vertex()-bline[0].get_vertex()*0.5f);
-	bline[2].set_tangent(bline[0].get_vertex()-bline[1].get_vertex()*0.5f);
-	bline[0].set_width(1.0f);
-	bline[1].set_width(1.0f);
-	bline[2].set_width(1.0f);
-	bline_loop=true;
-	param_bline.set_list_of(bline);
+	bool bline_loop;
+	Real curve_length;
+	bool perpendicular;
+	bool fast;
+	int quality;
 
-	sync();
-
-	SET_INTERPOLATION_DEFAULTS();
-	SET_STATIC_DEFAULTS();
-}
+	CurveShape():
+		width(), bline_loop(), curve_length(), perpendicular(), fast(), quality(10) { }
 
-inline Color
-CurveGradient::color_func(const Point &point_, int quality, float supersample)const
-{
-	Point origin=param_origin.get(Point());
-	Real width=param_width.get(Real());
-	std::vector<synfig::BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
-	Gradient gradient=param_gradient.get(Gradient());
-	bool loop=param_loop.get(bool());
-	bool zigzag=param_zigzag.get(bool());
-	bool perpendicular=param_perpendicular.get(bool());
-	bool fast=param_fast.get(bool());
-
-	Vector tangent;
-	Vector diff;
-	Point p1;
-	Real thickness;
-	Real dist;
-
-	float perp_dist;
-	bool edge_case = false;
-
-	if(bline.size()==0)
-		return Color::alpha();
-	else if(bline.size()==1)
+	virtual Real get_position(const Point &point_, Real &supersample) const
 	{
-		tangent=bline.front().get_tangent1();
-		p1=bline.front().get_vertex();
-		thickness=bline.front().get_width();
-	}
-	else
-	{
-		float t;
-		Point point(point_-origin);
+		Vector tangent;
+		Vector diff;
+		Point p1;
+		Real thickness;
+		Real dist;
 
-		std::vector<synfig::BLinePoint>::const_iterator iter,next;
+		float perp_dist;
+		bool edge_case = false;
 
-		// Figure out the BLinePoints we will be using,
-		// Taking into account looping.
-		if(perpendicular)
+		if(bline.size()==1)
 		{
-			next=find_closest(fast,bline,point,t,bline_loop,&perp_dist);
-			perp_dist/=curve_length_;
+			tangent=bline.front().get_tangent1();
+			p1=bline.front().get_vertex();
+			thickness=bline.front().get_width();
 		}
-		else					// not perpendicular
+		else
 		{
-			next=find_closest(fast,bline,point,t,bline_loop);
-		}
+			float t;
+			Point point(point_-origin);
 
-		iter=next++;
-		if(next==bline.end()) next=bline.begin();
+			std::vector<synfig::BLinePoint>::const_iterator iter,next;
 
-		// Setup the curve
-		etl::hermite<Vector> curve(
-			iter->get_vertex(),
-			next->get_vertex(),
-			iter->get_tangent2(),
-			next->get_tangent1()
-			);
+			// Figure out the BLinePoints we will be using,
+			// Taking into account looping.
+			if(perpendicular)
+			{
+				next=find_closest(fast,bline,point,t,bline_loop,&perp_dist);
+				perp_dist/=curve_length;
+			}
+			else					// not perpendicular
+			{
+				next=find_closest(fast,bline,point,t,bline_loop);
+			}
 
-		// Setup the derivative function
-		etl::derivative<etl::hermite<Vector> > deriv(curve);
+			iter=next++;
+			if(next==bline.end()) next=bline.begin();
 
-		int search_iterations(7);
+			// Setup the curve
+			etl::hermite<Vector> curve(
+				iter->get_vertex(),
+				next->get_vertex(),
+				iter->get_tangent2(),
+				next->get_tangent1()
+				);
 
-		/*if(quality==0)search_iterations=8;
-		  else if(quality<=2)search_iterations=10;
-		  else if(quality<=4)search_iterations=8;
-		*/
-		if(perpendicular)
-		{
-			if(quality>7)
-				search_iterations=4;
-		}
-		else					// not perpendicular
-		{
-			if(quality<=6)search_iterations=7;
-			else if(quality<=7)search_iterations=6;
-			else if(quality<=8)search_iterations=5;
-			else search_iterations=4;
-		}
+			// Setup the derivative function
+			etl::derivative<etl::hermite<Vector> > deriv(curve);
 
-		// Figure out the closest point on the curve
-		if (fast)
-			t = curve.find_closest(fast, point,search_iterations);
-
-		// Calculate our values
-		p1=curve(t);			 // the closest point on the curve
-		tangent=deriv(t);		 // the tangent at that point
-
-		// if the point we're nearest to is at either end of the
-		// bline, our distance from the curve is the distance from the
-		// point on the curve.  we need to know which side of the
-		// curve we're on, so find the average of the two tangents at
-		// this point
-		if (t<0.00001 || t>0.99999)
-		{
-			bool zero_tangent = (tangent[0] == 0 && tangent[1] == 0);
+			int search_iterations(7);
 
-			if (t<0.5)
+			/*if(quality==0)search_iterations=8;
+			  else if(quality<=2)search_iterations=10;
+			  else if(quality<=4)search_iterations=8;
+			*/
+			if(perpendicular)
 			{
-				if (iter->get_split_tangent_angle() || iter->get_split_tangent_radius() || zero_tangent)
-				{
-					// fake the current tangent if we need to
-					if (zero_tangent) tangent = curve(FAKE_TANGENT_STEP) - curve(0);
+				if(quality>7)
+					search_iterations=4;
+			}
+			else					// not perpendicular
+			{
+				if(quality<=6)search_iterations=7;
+				else if(quality<=7)search_iterations=6;
+				else if(quality<=8)search_iterations=5;
+				else search_iterations=4;
+			}
 
-					// calculate the other tangent
-					Vector other_tangent(iter->get_tangent1());
-					if (other_tangent[0] == 0 && other_tangent[1] == 0)
-					{
-						// find the previous blinepoint
-						std::vector<synfig::BLinePoint>::const_iterator prev;
-						if (iter != bline.begin()) (prev = iter)--;
-						else if (loop) (prev = bline.end())--;
-						else prev = iter;
-
-						etl::hermite<Vector> other_curve(prev->get_vertex(), iter->get_vertex(), prev->get_tangent2(), iter->get_tangent1());
-						other_tangent = other_curve(1) - other_curve(1-FAKE_TANGENT_STEP);
-					}
+			// Figure out the closest point on the curve
+			if (fast)
+				t = curve.find_closest(fast, point,search_iterations);
 
-					// normalise and sum the two tangents
-					tangent=(other_tangent.norm()+tangent.norm());
-					edge_case=true;
-				}
-			}
-			else
+			// Calculate our values
+			p1=curve(t);			 // the closest point on the curve
+			tangent=deriv(t);		 // the tangent at that point
+
+			// if the point we're nearest to is at either end of the
+			// bline, our distance from the curve is the distance from the
+			// point on the curve.  we need to know which side of the
+			// curve we're on, so find the average of the two tangents at
+			// this point
+			if (t<0.00001 || t>0.99999)
 			{
-				if (next->get_split_tangent_angle() || next->get_split_tangent_radius() || zero_tangent)
-				{
-					// fake the current tangent if we need to
-					if (zero_tangent) tangent = curve(1) - curve(1-FAKE_TANGENT_STEP);
+				bool zero_tangent = (tangent[0] == 0 && tangent[1] == 0);
 
-					// calculate the other tangent
-					Vector other_tangent(next->get_tangent2());
-					if (other_tangent[0] == 0 && other_tangent[1] == 0)
+				if (t<0.5)
+				{
+					if (iter->get_split_tangent_angle() || iter->get_split_tangent_radius() || zero_tangent)
 					{
-						// find the next blinepoint
-						std::vector<synfig::BLinePoint>::const_iterator next2(next);
-						if (++next2 == bline.end())
+						// fake the current tangent if we need to
+						if (zero_tangent) tangent = curve(FAKE_TANGENT_STEP) - curve(0);
+
+						// calculate the other tangent
+						Vector other_tangent(iter->get_tangent1());
+						if (other_tangent[0] == 0 && other_tangent[1] == 0)
 						{
-							if (loop) next2 = bline.begin();
-							else next2 = next;
+							// find the previous blinepoint
+							std::vector<synfig::BLinePoint>::const_iterator prev;
+							if (iter != bline.begin()) (prev = iter)--;
+							else if (loop) (prev = bline.end())--;
+							else prev = iter;
+
+							etl::hermite<Vector> other_curve(prev->get_vertex(), iter->get_vertex(), prev->get_tangent2(), iter->get_tangent1());
+							other_tangent = other_curve(1) - other_curve(1-FAKE_TANGENT_STEP);
 						}
 
-						etl::hermite<Vector> other_curve(next->get_vertex(), next2->get_vertex(), next->get_tangent2(), next2->get_tangent1());
-						other_tangent = other_curve(FAKE_TANGENT_STEP) - other_curve(0);
+						// normalise and sum the two tangents
+						tangent=(other_tangent.norm()+tangent.norm());
+						edge_case=true;
 					}
+				}
+				else
+				{
+					if (next->get_split_tangent_angle() || next->get_split_tangent_radius() || zero_tangent)
+					{
+						// fake the current tangent if we need to
+						if (zero_tangent) tangent = curve(1) - curve(1-FAKE_TANGENT_STEP);
+
+						// calculate the other tangent
+						Vector other_tangent(next->get_tangent2());
+						if (other_tangent[0] == 0 && other_tangent[1] == 0)
+						{
+							// find the next blinepoint
+							std::vector<synfig::BLinePoint>::const_iterator next2(next);
+							if (++next2 == bline.end())
+							{
+								if (loop) next2 = bline.begin();
+								else next2 = next;
+							}
+
+							etl::hermite<Vector> other_curve(next->get_vertex(), next2->get_vertex(), next->get_tangent2(), next2->get_tangent1());
+							other_tangent = other_curve(FAKE_TANGENT_STEP) - other_curve(0);
+						}
 
-					// normalise and sum the two tangents
-					tangent=(other_tangent.norm()+tangent.norm());
-					edge_case=true;
+						// normalise and sum the two tangents
+						tangent=(other_tangent.norm()+tangent.norm());
+						edge_case=true;
+					}
 				}
 			}
-		}
-		tangent = tangent.norm();
+			tangent = tangent.norm();
 
-		if(perpendicular)
-		{
-			tangent*=curve_length_;
-			p1-=tangent*perp_dist;
-			tangent=-tangent.perp();
+			if(perpendicular)
+			{
+				tangent*=curve_length;
+				p1-=tangent*perp_dist;
+				tangent=-tangent.perp();
+			}
+			else					// not perpendicular
+				// the width of the bline at the closest point on the curve
+				thickness=(next->get_width()-iter->get_width())*t+iter->get_width();
 		}
-		else					// not perpendicular
-			// the width of the bline at the closest point on the curve
-			thickness=(next->get_width()-iter->get_width())*t+iter->get_width();
-	}
 
-	if(perpendicular)
-	{
-		if(quality>7)
+		if(perpendicular)
 		{
-			dist=perp_dist;
-/*			diff=tangent.perp();
-			const Real mag(diff.inv_mag());
-			supersample=supersample*mag;
-*/
-			supersample=0;
+			if(quality>7)
+			{
+				dist=perp_dist;
+	/*			diff=tangent.perp();
+				const Real mag(diff.inv_mag());
+				supersample=supersample*mag;
+	*/
+				supersample=0;
+			}
+			else
+			{
+				diff=tangent.perp();
+				//p1-=diff*0.5;
+				const Real mag(diff.inv_mag());
+				supersample=supersample*mag;
+				diff*=mag*mag;
+				dist=(point_-origin - p1)*diff;
+			}
 		}
-		else
+		else						// not perpendicular
 		{
-			diff=tangent.perp();
-			//p1-=diff*0.5;
+			if (edge_case)
+			{
+				diff=(p1-(point_-origin));
+				if(diff*tangent.perp()<0) diff=-diff;
+				diff=diff.norm()*thickness*width;
+			}
+			else
+				diff=tangent.perp()*thickness*width;
+
+			p1-=diff*0.5;
 			const Real mag(diff.inv_mag());
 			supersample=supersample*mag;
 			diff*=mag*mag;
 			dist=(point_-origin - p1)*diff;
 		}
-	}
-	else						// not perpendicular
-	{
-		if (edge_case)
-		{
-			diff=(p1-(point_-origin));
-			if(diff*tangent.perp()<0) diff=-diff;
-			diff=diff.norm()*thickness*width;
-		}
-		else
-			diff=tangent.perp()*thickness*width;
 
-		p1-=diff*0.5;
-		const Real mag(diff.inv_mag());
-		supersample=supersample*mag;
-		diff*=mag*mag;
-		dist=(point_-origin - p1)*diff;
+		return dist;
 	}
+};
 
-	if(loop)
-		dist-=floor(dist);
+inline Color
+shape_color(const rendering::TaskGradient::Shape::Handle &shape, const CompiledGradient &gradient, const Point &point, Real pw)
+	{ return shape ? shape->get_color(gradient, point, pw) : Color::alpha(); }
 
-	if(zigzag)
-	{
-		dist*=2.0;
-		supersample*=2.0;
-		if(dist>1)dist=2.0-dist;
-	}
+}
 
-	if(loop)
-	{
-		if(dist+supersample*0.5>1.0)
-		{
-			float  left(supersample*0.5-(dist-1.0));
-			float right(supersample*0.5+(dist-1.0));
-			Color pool(gradient(1.0-(left*0.5),left).premult_alpha()*left/supersample);
-			if (zigzag) pool+=gradient(1.0-right*0.5,right).premult_alpha()*right/supersample;
-			else		pool+=gradient(right*0.5,right).premult_alpha()*right/supersample;
-			return pool.demult_alpha();
-		}
-		if(dist-supersample*0.5<0.0)
-		{
-			float  left(supersample*0.5-dist);
-			float right(supersample*0.5+dist);
-			Color pool(gradient(right*0.5,right).premult_alpha()*right/supersample);
-			if (zigzag) pool+=gradient(left*0.5,left).premult_alpha()*left/supersample;
-			else		pool+=gradient(1.0-left*0.5,left).premult_alpha()*left/supersample;
-			return pool.demult_alpha();
-		}
-	}
-	return gradient(dist,supersample);
+/* === M E T H O D S ======================================================= */
+
+inline void
+CurveGradient::sync()
+{
+	std::vector<synfig::BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
+	curve_length_=calculate_distance(bline, bline_loop);
+}
+
+
+CurveGradient::CurveGradient():
+	Layer_Composite(1.0,Color::BLEND_COMPOSITE),
+	param_origin(ValueBase(Point(0,0))),
+	param_width(ValueBase(Real(0.25))),
+	param_bline(ValueBase(std::vector<synfig::BLinePoint>())),
+	param_gradient(Gradient(Color::black(), Color::white())),
+	param_loop(ValueBase(false)),
+	param_zigzag(ValueBase(false)),
+	param_perpendicular(ValueBase(false)),
+	param_fast(ValueBase(true))
+{
+	std::vector<synfig::BLinePoint> bline;
+	bline.push_back(BLinePoint());
+	bline.push_back(BLinePoint());
+	bline.push_back(BLinePoint());
+	bline[0].set_vertex(Point(0,1));
+	bline[1].set_vertex(Point(0,-1));
+	bline[2].set_vertex(Point(1,0));
+	bline[0].set_tangent(bline[1].get_vertex()-bline[2].get_vertex()*0.5f);
+	bline[1].set_tangent(bline[2].get_vertex()-bline[0].get_vertex()*0.5f);
+	bline[2].set_tangent(bline[0].get_vertex()-bline[1].get_vertex()*0.5f);
+	bline[0].set_width(1.0f);
+	bline[1].set_width(1.0f);
+	bline[2].set_width(1.0f);
+	bline_loop=true;
+	param_bline.set_list_of(bline);
+
+	sync();
+
+	SET_INTERPOLATION_DEFAULTS();
+	SET_STATIC_DEFAULTS();
 }
 
-float
-CurveGradient::calc_supersample(const synfig::Point &/*x*/, float pw,float /*ph*/)const
+rendering::TaskGradient::Shape::Handle
+CurveGradient::create_shape(int quality)const
 {
-	return pw;
+	std::vector<synfig::BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
+	if(bline.empty())
+		return rendering::TaskGradient::Shape::Handle();
+
+	etl::handle<CurveShape> shape(new CurveShape());
+	shape->origin=param_origin.get(Point());
+	shape->width=param_width.get(Real());
+	shape->bline.swap(bline);
+	shape->bline_loop=bline_loop;
+	shape->curve_length=curve_length_;
+	shape->loop=param_loop.get(bool());
+	shape->zigzag=param_zigzag.get(bool());
+	shape->perpendicular=param_perpendicular.get(bool());
+	shape->fast=param_fast.get(bool());
+	shape->quality=quality;
+	return shape;
 }
 
 synfig::Layer::Handle
@@ -495,7 +491,7 @@ CurveGradient::hit_check(synfig::Context context, const synfig::Point &point)con
 		return const_cast<CurveGradient*>(this);
 	if(get_amount()==0.0)
 		return context.hit_check(point);
-	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE|| get_blend_method()==Color::BLEND_ONTO) && color_func(point).get_a()>0.5)
+	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE|| get_blend_method()==Color::BLEND_ONTO) && shape_color(create_shape(),compiled_gradient.get(param_gradient.get(Gradient())),point,0).get_a()>0.5)
 		return const_cast<CurveGradient*>(this);
 	return context.hit_check(point);
 }
@@ -590,7 +586,7 @@ CurveGradient::get_param_vocab()const
 Color
 CurveGradient::get_color(Context context, const Point &point)const
 {
-	const Color color(color_func(point,0));
+	const Color color(shape_color(create_shape(0),compiled_gradient.get(param_gradient.get(Gradient())),point,0));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 		return color;
@@ -626,18 +622,21 @@ CurveGradient::accelerated_render(Context context,Surface *surface,int quality,
 	Point tl(renddesc.get_tl());
 	const int w(surface->get_w());
 	const int h(surface->get_h());
+	const rendering::TaskGradient::Shape::Handle shape(create_shape(quality));
+	const Real min_supersample=shape->get_min_supersample(Rect(tl,renddesc.get_br()),pw);
+	const CompiledGradient gradient(compiled_gradient.get(param_gradient.get(Gradient()), min_supersample));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(color_func(pos,quality,calc_supersample(pos,pw,ph)));
+				pen.put_value(shape_color(shape,gradient,pos,pw));
 	}
 	else
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(Color::blend(color_func(pos,quality,calc_supersample(pos,pw,ph)),pen.get_value(),get_amount(),get_blend_method()));
+				pen.put_value(Color::blend(shape_color(shape,gradient,pos,pw),pen.get_value(),get_amount(),get_blend_method()));
 	}
 
 	// Mark our progress as finished
@@ -647,6 +646,17 @@ CurveGradient::accelerated_render(Context context,Surface *surface,int quality,
 	return true;
 }
 
+rendering::Task::Handle
+CurveGradient::build_composite_task_vfunc(ContextParams context_params)const
+{
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	// same quality as legacy layers get from TaskLayerSW
+	task->shape=create_shape(4);
+	const Rect rect(get_canvas() ? get_canvas()->rend_desc().get_rect() : Rect::zero());
+	task->gradient=compiled_gradient.get(param_gradient.get(Gradient()), task->shape->get_min_supersample(rect, context_params.pixel_size));
+	return task;
+}
+
 ////
 bool
 CurveGradient::accelerated_cairorender(Context context, cairo_t *cr,int quality, const RendDesc &renddesc_, ProgressCallback *cb)const
@@ -662,6 +672,9 @@ CurveGradient::accelerated_cairorender(Context context, cairo_t *cr,int quality,
 	const Point tl(renddesc.get_tl());
 	const int w(renddesc.get_w());
 	const int h(renddesc.get_h());
+	const rendering::TaskGradient::Shape::Handle shape(create_shape(quality));
+	const Real min_supersample=shape->get_min_supersample(Rect(tl,renddesc.get_br()),pw);
+	const CompiledGradient gradient(compiled_gradient.get(param_gradient.get(Gradient()), min_supersample));
 	
 	SuperCallback supercb(cb,0,9500,10000);
 	
@@ -694,7 +707,7 @@ CurveGradient::accelerated_cairorender(Context context, cairo_t *cr,int quality,
 	}
 	for(y=0,pos[1]=tl[1];y<h;y++,pos[1]+=ph)
 		for(x=0,pos[0]=tl[0];x<w;x++,pos[0]+=pw)
-			csurface[y][x]=CairoColor(color_func(pos,calc_supersample(pos,pw,ph))).premult_alpha();
+			csurface[y][x]=CairoColor(shape_color(shape,gradient,pos,pw)).premult_alpha();
 	csurface.unmap_cairo_image();
 	
 	// paint surface on cr
@@ -33,6 +33,8 @@
 #include <synfig/vector.h>
 #include <synfig/layers/layer_composite.h>
 #include <synfig/gradient.h>
+#include <synfig/compiledgradient.h>
+#include <synfig/rendering/common/task/taskgradient.h>
 #include <synfig/blinepoint.h>
 
 /* === M A C R O S ========================================================= */
@@ -72,9 +74,9 @@ private:
 
 	void sync();
 
-	Color color_func(const Point &x, int quality=10, float supersample=0)const;
+	CompiledGradientCache compiled_gradient;
 
-	float calc_supersample(const Point &x, float pw,float ph)const;
+	rendering::TaskGradient::Shape::Handle create_shape(int quality=10)const;
 
 public:
 	CurveGradient();
@@ -87,6 +89,9 @@ public:
 	Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
+
+protected:
+	virtual rendering::Task::Handle build_composite_task_vfunc(ContextParams context_params)const;
 };
 
 /* === E N D =============================================================== */
@@ -61,6 +61,26 @@ SYNFIG_LAYER_SET_CVS_ID(LinearGradient,"$Id$");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+class LinearShape: public rendering::TaskGradient::Shape
+{
+public:
+	Point p1;
+	Vector diff;
+	Real inv_length;
+
+	LinearShape(): inv_length() { }
+
+	virtual Real get_position(const Point &point, Real &supersample) const
+	{
+		supersample*=inv_length;
+		return point*diff-p1*diff;
+	}
+};
+
+}
+
 /* === M E T H O D S ======================================================= */
 
 inline void
@@ -85,11 +105,11 @@ LinearGradient::LinearGradient():
 }
 
 inline void
-LinearGradient::fill_params(Params &params)const
+LinearGradient::fill_params(Params &params, synfig::Real min_supersample)const
 {
 	params.p1=param_p1.get(Point());
 	params.p2=param_p2.get(Point());
-	params.gradient=param_gradient.get(Gradient());
+	params.gradient=compiled_gradient.get(param_gradient.get(Gradient()), min_supersample);
 	params.loop=param_loop.get(bool());
 	params.zigzag=param_zigzag.get(bool());
 	params.calc_diff();
@@ -99,39 +119,7 @@ inline Color
 LinearGradient::color_func(const Params &params, const Point &point, synfig::Real supersample)const
 {
 	Real dist(point*params.diff-params.p1*params.diff);
-
-	if(params.loop)
-		dist-=floor(dist);
-
-	if(params.zigzag)
-	{
-		dist*=2.0;
-		supersample*=2.0;
-		if(dist>1)dist=2.0-dist;
-	}
-
-	if(params.loop)
-	{
-		if(dist+supersample*0.5>1.0)
-		{
-			synfig::Real  left(supersample*0.5-(dist-1.0));
-			synfig::Real right(supersample*0.5+(dist-1.0));
-			Color pool(params.gradient(1.0-(left*0.5),left).premult_alpha()*left/supersample);
-			if (params.zigzag) pool+=params.gradient(1.0-right*0.5,right).premult_alpha()*right/supersample;
-			else		       pool+=params.gradient(right*0.5,right).premult_alpha()*right/supersample;
-			return pool.demult_alpha();
-		}
-		if(dist-supersample*0.5<0.0)
-		{
-			synfig::Real  left(supersample*0.5-dist);
-			synfig::Real right(supersample*0.5+dist);
-			Color pool(params.gradient(right*0.5,right).premult_alpha()*right/supersample);
-			if (params.zigzag) pool+=params.gradient(left*0.5,left).premult_alpha()*left/supersample;
-			else		       pool+=params.gradient(1.0-left*0.5,left).premult_alpha()*left/supersample;
-			return pool.demult_alpha();
-		}
-	}
-	return params.gradient(dist,supersample);
+	return rendering::TaskGradient::sample(params.gradient, dist, supersample, params.loop, params.zigzag);
 }
 
 inline synfig::Real
@@ -279,6 +267,7 @@ LinearGradient::accelerated_render(Context context,Surface *surface,int quality,
 	const int w(surface->get_w());
 	const int h(surface->get_h());
 	synfig::Real supersample = calc_supersample(params, pw, ph);
+	params.gradient = compiled_gradient.get(param_gradient.get(Gradient()), fabs(supersample));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 	{
@@ -301,6 +290,28 @@ LinearGradient::accelerated_render(Context context,Surface *surface,int quality,
 }
 
 
+rendering::Task::Handle
+LinearGradient::build_composite_task_vfunc(ContextParams context_params)const
+{
+	Params params;
+	fill_params(params);
+	synfig::Real supersample = calc_supersample(params, context_params.pixel_size, context_params.pixel_size);
+	params.gradient = compiled_gradient.get(param_gradient.get(Gradient()), fabs(supersample));
+
+	etl::handle<LinearShape> shape(new LinearShape());
+	shape->p1=params.p1;
+	shape->diff=params.diff;
+	Real length=(params.p2-params.p1).mag();
+	shape->inv_length=length>0.0 ? 1.0/length : 0.0;
+	shape->loop=params.loop;
+	shape->zigzag=params.zigzag;
+
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->gradient=params.gradient;
+	task->shape=shape;
+	return task;
+}
+
 bool
 LinearGradient::accelerated_cairorender(Context context, cairo_t *cr, int quality, const RendDesc &renddesc, ProgressCallback *cb)const
 {
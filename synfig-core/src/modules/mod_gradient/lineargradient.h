@@ -33,6 +33,8 @@
 #include <synfig/vector.h>
 #include <synfig/layers/layer_composite.h>
 #include <synfig/gradient.h>
+#include <synfig/compiledgradient.h>
+#include <synfig/rendering/common/task/taskgradient.h>
 
 /* === M A C R O S ========================================================= */
 
@@ -62,14 +64,16 @@ private:
 		synfig::Point p1;
 		synfig::Point p2;
 		synfig::Point diff;
-		synfig::Gradient gradient;
+		synfig::CompiledGradient gradient;
 		bool loop;
 		bool zigzag;
 		inline Params(): loop(false), zigzag(false) { }
 		void calc_diff();
 	};
 
-	void fill_params(Params &params)const;
+	synfig::CompiledGradientCache compiled_gradient;
+
+	void fill_params(Params &params, synfig::Real min_supersample = 0.0)const;
 	synfig::Color color_func(const Params &params, const synfig::Point &x, synfig::Real supersample = 0.0)const;
 	synfig::Real calc_supersample(const Params &params, synfig::Real pw, synfig::Real ph)const;
 
@@ -87,6 +91,9 @@ public:
 	synfig::Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
+
+protected:
+	virtual rendering::Task::Handle build_composite_task_vfunc(ContextParams context_params)const;
 };
 
 /* === E N D =============================================================== */
@@ -64,6 +64,25 @@ SYNFIG_LAYER_SET_CVS_ID(RadialGradient,"$Id$");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+class RadialShape: public rendering::TaskGradient::Shape
+{
+public:
+	Point center;
+	Real radius;
+
+	RadialShape(): radius() { }
+
+	virtual Real get_position(const Point &point, Real &supersample) const
+	{
+		supersample *= 1.2/radius;
+		return (point - center).mag()/radius;
+	}
+};
+
+}
+
 /* === M E T H O D S ======================================================= */
 
 /* === E N T R Y P O I N T ================================================= */
@@ -142,59 +161,15 @@ RadialGradient::get_param_vocab()const
 	return ret;
 }
 
-inline Color
-RadialGradient::color_func(const Point &point, float supersample)const
-{
-	Gradient gradient=param_gradient.get(Gradient());
-	Point center=param_center.get(Point());
-	Real radius=param_radius.get(Real());
-	bool loop=param_loop.get(bool());
-	bool zigzag=param_zigzag.get(bool());
-
-	Real dist((point-center).mag()/radius);
-
-	if(loop)
-		dist-=floor(dist);
-	
-	if(zigzag)
-	{
-		dist*=2.0;
-		supersample*=2.0;
-		if(dist>1)dist=2.0-dist;
-	}
-
-	if(loop)
-	{
-		if(dist+supersample*0.5>1.0)
-		{
-			float  left(supersample*0.5-(dist-1.0));
-			float right(supersample*0.5+(dist-1.0));
-			Color pool(gradient(1.0-(left*0.5),left).premult_alpha()*left/supersample);
-			if (zigzag) pool+=gradient(1.0-right*0.5,right).premult_alpha()*right/supersample;
-			else		pool+=gradient(right*0.5,right).premult_alpha()*right/supersample;
-			return pool.demult_alpha();
-		}
-		if(dist-supersample*0.5<0.0)
-		{
-			float  left(supersample*0.5-dist);
-			float right(supersample*0.5+dist);
-			Color pool(gradient(right*0.5,right).premult_alpha()*right/supersample);
-			if (zigzag) pool+=gradient(left*0.5,left).premult_alpha()*left/supersample;
-			else		pool+=gradient(1.0-left*0.5,left).premult_alpha()*left/supersample;
-			return pool.demult_alpha();
-		}
-	}
-
-	return gradient(dist,supersample);
-}
-
-
-float
-RadialGradient::calc_supersample(const synfig::Point &/*x*/, float pw,float /*ph*/)const
+rendering::TaskGradient::Shape::Handle
+RadialGradient::create_shape()const
 {
-	Real radius=param_radius.get(Real());
-//	return sqrt(pw*pw+ph*ph)/radius;
-	return 1.2*pw/radius;
+	etl::handle<RadialShape> shape(new RadialShape());
+	shape->center=param_center.get(Point());
+	shape->radius=param_radius.get(Real());
+	shape->loop=param_loop.get(bool());
+	shape->zigzag=param_zigzag.get(bool());
+	return shape;
 }
 
 synfig::Layer::Handle
@@ -204,7 +179,7 @@ RadialGradient::hit_check(synfig::Context context, const synfig::Point &point)co
 		return const_cast<RadialGradient*>(this);
 	if(get_amount()==0.0)
 		return context.hit_check(point);
-	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE) && color_func(point).get_a()>0.5)
+	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE) && create_shape()->get_color(compiled_gradient.get(param_gradient.get(Gradient())),point,0).get_a()>0.5)
 		return const_cast<RadialGradient*>(this);
 	return context.hit_check(point);
 }
@@ -212,7 +187,7 @@ RadialGradient::hit_check(synfig::Context context, const synfig::Point &point)co
 Color
 RadialGradient::get_color(Context context, const Point &pos)const
 {
-	const Color color(color_func(pos));
+	const Color color(create_shape()->get_color(compiled_gradient.get(param_gradient.get(Gradient())),pos,0));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 		return color;
@@ -248,18 +223,20 @@ RadialGradient::accelerated_render(Context context,Surface *surface,int quality,
 	Point tl(renddesc.get_tl());
 	const int w(surface->get_w());
 	const int h(surface->get_h());
+	const rendering::TaskGradient::Shape::Handle shape(create_shape());
+	const CompiledGradient gradient(compiled_gradient.get(param_gradient.get(Gradient()), shape->get_min_supersample(Rect(tl,renddesc.get_br()),pw)));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(color_func(pos,calc_supersample(pos,pw,ph)));
+				pen.put_value(shape->get_color(gradient,pos,pw));
 	}
 	else
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(Color::blend(color_func(pos,calc_supersample(pos,pw,ph)),pen.get_value(),get_amount(),get_blend_method()));
+				pen.put_value(Color::blend(shape->get_color(gradient,pos,pw),pen.get_value(),get_amount(),get_blend_method()));
 	}
 
 	// Mark our progress as finished
@@ -270,6 +247,16 @@ RadialGradient::accelerated_render(Context context,Surface *surface,int quality,
 }
 
 
+rendering::Task::Handle
+RadialGradient::build_composite_task_vfunc(ContextParams context_params)const
+{
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->shape=create_shape();
+	const Rect rect(get_canvas() ? get_canvas()->rend_desc().get_rect() : Rect::zero());
+	task->gradient=compiled_gradient.get(param_gradient.get(Gradient()), task->shape->get_min_supersample(rect, context_params.pixel_size));
+	return task;
+}
+
 bool
 RadialGradient::accelerated_cairorender(Context context,cairo_t *cr, int quality, const RendDesc &renddesc, ProgressCallback *cb)const
 {
@@ -64,6 +64,44 @@ SYNFIG_LAYER_SET_CVS_ID(SpiralGradient,"$Id$");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+class SpiralShape: public rendering::TaskGradient::Shape
+{
+public:
+	Point center;
+	Real radius;
+	Angle angle;
+	bool clockwise;
+
+	SpiralShape(): radius(), clockwise() { loop=true; }
+
+	virtual Real get_position(const Point &point, Real &supersample) const
+	{
+		const Point centered(point-center);
+		const Real dist(centered.mag());
+		const Real pw(supersample);
+		supersample=1.41421*pw/radius;
+		if(dist>0.0)
+			supersample+=(1.41421*pw/dist)/(PI*2);
+		supersample*=0.5;
+		if(supersample<0.00001)supersample=0.00001;
+
+		Angle a;
+		a=Angle::tan(-centered[1],centered[0]).mod();
+		a=a+angle;
+
+		Real pos(dist/radius);
+		if(clockwise)
+			pos+=Angle::rot(a.mod()).get();
+		else
+			pos-=Angle::rot(a.mod()).get();
+		return pos;
+	}
+};
+
+}
+
 /* === M E T H O D S ======================================================= */
 
 /* === E N T R Y P O I N T ================================================= */
@@ -143,57 +181,15 @@ SpiralGradient::get_param_vocab()const
 	return ret;
 }
 
-inline Color
-SpiralGradient::color_func(const Point &pos, float supersample)const
+rendering::TaskGradient::Shape::Handle
+SpiralGradient::create_shape()const
 {
-
-	Gradient gradient=param_gradient.get(Gradient());
-	Point center=param_center.get(Point());
-	Real radius=param_radius.get(Real());
-	Angle angle=param_angle.get(Angle());
-	bool clockwise=param_clockwise.get(bool());
-	
-	const Point centered(pos-center);
-	Angle a;
-	a=Angle::tan(-centered[1],centered[0]).mod();
-	a=a+angle;
-
-	if(supersample<0.00001)supersample=0.00001;
-
-	Real dist((pos-center).mag()/radius);
-	if(clockwise)
-		dist+=Angle::rot(a.mod()).get();
-	else
-		dist-=Angle::rot(a.mod()).get();
-
-	dist-=floor(dist);
-	if(dist+supersample*0.5>1.0)
-	{
-		float  left(supersample*0.5-(dist-1.0));
-		float right(supersample*0.5+(dist-1.0));
-		Color pool(gradient(1.0-(left*0.5),left).premult_alpha()*left/supersample);
-		pool+=gradient(right*0.5,right).premult_alpha()*right/supersample;
-		return pool.demult_alpha();
-	}
-	if(dist-supersample*0.5<0.0)
-	{
-		float  left(supersample*0.5-dist);
-		float right(supersample*0.5+dist);
-		Color pool(gradient(right*0.5,right).premult_alpha()*right/supersample);
-		pool+=gradient(1.0-left*0.5,left).premult_alpha()*left/supersample;
-		return pool.demult_alpha();
-	}
-
-	return gradient(dist,supersample);
-}
-
-float
-SpiralGradient::calc_supersample(const synfig::Point &x, float pw,float /*ph*/)const
-{
-	Point center=param_center.get(Point());
-	Real radius=param_radius.get(Real());
-
-	return (1.41421*pw/radius+(1.41421*pw/Point(x-center).mag())/(PI*2))*0.5;
+	etl::handle<SpiralShape> shape(new SpiralShape());
+	shape->center=param_center.get(Point());
+	shape->radius=param_radius.get(Real());
+	shape->angle=param_angle.get(Angle());
+	shape->clockwise=param_clockwise.get(bool());
+	return shape;
 }
 
 synfig::Layer::Handle
@@ -203,7 +199,7 @@ SpiralGradient::hit_check(synfig::Context context, const synfig::Point &point)co
 		return const_cast<SpiralGradient*>(this);
 	if(get_amount()==0.0)
 		return context.hit_check(point);
-	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE) && color_func(point).get_a()>0.5)
+	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE) && create_shape()->get_color(compiled_gradient.get(param_gradient.get(Gradient())),point,0).get_a()>0.5)
 		return const_cast<SpiralGradient*>(this);
 	return context.hit_check(point);
 }
@@ -211,7 +207,7 @@ SpiralGradient::hit_check(synfig::Context context, const synfig::Point &point)co
 Color
 SpiralGradient::get_color(Context context, const Point &pos)const
 {
-	const Color color(color_func(pos));
+	const Color color(create_shape()->get_color(compiled_gradient.get(param_gradient.get(Gradient())),pos,0));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 		return color;
@@ -247,18 +243,21 @@ SpiralGradient::accelerated_render(Context context,Surface *surface,int quality,
 	Point tl(renddesc.get_tl());
 	const int w(surface->get_w());
 	const int h(surface->get_h());
+	const rendering::TaskGradient::Shape::Handle shape(create_shape());
+	const Real min_supersample=shape->get_min_supersample(Rect(tl,renddesc.get_br()),pw);
+	const CompiledGradient gradient(compiled_gradient.get(param_gradient.get(Gradient()), min_supersample));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(color_func(pos,calc_supersample(pos,pw,ph)));
+				pen.put_value(shape->get_color(gradient,pos,pw));
 	}
 	else
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(Color::blend(color_func(pos,calc_supersample(pos,pw,ph)),pen.get_value(),get_amount(),get_blend_method()));
+				pen.put_value(Color::blend(shape->get_color(gradient,pos,pw),pen.get_value(),get_amount(),get_blend_method()));
 	}
 
 	// Mark our progress as finished
@@ -268,6 +267,16 @@ SpiralGradient::accelerated_render(Context context,Surface *surface,int quality,
 	return true;
 }
 
+rendering::Task::Handle
+SpiralGradient::build_composite_task_vfunc(ContextParams context_params)const
+{
+	rendering::TaskGradient::Handle task(new rendering::TaskGradient());
+	task->shape=create_shape();
+	const Rect rect(get_canvas() ? get_canvas()->rend_desc().get_rect() : Rect::zero());
+	task->gradient=compiled_gradient.get(param_gradient.get(Gradient()), task->shape->get_min_supersample(rect, context_params.pixel_size));
+	return task;
+}
+
 ////
 bool
 SpiralGradient::accelerated_cairorender(Context context, cairo_t *cr,int quality, const RendDesc &renddesc_, ProgressCallback *cb)const
@@ -283,6 +292,9 @@ SpiralGradient::accelerated_cairorender(Context context, cairo_t *cr,int quality
 	const Point tl(renddesc.get_tl());
 	const int w(renddesc.get_w());
 	const int h(renddesc.get_h());
+	const rendering::TaskGradient::Shape::Handle shape(create_shape());
+	const Real min_supersample=shape->get_min_supersample(Rect(tl,renddesc.get_br()),pw);
+	const CompiledGradient gradient(compiled_gradient.get(param_gradient.get(Gradient()), min_supersample));
 	
 	SuperCallback supercb(cb,0,9500,10000);
 	
@@ -315,7 +327,7 @@ SpiralGradient::accelerated_cairorender(Context context, cairo_t *cr,int quality
 	}
 	for(y=0,pos[1]=tl[1];y<h;y++,pos[1]+=ph)
 		for(x=0,pos[0]=tl[0];x<w;x++,pos[0]+=pw)
-			csurface[y][x]=CairoColor(color_func(pos,calc_supersample(pos,pw,ph))).premult_alpha();
+			csurface[y][x]=CairoColor(shape->get_color(gradient,pos,pw)).premult_alpha();
 	csurface.unmap_cairo_image();
 	
 	// paint surface on cr
@@ -32,6 +32,8 @@
 #include <synfig/vector.h>
 #include <synfig/value.h>
 #include <synfig/gradient.h>
+#include <synfig/compiledgradient.h>
+#include <synfig/rendering/common/task/taskgradient.h>
 #include <synfig/angle.h>
 
 /* === M A C R O S ========================================================= */
@@ -60,9 +62,9 @@ private:
 	//! Parameter: (bool)
 	ValueBase param_clockwise;
 
-	Color color_func(const Point &x, float supersample=0)const;
+	CompiledGradientCache compiled_gradient;
 
-	float calc_supersample(const Point &x, float pw,float ph)const;
+	rendering::TaskGradient::Shape::Handle create_shape()const;
 
 public:
 
@@ -79,6 +81,9 @@ public:
 	Layer::Handle hit_check(Context context, const Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
+
+protected:
+	virtual rendering::Task::Handle build_composite_task_vfunc(ContextParams context_params)const;
 }; // END of class SpiralGradient
 
 /* === E N D =============================================================== */
@@ -162,10 +162,7 @@ imagemagick_trgt::start_frame(synfig::ProgressCallback *cb)
 	string newfilename;
 
 	if (multi_image)
-		newfilename = (filename_sans_extension(filename) +
-					   sequence_separator +
-					   etl::strprintf("%04d",imagecount) +
-					   filename_extension(filename));
+		newfilename = get_sequence_filename(filename, sequence_separator, imagecount);
 	else
 		newfilename = filename;
 
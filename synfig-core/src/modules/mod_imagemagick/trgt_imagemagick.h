@@ -66,6 +66,8 @@ public:
 	virtual void end_frame();
 	virtual synfig::Color * start_scanline(int scanline);
 	virtual bool end_scanline();
+
+	virtual bool writes_frame_per_file()const { return true; }
 };
 
 /* === E N D =============================================================== */
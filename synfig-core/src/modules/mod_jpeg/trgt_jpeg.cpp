@@ -33,11 +33,14 @@
 #endif
 
 #include "trgt_jpeg.h"
+#include <synfig/localization.h>
+#include <synfig/surface.h>
 #include <jpeglib.h>
 #include <ETL/stringf>
 #include <cstdio>
 #include <algorithm>
 #include <functional>
+#include <vector>
 #endif
 
 /* === M A C R O S ========================================================= */
@@ -113,10 +116,7 @@ jpeg_trgt::start_frame(synfig::ProgressCallback *callback)
 	}
 	else if(multi_image)
 	{
-		String newfilename(filename_sans_extension(filename) +
-						   sequence_separator +
-						   etl::strprintf("%04d",imagecount) +
-						   filename_extension(filename));
+		String newfilename(get_sequence_filename(filename, sequence_separator, imagecount));
 		file=fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE);
 		if(callback)callback->task(newfilename);
 	}
@@ -199,3 +199,48 @@ jpeg_trgt::end_scanline()
 
 	return true;
 }
+
+bool
+jpeg_trgt::can_write_frames_async()const
+{
+	return multi_image && writes_frame_per_file();
+}
+
+bool
+jpeg_trgt::write_frame(const Surface &surface, int frame)
+{
+	int w=desc.get_w(),h=desc.get_h();
+	if(surface.get_w()!=w || surface.get_h()!=h)
+		return false;
+
+	String newfilename(get_sequence_filename(filename, sequence_separator, frame));
+	FILE *frame_file=fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE);
+	if(!frame_file)
+		throw String(_("Unable to open file")) + " " + newfilename;
+
+	struct jpeg_compress_struct frame_cinfo;
+	struct jpeg_error_mgr frame_jerr;
+	frame_cinfo.err = jpeg_std_error(&frame_jerr);
+	jpeg_create_compress(&frame_cinfo);
+	jpeg_stdio_dest(&frame_cinfo, frame_file);
+
+	frame_cinfo.image_width = w;
+	frame_cinfo.image_height = h;
+	frame_cinfo.input_components = 3;
+	frame_cinfo.in_color_space = JCS_RGB;
+	jpeg_set_defaults(&frame_cinfo);
+	jpeg_set_quality(&frame_cinfo, quality, TRUE /* limit to baseline-JPEG values */);
+	jpeg_start_compress(&frame_cinfo, TRUE);
+
+	std::vector<unsigned char> row(3*w);
+	JSAMPROW row_pointer = &row.front();
+	for(int y = 0; y < h; ++y)
+	{
+		convert_color_format(&row.front(), surface[y], w, PF_RGB, gamma());
+		jpeg_write_scanlines(&frame_cinfo, &row_pointer, 1);
+	}
+
+	jpeg_finish_compress(&frame_cinfo);
+	jpeg_destroy_compress(&frame_cinfo);
+	return fclose(frame_file) == 0;
+}
@@ -65,6 +65,7 @@ extern "C"
 #	include "trgt_av.h"
 #	include <synfig/general.h>
 #	include <synfig/localization.h>
+#	include <glib.h>
 #	include <cstdio>
 #	include <algorithm>
 #	include <functional>
@@ -105,6 +106,7 @@ struct VideoInfo
 	int	fps;
 
 	int bitrate;
+	int threads;
 };
 
 struct AudioInfo
@@ -316,6 +318,10 @@ class VideoEncoder
 {
 public:
 	AVFrame *encodable;	//for compression and output to a file (in compatible pixel format)
+#ifdef WITH_LIBSWSCALE
+	//! converts RGB24 pictures into encodable, lives while the codec is open
+	struct SwsContext *img_convert_ctx;
+#endif
 
 	vector<unsigned char>	videobuffer;
 
@@ -387,6 +393,17 @@ public:
 				synfig::warning("open_video: could not allocate encodable picture");
 				return 0;
 			}
+
+#ifdef WITH_LIBSWSCALE
+			img_convert_ctx = sws_getContext(context->width, context->height, PIX_FMT_RGB24,
+				context->width, context->height, context->pix_fmt,
+				SWS_BICUBIC, NULL, NULL, NULL);
+			if(!img_convert_ctx)
+			{
+				synfig::warning("open_video: could not create scaling context");
+				return 0;
+			}
+#endif
 		}
 
 		return true;
@@ -419,17 +436,9 @@ public:
 		{
 			//We're using RGBA at the moment, write custom conversion code later (get less accuracy errors)
 #ifdef WITH_LIBSWSCALE
-			struct SwsContext* img_convert_ctx =
-				sws_getContext(context->width, context->height, PIX_FMT_RGB24,
-					context->width, context->height, context->pix_fmt,
-					SWS_BICUBIC, NULL, NULL, NULL);
-
 			sws_scale(img_convert_ctx, pict->data, pict->linesize,
-
 				0, context->height, encodable->data,
 				encodable->linesize);
-
-			sws_freeContext (img_convert_ctx);
 #else
 			img_convert((AVPicture *)encodable, context->pix_fmt,
 						(AVPicture *)pict, PIX_FMT_RGB24,
@@ -508,6 +517,14 @@ public:
 			encodable = 0;
 		}
 
+#ifdef WITH_LIBSWSCALE
+		if (img_convert_ctx)
+		{
+			sws_freeContext(img_convert_ctx);
+			img_convert_ctx = 0;
+		}
+#endif
+
 		videobuffer.resize(0);
 	}
 };
@@ -549,8 +566,14 @@ public:
 		video_pts = 0;
 
 		vid.encodable = 0;
+#ifdef WITH_LIBSWSCALE
+		vid.img_convert_ctx = 0;
+#endif
+		vid.startedencoding = false;
 		//vid.stream_nb_frames = 2;	//reasonable default
 
+		vInfo.threads = 1;
+
 		initialized = false;
 		picture = 0;
 
@@ -780,6 +803,17 @@ public:
 
 		context->gop_size = info.fps/4; /* emit one intra frame every twelve frames at most */
 
+		//let the encoder use its own frame and slice threads
+		if (info.threads > 1)
+		{
+#if LIBAVCODEC_VERSION_INT >= ((52<<16)+(112<<8))
+			context->thread_count = info.threads;
+			context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+#else
+			avcodec_thread_init(context, info.threads);
+#endif
+		}
+
 		//HACK: MPEG requires b frames be set... any better way to do this?
 		if (context->codec_id == CODEC_ID_MPEG1VIDEO ||
 			context->codec_id == CODEC_ID_MPEG2VIDEO)
@@ -820,7 +854,7 @@ public:
 /* === M E T H O D S ======================================================= */
 
 Target_LibAVCodec::Target_LibAVCodec(const char *Filename,
-									 const synfig::TargetParam& /* params */):
+									 const synfig::TargetParam& params):
 	filename(Filename)
 {
 	if(!registered)
@@ -831,6 +865,7 @@ Target_LibAVCodec::Target_LibAVCodec(const char *Filename,
 	set_remove_alpha();
 
 	data = new LibAVEncoder;
+	data->vInfo.threads = params.threads > 0 ? params.threads : (int)g_get_num_processors();
 }
 
 Target_LibAVCodec::~Target_LibAVCodec()
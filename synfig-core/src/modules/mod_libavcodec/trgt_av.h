@@ -54,7 +54,7 @@ private:
 
 public:
 	Target_LibAVCodec(const char *filename,
-					  const synfig::TargetParam& /* params */);
+					  const synfig::TargetParam& params);
 	virtual ~Target_LibAVCodec();
 
 	virtual bool init(synfig::ProgressCallback *cb);
@@ -81,6 +81,7 @@ public:
 	virtual synfig::Rect get_bounding_rect(synfig::Context context)const;
 	virtual Vocab get_param_vocab()const;
 	virtual bool reads_context()const { return true; }
+	virtual bool is_render_cacheable()const { return param_speed.get(synfig::Real()) == 0.0; }
 
 protected:
 	virtual synfig::RendDesc get_sub_renddesc_vfunc(const synfig::RendDesc &renddesc) const;
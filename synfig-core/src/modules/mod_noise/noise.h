@@ -81,6 +81,7 @@ public:
 	virtual bool accelerated_render(synfig::Context context,synfig::Surface *surface,int quality, const synfig::RendDesc &renddesc, synfig::ProgressCallback *cb)const;
 	synfig::Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_render_cacheable()const { return param_speed.get(synfig::Real()) == 0.0; }
 };
 
 /* === E N D =============================================================== */
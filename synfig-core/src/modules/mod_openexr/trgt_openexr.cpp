@@ -113,10 +113,7 @@ exr_trgt::start_frame(synfig::ProgressCallback *cb)
 		delete exr_file;
 	if(multi_image)
 	{
-		frame_name = (filename_sans_extension(filename) +
-					  sequence_separator +
-					  etl::strprintf("%04d",imagecount) +
-					  filename_extension(filename));
+		frame_name = get_sequence_filename(filename, sequence_separator, imagecount);
 		if(cb)cb->task(frame_name);
 	}
 	else
@@ -189,3 +186,44 @@ exr_trgt::end_scanline()
 
 	return true;
 }
+
+bool
+exr_trgt::can_write_frames_async()const
+{
+	return multi_image;
+}
+
+bool
+exr_trgt::write_frame(const Surface &surface, int frame)
+{
+	int w=desc.get_w(),h=desc.get_h();
+	if(surface.get_w()!=w || surface.get_h()!=h)
+		return false;
+
+	etl::surface<Imf::Rgba> frame_surface;
+	frame_surface.set_wh(w,h);
+	for(int y = 0; y < h; ++y)
+	{
+		for(int x = 0; x < w; ++x)
+		{
+			Imf::Rgba &rgba=frame_surface[y][x];
+			const Color &color=surface[y][x];
+			rgba.r=color.get_r();
+			rgba.g=color.get_g();
+			rgba.b=color.get_b();
+			rgba.a=color.get_a();
+		}
+	}
+
+	try
+	{
+		Imf::RgbaOutputFile frame_file(get_sequence_filename(filename, sequence_separator, frame).c_str(),w,h,Imf::WRITE_RGBA,desc.get_pixel_aspect());
+		frame_file.setFrameBuffer(frame_surface[0],1,w);
+		frame_file.writePixels(h);
+	}
+	catch(const std::exception &e)
+	{
+		throw String(e.what());
+	}
+	return true;
+}
@@ -71,6 +71,10 @@ public:
 	virtual synfig::Color * start_scanline(int scanline);
 	virtual bool end_scanline(void);
 
+	virtual bool writes_frame_per_file()const { return true; }
+	virtual bool can_write_frames_async()const;
+	virtual bool write_frame(const synfig::Surface &surface, int frame);
+
 
 	SYNFIG_TARGET_MODULE_EXT
 };
@@ -96,10 +96,7 @@ cairo_png_trgt::obtain_surface(cairo_surface_t *&surface)
 	}
 	else if(multi_image)
 	{
-		filename = (filename_sans_extension(base_filename) +
-						   sequence_separator +
-						   etl::strprintf("%04d",imagecount) +
-						   filename_extension(base_filename));
+		filename = get_sequence_filename(base_filename, sequence_separator, imagecount);
 	}
 	else
 	{
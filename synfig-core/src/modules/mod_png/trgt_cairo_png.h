@@ -63,6 +63,8 @@ public:
 
 	virtual bool obtain_surface(cairo_surface_t *&surface);
 	virtual bool put_surface(cairo_surface_t *surface, synfig::ProgressCallback *cb=NULL);
+
+	virtual bool writes_frame_per_file()const { return true; }
 };
 
 /* === E N D =============================================================== */
@@ -34,15 +34,18 @@
 
 #include <synfig/localization.h>
 #include <synfig/general.h>
+#include <synfig/surface.h>
 
 #include "trgt_png.h"
 #include <png.h>
+#include <zlib.h>
 #include <ETL/stringf>
 #include <cstdio>
 #include <algorithm>
 #include <functional>
 #include <ETL/misc>
 #include <string.h>
+#include <vector>
 
 #endif
 
@@ -67,7 +70,7 @@ png_trgt::png_out_error(png_struct *png_data,const char *msg)
 {
 	png_trgt *me=(png_trgt*)png_get_error_ptr(png_data);
 	synfig::error(strprintf("png_trgt: error: %s",msg));
-	me->ready=false;
+	if(me) me->ready=false;
 }
 
 void
@@ -75,7 +78,7 @@ png_trgt::png_out_warning(png_struct *png_data,const char *msg)
 {
 	png_trgt *me=(png_trgt*)png_get_error_ptr(png_data);
 	synfig::warning(strprintf("png_trgt: warning: %s",msg));
-	me->ready=false;
+	if(me) me->ready=false;
 }
 
 
@@ -91,8 +94,44 @@ png_trgt::png_trgt(const char *Filename, const synfig::TargetParam &params):
 	filename(Filename),
 	buffer(NULL),
 	color_buffer(NULL),
-	sequence_separator(params.sequence_separator)
-{ }
+	sequence_separator(params.sequence_separator),
+	compression_level(params.compression_level),
+	compression_strategy(-1),
+	filter(PNG_FILTER_NONE),
+	bit_depth(8)
+{
+	if (compression_level > 9)
+	{
+		synfig::warning("png_trgt: invalid compression level %d, use default", compression_level);
+		compression_level = -1;
+	}
+
+	const String &strategy = params.compression_strategy;
+	if (strategy.empty())
+		{ }
+	else if (strategy == "default")  compression_strategy = Z_DEFAULT_STRATEGY;
+	else if (strategy == "filtered") compression_strategy = Z_FILTERED;
+	else if (strategy == "huffman")  compression_strategy = Z_HUFFMAN_ONLY;
+	else if (strategy == "rle")      compression_strategy = Z_RLE;
+	else if (strategy == "fixed")    compression_strategy = Z_FIXED;
+	else synfig::warning("png_trgt: unknown compression strategy '%s', use default", strategy.c_str());
+
+	// adaptive filtering gives smaller files, no filtering is the fastest
+	const String &f = params.filter;
+	if (f.empty() || f == "none") { }
+	else if (f == "sub")   filter = PNG_FILTER_SUB;
+	else if (f == "up")    filter = PNG_FILTER_UP;
+	else if (f == "avg")   filter = PNG_FILTER_AVG;
+	else if (f == "paeth") filter = PNG_FILTER_PAETH;
+	else if (f == "all")   filter = PNG_ALL_FILTERS;
+	else synfig::warning("png_trgt: unknown filter '%s', use none", f.c_str());
+
+	if (params.bit_depth == 16)
+		bit_depth = 16;
+	else
+	if (params.bit_depth > 0 && params.bit_depth != 8)
+		synfig::warning("png_trgt: unsupported bit depth %d, use 8", params.bit_depth);
+}
 
 png_trgt::~png_trgt()
 {
@@ -146,10 +185,7 @@ png_trgt::start_frame(synfig::ProgressCallback *callback)
 	}
 	else if(multi_image)
 	{
-		String newfilename(filename_sans_extension(filename) +
-						   sequence_separator +
-						   etl::strprintf("%04d",imagecount) +
-						   filename_extension(filename));
+		String newfilename(get_sequence_filename(filename, sequence_separator, imagecount));
 		file=fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE);
 		if(callback)callback->task(newfilename);
 	}
@@ -163,7 +199,7 @@ png_trgt::start_frame(synfig::ProgressCallback *callback)
 		return false;
 
 	delete [] buffer;
-	buffer=new unsigned char[4*w];
+	buffer=new unsigned char[get_row_size()];
 
 	delete [] color_buffer;
 	color_buffer=new Color[w];
@@ -193,13 +229,44 @@ png_trgt::start_frame(synfig::ProgressCallback *callback)
 		return false;
 	}
 	png_init_io(png_ptr,file);
-	png_set_filter(png_ptr,0,PNG_FILTER_NONE);
 
 	setjmp(png_jmpbuf(png_ptr));
+	write_info(png_ptr, info_ptr);
+	ready=true;
+	return true;
+}
+
+int
+png_trgt::get_row_size()const
+{
+	return desc.get_w()*4*(bit_depth/8);
+}
+
+void
+png_trgt::convert_row(unsigned char *dest, const Color *src)const
+{
+	PixelFormat pf = get_alpha_mode()==TARGET_ALPHA_MODE_KEEP ? PF_RGB|PF_A : PF_RGB;
+	if (bit_depth == 16)
+		convert_color_format_u16((unsigned short*)dest, src, desc.get_w(), pf, gamma());
+	else
+		convert_color_format(dest, src, desc.get_w(), pf, gamma());
+}
+
+void
+png_trgt::write_info(png_structp png_ptr, png_infop info_ptr)
+{
+	int w=desc.get_w(),h=desc.get_h();
+
+	png_set_filter(png_ptr,0,filter);
+	if (compression_level >= 0)
+		png_set_compression_level(png_ptr,compression_level);
+	if (compression_strategy >= 0)
+		png_set_compression_strategy(png_ptr,compression_strategy);
+
 	if (get_alpha_mode()==TARGET_ALPHA_MODE_KEEP)
-		png_set_IHDR(png_ptr,info_ptr,w,h,8,PNG_COLOR_TYPE_RGBA,PNG_INTERLACE_NONE,PNG_COMPRESSION_TYPE_DEFAULT,PNG_FILTER_TYPE_DEFAULT);
+		png_set_IHDR(png_ptr,info_ptr,w,h,bit_depth,PNG_COLOR_TYPE_RGBA,PNG_INTERLACE_NONE,PNG_COMPRESSION_TYPE_DEFAULT,PNG_FILTER_TYPE_DEFAULT);
 	else
-		png_set_IHDR(png_ptr,info_ptr,w,h,8,PNG_COLOR_TYPE_RGB,PNG_INTERLACE_NONE,PNG_COMPRESSION_TYPE_DEFAULT,PNG_FILTER_TYPE_DEFAULT);
+		png_set_IHDR(png_ptr,info_ptr,w,h,bit_depth,PNG_COLOR_TYPE_RGB,PNG_INTERLACE_NONE,PNG_COMPRESSION_TYPE_DEFAULT,PNG_FILTER_TYPE_DEFAULT);
 
 	// Write the gamma
 	//png_set_gAMA(png_ptr, info_ptr,1.0/gamma().get_gamma());
@@ -226,8 +293,11 @@ png_trgt::start_frame(synfig::ProgressCallback *callback)
 
 	png_write_info_before_PLTE(png_ptr, info_ptr);
 	png_write_info(png_ptr, info_ptr);
-	ready=true;
-	return true;
+
+	// 16-bit samples are converted in native byte order, PNG wants big-endian
+	const unsigned short one = 1;
+	if (bit_depth == 16 && *(const unsigned char*)&one)
+		png_set_swap(png_ptr);
 }
 
 Color *
@@ -242,13 +312,60 @@ png_trgt::end_scanline()
 	if(!file || !ready)
 		return false;
 
-	if (get_alpha_mode()==TARGET_ALPHA_MODE_KEEP)
-		convert_color_format(buffer, color_buffer, desc.get_w(), PF_RGB|PF_A, gamma());
-	else
-		convert_color_format(buffer, color_buffer, desc.get_w(), PF_RGB, gamma());
+	convert_row(buffer, color_buffer);
 
 	setjmp(png_jmpbuf(png_ptr));
 	png_write_row(png_ptr,buffer);
 
 	return true;
 }
+
+bool
+png_trgt::can_write_frames_async()const
+{
+	return multi_image && writes_frame_per_file();
+}
+
+bool
+png_trgt::write_frame(const Surface &surface, int frame)
+{
+	int w=desc.get_w();
+	if(surface.get_w()!=w || surface.get_h()!=desc.get_h())
+		return false;
+
+	String newfilename(get_sequence_filename(filename, sequence_separator, frame));
+	FILE *frame_file=fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE);
+	if(!frame_file)
+		throw String(_("Unable to open file")) + " " + newfilename;
+
+	png_structp frame_png=png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, png_out_error, png_out_warning);
+	png_infop frame_info=frame_png ? png_create_info_struct(frame_png) : NULL;
+	if(!frame_png || !frame_info)
+	{
+		synfig::error("Unable to setup PNG struct");
+		png_destroy_write_struct(&frame_png, frame_info ? &frame_info : (png_infopp)NULL);
+		fclose(frame_file);
+		return false;
+	}
+
+	std::vector<unsigned char> row(get_row_size());
+
+	if (setjmp(png_jmpbuf(frame_png)))
+	{
+		png_destroy_write_struct(&frame_png, &frame_info);
+		fclose(frame_file);
+		return false;
+	}
+
+	png_init_io(frame_png,frame_file);
+	write_info(frame_png, frame_info);
+	for(int y = 0; y < surface.get_h(); ++y)
+	{
+		convert_row(&row.front(), surface[y]);
+		png_write_row(frame_png,&row.front());
+	}
+	png_write_end(frame_png,frame_info);
+	png_destroy_write_struct(&frame_png, &frame_info);
+
+	return fclose(frame_file) == 0;
+}
@@ -58,6 +58,17 @@ private:
 	unsigned char *buffer;
 	synfig::Color *color_buffer;
 	synfig::String sequence_separator;
+	int compression_level;
+	int compression_strategy;
+	int filter;
+	int bit_depth;
+
+	//! Applies compression settings and writes header of image,
+	//! png_ptr should be ready for longjmp
+	void write_info(png_structp png_ptr, png_infop info_ptr);
+	//! Converts row of colors into buffer of size get_row_size()
+	void convert_row(unsigned char *dest, const synfig::Color *src)const;
+	int get_row_size()const;
 public:
 	png_trgt(const char *filename, const synfig::TargetParam& /* params */);
 	virtual ~png_trgt();
@@ -68,6 +79,10 @@ public:
 
 	virtual synfig::Color * start_scanline(int scanline);
 	virtual bool end_scanline();
+
+	virtual bool writes_frame_per_file()const { return filename!="-"; }
+	virtual bool can_write_frames_async()const;
+	virtual bool write_frame(const synfig::Surface &surface, int frame);
 };
 
 /* === E N D =============================================================== */
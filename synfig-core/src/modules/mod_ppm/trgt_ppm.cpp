@@ -33,10 +33,13 @@
 #endif
 
 #include "trgt_ppm.h"
+#include <synfig/localization.h>
+#include <synfig/surface.h>
 #include <ETL/stringf>
 #include <cstdio>
 #include <algorithm>
 #include <functional>
+#include <vector>
 #endif
 
 /* === M A C R O S ========================================================= */
@@ -104,10 +107,7 @@ ppm::start_frame(synfig::ProgressCallback *callback)
 	}
 	else if(multi_image)
 	{
-		String newfilename(filename_sans_extension(filename) +
-						   sequence_separator +
-						   etl::strprintf("%04d",imagecount) +
-						   filename_extension(filename));
+		String newfilename(get_sequence_filename(filename, sequence_separator, imagecount));
 		file=SmartFILE(fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE));
 		if(callback)callback->task(newfilename);
 	}
@@ -152,3 +152,36 @@ ppm::end_scanline()
 
 	return true;
 }
+
+bool
+ppm::can_write_frames_async()const
+{
+	return multi_image && writes_frame_per_file();
+}
+
+bool
+ppm::write_frame(const Surface &surface, int frame)
+{
+	int w=desc.get_w(),h=desc.get_h();
+	if(surface.get_w()!=w || surface.get_h()!=h)
+		return false;
+
+	String newfilename(get_sequence_filename(filename, sequence_separator, frame));
+	SmartFILE frame_file(fopen(newfilename.c_str(),POPEN_BINARY_WRITE_TYPE));
+	if(!frame_file)
+		throw String(_("Unable to open file")) + " " + newfilename;
+
+	fprintf(frame_file.get(), "P6\n");
+	fprintf(frame_file.get(), "%d %d\n", w, h);
+	fprintf(frame_file.get(), "%d\n", 255);
+
+	std::vector<unsigned char> row(3*w);
+	for(int y = 0; y < h; ++y)
+	{
+		convert_color_format(&row.front(), surface[y], w, PF_RGB, gamma());
+		if(!fwrite(&row.front(),1,3*w,frame_file.get()))
+			return false;
+	}
+
+	return true;
+}
@@ -63,6 +63,10 @@ public:
 
 	virtual synfig::Color * start_scanline(int scanline);
 	virtual bool end_scanline();
+
+	virtual bool writes_frame_per_file()const { return filename!="-"; }
+	virtual bool can_write_frames_async()const;
+	virtual bool write_frame(const synfig::Surface &surface, int frame);
 };
 
 /* === E N D =============================================================== */
@@ -149,7 +149,6 @@ public:
 		Inner(): f(0.f), t(0.0), r(0.0) { }
 
 		bool operator== (const Inner &other) const { return r == other.r; }
-		Inner& operator= (const Inner &other) { return *this = other.r; }
 
 		Inner& operator= (const Real &other) { r = other; return *this; }
 		operator const Real&() const { return r; }
@@ -250,6 +249,8 @@ class TypeColor: public Type
 		description.name = "color";
 		description.local_name = N_("color");
 		register_all<Color, to_string>();
+		// Color defines copy constructor but still may be copied bytewise
+		register_construct(Operation::DefaultFuncs::construct<Color>);
 	}
 public:
 	static TypeColor instance;
@@ -944,6 +944,37 @@ Canvas::set_inline(LooseHandle parent)
 	set_parent(parent);
 }
 
+Canvas::Handle
+Canvas::snapshot(Time time, Real outline_grow)const
+{
+	Handle canvas(clone_snapshot(0));
+	canvas->set_time(time);
+	canvas->set_outline_grow(outline_grow);
+	return canvas;
+}
+
+Canvas::Handle
+Canvas::clone_snapshot(LooseHandle parent)const
+{
+	// snapshot is not registered in parent and don't handles signals of layers
+	Handle canvas(new Canvas(get_id()));
+	canvas->is_inline_ = is_inline() || parent;
+	canvas->rend_desc() = rend_desc();
+	canvas->parent_ = parent;
+	if (!parent)
+	{
+		canvas->identifier_ = get_identifier();
+		canvas->file_name_ = get_file_name();
+	}
+
+	for(const_iterator iter = begin(); iter != end(); ++iter)
+	{
+		Layer::Handle layer((*iter)->clone_snapshot(canvas));
+		if (layer) canvas->CanvasBase::insert(canvas->end(), layer);
+	}
+	return canvas;
+}
+
 Canvas::Handle
 Canvas::create_inline(Handle parent)
 {
@@ -637,6 +637,21 @@ public:
 	//! Clones (copies) the Canvas
 	Handle clone(const GUID& deriv_guid=GUID(), bool for_export=false)const;
 
+	//! Evaluates the Canvas at \a time into a detached snapshot
+	/*! The snapshot contains copies of the layers with parameters already
+	**	set for the given time, and snapshots of their sub-canvases.
+	**	Value nodes are shared with this Canvas and never modified, so
+	**	snapshots for different times can be built in parallel threads,
+	**	until this Canvas is not edited. Context of snapshot can be passed
+	**	to Context::build_rendering_task(). Snapshot should not be modified
+	**	and should not outlive this Canvas.
+	*/
+	Handle snapshot(Time time, Real outline_grow = 0.0)const;
+
+	//! Makes a snapshot structure without setting of time
+	//! \see snapshot(), Layer::clone_snapshot()
+	Handle clone_snapshot(LooseHandle parent)const;
+
 	//! Stores the external canvas by its file name and the Canvas handle
 	void register_external_canvas(String file, Handle canvas);
 
@@ -0,0 +1,287 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file colorblendspan.cpp
+**	\brief Vectorized blending of color spans
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <synfig/general.h>
+
+#include "colorblendspan.h"
+#include "colorblendingfunctions.h"
+
+#endif
+
+// Vector kernels rely on SSE scalar math of the reference implementation,
+// so x87 builds (32-bit x86 without SSE2) always use the scalar code
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SYNFIG_BLEND_SPAN_X86
+#include <immintrin.h>
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+namespace {
+
+typedef void (*Kernel)(Color *dest, const Color *src, int count, float amount);
+
+struct Kernels
+{
+	Kernel blend[Color::BLEND_END];
+	Kernel fill[Color::BLEND_END];
+	Kernels() { clear(); }
+	void clear()
+	{
+		for(int i = 0; i < Color::BLEND_END; ++i)
+			blend[i] = fill[i] = NULL;
+	}
+};
+
+#ifdef SYNFIG_BLEND_SPAN_X86
+
+namespace sse2 {
+
+//! One pixel per register
+struct V
+{
+	typedef __m128 type;
+	enum { pixels = 1 };
+
+	static inline type load(const Color *c) { return _mm_loadu_ps((const float*)c); }
+	static inline type load_fill(const Color &c) { return load(&c); }
+	static inline void store(Color *c, type x) { _mm_storeu_ps((float*)c, x); }
+	static inline type set1(float x) { return _mm_set1_ps(x); }
+	static inline type set_pixels(const float *x) { return _mm_set1_ps(x[0]); }
+
+	static inline type add(type a, type b) { return _mm_add_ps(a, b); }
+	static inline type sub(type a, type b) { return _mm_sub_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm_mul_ps(a, b); }
+	static inline type div(type a, type b) { return _mm_div_ps(a, b); }
+
+	static inline type alpha(type x) { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+	static inline type equal(type a, type b) { return _mm_cmpeq_ps(a, b); }
+	static inline type greater_epsilon(type x)
+		{ return _mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), x), _mm_set1_ps(COLOR_EPSILON)); }
+
+	static inline type select(type mask, type a, type b)
+		{ return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+	static inline type select_alpha(type c, type a)
+		{ return select(_mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0)), a, c); }
+};
+
+#include "colorblendspan_kernels.hpp"
+
+} // END of namespace sse2
+
+#ifdef __clang__
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace avx2 {
+
+//! Two pixels per register
+struct V
+{
+	typedef __m256 type;
+	enum { pixels = 2 };
+
+	static inline type load(const Color *c) { return _mm256_loadu_ps((const float*)c); }
+	static inline type load_fill(const Color &c)
+	{
+		__m128 x = _mm_loadu_ps((const float*)&c);
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(x), x, 1);
+	}
+	static inline void store(Color *c, type x) { _mm256_storeu_ps((float*)c, x); }
+	static inline type set1(float x) { return _mm256_set1_ps(x); }
+	static inline type set_pixels(const float *x)
+		{ return _mm256_set_ps(x[1], x[1], x[1], x[1], x[0], x[0], x[0], x[0]); }
+
+	static inline type add(type a, type b) { return _mm256_add_ps(a, b); }
+	static inline type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+	static inline type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+	static inline type div(type a, type b) { return _mm256_div_ps(a, b); }
+
+	static inline type alpha(type x) { return _mm256_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+	static inline type equal(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	static inline type greater_epsilon(type x)
+	{
+		return _mm256_cmp_ps(
+			_mm256_andnot_ps(_mm256_set1_ps(-0.f), x),
+			_mm256_set1_ps(COLOR_EPSILON),
+			_CMP_GT_OQ );
+	}
+
+	static inline type select(type mask, type a, type b)
+		{ return _mm256_blendv_ps(b, a, mask); }
+	static inline type select_alpha(type c, type a)
+		{ return _mm256_blend_ps(c, a, 0x88); }
+};
+
+#include "colorblendspan_kernels.hpp"
+
+} // END of namespace avx2
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif // SYNFIG_BLEND_SPAN_X86
+
+class Dispatcher
+{
+public:
+	ColorBlendSpan::Instructions supported;
+	ColorBlendSpan::Instructions instructions;
+	Kernels kernels;
+
+	Dispatcher(): supported(ColorBlendSpan::INSTRUCTIONS_SCALAR)
+	{
+		#ifdef SYNFIG_BLEND_SPAN_X86
+		__builtin_cpu_init();
+		supported = __builtin_cpu_supports("avx2") ? ColorBlendSpan::INSTRUCTIONS_AVX2
+				  : __builtin_cpu_supports("sse2") ? ColorBlendSpan::INSTRUCTIONS_SSE2
+				  : ColorBlendSpan::INSTRUCTIONS_SCALAR;
+		#endif
+
+		ColorBlendSpan::Instructions i = supported;
+		if (const char *s = getenv("SYNFIG_BLEND_INSTRUCTIONS"))
+		{
+			if (0 == strcmp(s, "scalar")) i = ColorBlendSpan::INSTRUCTIONS_SCALAR; else
+			if (0 == strcmp(s, "sse2"))   i = ColorBlendSpan::INSTRUCTIONS_SSE2; else
+			if (0 == strcmp(s, "avx2"))   i = ColorBlendSpan::INSTRUCTIONS_AVX2; else
+				synfig::warning("SYNFIG_BLEND_INSTRUCTIONS: unknown instruction set '%s'", s);
+		}
+		select(i);
+	}
+
+	ColorBlendSpan::Instructions select(ColorBlendSpan::Instructions i)
+	{
+		instructions = std::min(i, supported);
+		kernels.clear();
+		#ifdef SYNFIG_BLEND_SPAN_X86
+		switch(instructions)
+		{
+		case ColorBlendSpan::INSTRUCTIONS_AVX2: avx2::get_kernels(kernels); break;
+		case ColorBlendSpan::INSTRUCTIONS_SSE2: sse2::get_kernels(kernels); break;
+		default: break;
+		}
+		#endif
+		return instructions;
+	}
+};
+
+Dispatcher& dispatcher()
+{
+	static Dispatcher dispatcher;
+	return dispatcher;
+}
+
+} // END of anonymous namespace
+
+/* === M E T H O D S ======================================================= */
+
+ColorBlendSpan::Instructions
+ColorBlendSpan::get_supported_instructions()
+	{ return dispatcher().supported; }
+
+ColorBlendSpan::Instructions
+ColorBlendSpan::get_instructions()
+	{ return dispatcher().instructions; }
+
+ColorBlendSpan::Instructions
+ColorBlendSpan::set_instructions(Instructions instructions)
+	{ return dispatcher().select(instructions); }
+
+const char*
+ColorBlendSpan::get_instructions_name(Instructions instructions)
+{
+	switch(instructions)
+	{
+	case INSTRUCTIONS_AVX2: return "avx2";
+	case INSTRUCTIONS_SSE2: return "sse2";
+	default: break;
+	}
+	return "scalar";
+}
+
+bool
+ColorBlendSpan::is_accelerated(Color::BlendMethod method)
+{
+	return method >= 0
+		&& method < Color::BLEND_END
+		&& dispatcher().kernels.blend[method] != NULL;
+}
+
+void
+ColorBlendSpan::blend(
+	Color *dest,
+	const Color *src,
+	int count,
+	Color::value_type amount,
+	Color::BlendMethod method )
+{
+	assert(method >= 0 && method < Color::BLEND_END);
+	if (count <= 0 || fabsf(amount) <= COLOR_EPSILON) return;
+	if (Kernel kernel = dispatcher().kernels.blend[method])
+		{ kernel(dest, src, count, amount); return; }
+	for(Color *end = dest + count; dest != end; ++dest, ++src)
+		*dest = Color::blend(*src, *dest, amount, method);
+}
+
+void
+ColorBlendSpan::fill(
+	Color *dest,
+	const Color &src,
+	int count,
+	Color::value_type amount,
+	Color::BlendMethod method )
+{
+	assert(method >= 0 && method < Color::BLEND_END);
+	if (count <= 0 || fabsf(amount) <= COLOR_EPSILON) return;
+	if (Kernel kernel = dispatcher().kernels.fill[method])
+		{ kernel(dest, &src, count, amount); return; }
+	for(Color *end = dest + count; dest != end; ++dest)
+		*dest = Color::blend(src, *dest, amount, method);
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,93 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file colorblendspan.h
+**	\brief Vectorized blending of color spans
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_COLORBLENDSPAN_H
+#define __SYNFIG_COLORBLENDSPAN_H
+
+/* === H E A D E R S ======================================================= */
+
+#include "color.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+
+/*!	\class ColorBlendSpan
+**	\brief Blends whole rows of pixels at once
+**
+**	Results are bit-exact with Color::blend() called for every pixel
+**	of the span: the vector kernels perform the same float operations
+**	in the same order as blendfunc_* templates, just for several
+**	channels (and pixels) at once.
+**	Kernels are selected at runtime depending on the CPU features,
+**	set environment variable SYNFIG_BLEND_INSTRUCTIONS to "scalar",
+**	"sse2" or "avx2" to limit them.
+*/
+class ColorBlendSpan
+{
+public:
+	enum Instructions
+	{
+		INSTRUCTIONS_SCALAR = 0,
+		INSTRUCTIONS_SSE2   = 1,
+		INSTRUCTIONS_AVX2   = 2
+	};
+
+	//! Best instruction set supported by this CPU and build
+	static Instructions get_supported_instructions();
+	//! Instruction set which is currently used
+	static Instructions get_instructions();
+	//! Limits used instruction set, returns actually selected one
+	static Instructions set_instructions(Instructions instructions);
+	static const char* get_instructions_name(Instructions instructions);
+
+	//! Returns true when blend method has vector kernel for current instruction set
+	static bool is_accelerated(Color::BlendMethod method);
+
+	//! dest[i] = Color::blend(src[i], dest[i], amount, method)
+	static void blend(
+		Color *dest,
+		const Color *src,
+		int count,
+		Color::value_type amount,
+		Color::BlendMethod method );
+
+	//! dest[i] = Color::blend(src, dest[i], amount, method)
+	static void fill(
+		Color *dest,
+		const Color &src,
+		int count,
+		Color::value_type amount,
+		Color::BlendMethod method );
+}; // END of class ColorBlendSpan
+
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
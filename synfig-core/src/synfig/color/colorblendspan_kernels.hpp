@@ -0,0 +1,241 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file colorblendspan_kernels.hpp
+**	\brief Blend kernels for ColorBlendSpan
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+// This file has no include guards, it is included by colorblendspan.cpp
+// once for every instruction set, inside of namespace which already
+// defines the vector type V. Every kernel repeats the float operations
+// of the corresponding blendfunc_* template from colorblendingfunctions.h
+// in the same order, so results are bit-exact.
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+typedef V::type vec;
+
+struct Consts
+{
+	vec one;
+	vec zero;
+	vec transparent;
+
+	Consts():
+		one(V::set1(1.f)),
+		zero(V::set1(0.f)),
+		transparent(V::load_fill(Color::alpha()))
+	{ }
+};
+
+//! ~a
+static inline vec invert(const Consts &k, vec a)
+	{ return V::select_alpha(V::sub(k.one, a), a); }
+
+//! blendfunc_COMPOSITE
+static inline vec composite(const Consts &k, vec src, vec dest, vec amount)
+{
+	vec a_src = V::mul(V::alpha(src), amount);
+	vec a_dest = V::alpha(dest);
+	vec one_minus_a_src = V::sub(k.one, a_src);
+
+	vec c = V::add(V::mul(src, a_src), V::mul(V::mul(dest, a_dest), one_minus_a_src));
+	a_dest = V::add(a_src, V::mul(a_dest, one_minus_a_src));
+	c = V::select_alpha(V::mul(c, V::div(k.one, a_dest)), a_dest);
+	return V::select(V::greater_epsilon(a_dest), c, k.transparent);
+}
+
+//! blendfunc_STRAIGHT
+static inline vec straight(const Consts &k, vec src, vec bg, vec amount)
+{
+	vec a_src = V::alpha(src);
+	vec a_bg = V::alpha(bg);
+	vec a_out = V::add(V::mul(V::sub(a_src, a_bg), amount), a_bg);
+
+	vec bg_premult = V::mul(bg, a_bg);
+	vec c = V::add(V::mul(V::sub(V::mul(src, a_src), bg_premult), amount), bg_premult);
+	c = V::select_alpha(V::mul(c, V::div(k.one, a_out)), a_out);
+	return V::select(V::greater_epsilon(a_out), c, k.transparent);
+}
+
+//! blendfunc_ONTO
+static inline vec onto(const Consts &k, vec a, vec b, vec amount)
+	{ return V::select_alpha(composite(k, a, V::select_alpha(b, k.one), amount), b); }
+
+struct OpComposite
+{
+	static const Color::BlendMethod method = Color::BLEND_COMPOSITE;
+	Consts k;
+	vec amount;
+	explicit OpComposite(float amount): amount(V::set1(amount)) { }
+	vec operator() (vec a, vec b) const
+		{ return composite(k, a, b, amount); }
+};
+
+struct OpStraight
+{
+	static const Color::BlendMethod method = Color::BLEND_STRAIGHT;
+	Consts k;
+	vec amount;
+	explicit OpStraight(float amount): amount(V::set1(amount)) { }
+	vec operator() (vec a, vec b) const
+		{ return straight(k, a, b, amount); }
+};
+
+struct OpOnto
+{
+	static const Color::BlendMethod method = Color::BLEND_ONTO;
+	Consts k;
+	vec amount;
+	explicit OpOnto(float amount): amount(V::set1(amount)) { }
+	vec operator() (vec a, vec b) const
+		{ return onto(k, a, b, amount); }
+};
+
+struct OpBehind
+{
+	static const Color::BlendMethod method = Color::BLEND_BEHIND;
+	Consts k;
+	vec amount;
+	vec empty_alpha;
+	explicit OpBehind(float amount):
+		amount(V::set1(amount)),
+		empty_alpha(V::set1(COLOR_EPSILON*amount)) { }
+	vec operator() (vec a, vec b) const
+	{
+		vec a_alpha = V::alpha(a);
+		a_alpha = V::select(V::equal(a_alpha, k.zero), empty_alpha, V::mul(a_alpha, amount));
+		return composite(k, b, V::select_alpha(a, a_alpha), k.one);
+	}
+};
+
+struct OpAdd
+{
+	static const Color::BlendMethod method = Color::BLEND_ADD;
+	float amount;
+	explicit OpAdd(float amount): amount(amount) { }
+	vec operator() (vec a, vec b) const
+	{
+		// coefficients are calculated in double precision,
+		// so do it per pixel exactly as blendfunc_ADD does
+		Color ca[V::pixels], cb[V::pixels];
+		float ka[V::pixels], kb[V::pixels], alpha[V::pixels];
+		V::store(ca, a);
+		V::store(cb, b);
+		for(int i = 0; i < V::pixels; ++i)
+		{
+			float ba(cb[i].get_a());
+			float aa(ca[i].get_a()*amount);
+			alpha[i] = std::max(0.f, std::min(1.f, ba + aa));
+			const float k = fabs(alpha[i]) > 1e-8 ? 1.0/alpha[i] : 0.0;
+			aa *= k; ba *= k;
+			ka[i] = aa; kb[i] = ba;
+		}
+		return V::select_alpha(
+			V::add(V::mul(b, V::set_pixels(kb)), V::mul(a, V::set_pixels(ka))),
+			V::set_pixels(alpha) );
+	}
+};
+
+struct OpMultiply
+{
+	static const Color::BlendMethod method = Color::BLEND_MULTIPLY;
+	Consts k;
+	bool inverse;
+	vec amount;
+	explicit OpMultiply(float amount):
+		inverse(amount < 0), amount(V::set1(inverse ? -amount : amount)) { }
+	vec operator() (vec a, vec b) const
+	{
+		if (inverse) a = invert(k, a);
+		vec amount_a = V::mul(amount, V::alpha(a));
+		return V::select_alpha(V::add(V::mul(V::sub(V::mul(b, a), b), amount_a), b), b);
+	}
+};
+
+struct OpScreen
+{
+	static const Color::BlendMethod method = Color::BLEND_SCREEN;
+	Consts k;
+	bool inverse;
+	vec amount;
+	explicit OpScreen(float amount):
+		inverse(amount < 0), amount(V::set1(inverse ? -amount : amount)) { }
+	vec operator() (vec a, vec b) const
+	{
+		if (inverse) a = invert(k, a);
+		a = V::select_alpha(V::sub(k.one, V::mul(V::sub(k.one, a), V::sub(k.one, b))), a);
+		return onto(k, a, b, amount);
+	}
+};
+
+struct OpAlphaOver
+{
+	static const Color::BlendMethod method = Color::BLEND_ALPHA_OVER;
+	Consts k;
+	vec amount;
+	explicit OpAlphaOver(float amount): amount(V::set1(amount)) { }
+	vec operator() (vec a, vec b) const
+	{
+		vec rm = V::select_alpha(b, V::mul(V::sub(k.one, V::alpha(a)), V::alpha(b)));
+		return straight(k, rm, b, amount);
+	}
+};
+
+/* === P R O C E D U R E S ================================================= */
+
+template<typename Op, bool fill>
+static void
+kernel(Color *dest, const Color *src, int count, float amount)
+{
+	const Op op(amount);
+	const vec src_fill = fill ? V::load_fill(*src) : vec();
+	Color *end = dest + (count - count%V::pixels);
+	for(; dest != end; dest += V::pixels)
+	{
+		vec a = src_fill;
+		if (!fill) { a = V::load(src); src += V::pixels; }
+		V::store(dest, op(a, V::load(dest)));
+	}
+	for(int i = count%V::pixels; i > 0; --i, ++dest)
+	{
+		*dest = Color::blend(*src, *dest, amount, Op::method);
+		if (!fill) ++src;
+	}
+}
+
+template<typename Op>
+static inline void
+get_kernels(Kernels &kernels)
+{
+	kernels.blend[Op::method] = &kernel<Op, false>;
+	kernels.fill[Op::method] = &kernel<Op, true>;
+}
+
+static void
+get_kernels(Kernels &kernels)
+{
+	get_kernels<OpComposite>(kernels);
+	get_kernels<OpStraight>(kernels);
+	get_kernels<OpOnto>(kernels);
+	get_kernels<OpBehind>(kernels);
+	get_kernels<OpAdd>(kernels);
+	get_kernels<OpMultiply>(kernels);
+	get_kernels<OpScreen>(kernels);
+	get_kernels<OpAlphaOver>(kernels);
+}
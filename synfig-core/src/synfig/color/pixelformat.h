@@ -193,10 +193,80 @@ inline unsigned char * Color2PixelFormat(const Color &color, const PixelFormat &
     return out;
 }
 
+//! Clamps channel to [0, 1] like Color::clamped() does, NaN becomes nan_value
+inline float clamp_color_channel(float x, float nan_value)
+    { return x >= 0.f ? (x <= 1.f ? x : 1.f) : (x < 0.f ? 0.f : nan_value); }
+
+//! Span version of Color2PixelFormat() for 8-bit RGB(A) and BGR(A) formats.
+//! Colors are processed by blocks: first pass is branchless arithmetic
+//! which compiler turns into SIMD code, second pass makes gamma table lookups.
+template<bool bgr, bool alpha>
+inline void convert_color_format_span(unsigned char *dest, const Color *src,
+                                      int w, const Gamma &gamma)
+{
+    const int block_size = 64;
+    int r[block_size], g[block_size], b[block_size];
+    unsigned char a[block_size];
+
+    while(w > 0)
+    {
+        const int count = w < block_size ? w : block_size;
+
+        for(int i = 0; i < count; ++i)
+        {
+            r[i] = (int)(clamp_color_channel(src[i].get_r(), 0.5f)*65535.0f);
+            g[i] = (int)(clamp_color_channel(src[i].get_g(), 0.5f)*65535.0f);
+            b[i] = (int)(clamp_color_channel(src[i].get_b(), 0.5f)*65535.0f);
+            if (alpha)
+                a[i] = (unsigned char)(int)(clamp_color_channel(src[i].get_a(), 1.f)*255.f);
+        }
+
+        for(int i = 0; i < count; ++i)
+        {
+            // tables are swapped for BGR in the same way as in Color2PixelFormat()
+            if (bgr)
+            {
+                *dest++ = gamma.r_U16_to_U8(b[i]);
+                *dest++ = gamma.g_U16_to_U8(g[i]);
+                *dest++ = gamma.b_U16_to_U8(r[i]);
+            }
+            else
+            {
+                *dest++ = gamma.r_U16_to_U8(r[i]);
+                *dest++ = gamma.g_U16_to_U8(g[i]);
+                *dest++ = gamma.b_U16_to_U8(b[i]);
+            }
+            if (alpha)
+                *dest++ = a[i];
+        }
+
+        src += count;
+        w -= count;
+    }
+}
+
 inline void convert_color_format(unsigned char *dest, const Color *src,
                                  int w, PixelFormat pf,const Gamma &gamma)
 {
     assert(w >= 0);
+    switch((int)pf)
+    {
+    case PF_RGB:
+        convert_color_format_span<false, false>(dest, src, w, gamma);
+        return;
+    case (int)PF_RGB|(int)PF_A:
+        convert_color_format_span<false, true>(dest, src, w, gamma);
+        return;
+    case PF_BGR:
+        convert_color_format_span<true, false>(dest, src, w, gamma);
+        return;
+    case (int)PF_BGR|(int)PF_A:
+        convert_color_format_span<true, true>(dest, src, w, gamma);
+        return;
+    default:
+        break;
+    }
+
     while(w--)
     {
         dest = Color2PixelFormat((*(src++)).clamped(),
@@ -204,6 +274,44 @@ inline void convert_color_format(unsigned char *dest, const Color *src,
     }
 }
 
+//! Converts colors to 16 bits per channel, supports RGB(A) and BGR(A) formats only.
+//! Gamma is applied without tables, so precision is not limited by 8-bit tables.
+//! Values are stored in native byte order.
+inline void convert_color_format_u16(unsigned short *dest, const Color *src,
+                                     int w, PixelFormat pf, const Gamma &gamma)
+{
+    assert(w >= 0);
+    assert(!FLAGS(pf, PF_GRAY) && !FLAGS(pf, PF_Z) && !FLAGS(pf, PF_A_START));
+    const bool bgr = FLAGS(pf, PF_BGR);
+    const bool alpha = FLAGS(pf, PF_A);
+    const bool alpha_inv = FLAGS(pf, PF_A_INV);
+    const bool linear = gamma.get_gamma_r() == 1.f
+                     && gamma.get_gamma_g() == 1.f
+                     && gamma.get_gamma_b() == 1.f
+                     && gamma.get_black_level() == 0.f;
+
+    for(const Color *end = src + w; src < end; ++src)
+    {
+        float r = clamp_color_channel(src->get_r(), 0.5f);
+        float g = clamp_color_channel(src->get_g(), 0.5f);
+        float b = clamp_color_channel(src->get_b(), 0.5f);
+        if (!linear)
+        {
+            r = gamma.r_F32_to_F32(r);
+            g = gamma.g_F32_to_F32(g);
+            b = gamma.b_F32_to_F32(b);
+        }
+        *dest++ = (unsigned short)(int)((bgr ? b : r)*65535.f + 0.5f);
+        *dest++ = (unsigned short)(int)(g*65535.f + 0.5f);
+        *dest++ = (unsigned short)(int)((bgr ? r : b)*65535.f + 0.5f);
+        if (alpha)
+        {
+            float a = clamp_color_channel(src->get_a(), 1.f);
+            *dest++ = (unsigned short)(int)((alpha_inv ? 1.f - a : a)*65535.f + 0.5f);
+        }
+    }
+}
+
 inline const unsigned char * PixelFormat2Color(Color &color,
                                                const PixelFormat &pf,
                                                const unsigned char *out)
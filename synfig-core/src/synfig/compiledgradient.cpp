@@ -0,0 +1,259 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file compiledgradient.cpp
+**	\brief Precomputed lookup table of gradient
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+
+#include "compiledgradient.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+//! Same as COLOR_EPSILON used by straight blending of gradient colors
+static const Real epsilon = 0.000001;
+
+/* === P R O C E D U R E S ================================================= */
+
+static inline void
+premult(const Color &c, Real *out)
+{
+	Real a = c.get_a();
+	out[0] = c.get_r()*a;
+	out[1] = c.get_g()*a;
+	out[2] = c.get_b()*a;
+	out[3] = a;
+}
+
+static inline Color
+demult(const Real *c)
+{
+	if (std::fabs(c[3]) <= epsilon)
+		return Color::alpha();
+	Real k = 1.0/c[3];
+	return Color(c[0]*k, c[1]*k, c[2]*k, c[3]);
+}
+
+/* === M E T H O D S ======================================================= */
+
+int
+CompiledGradient::Table::find_segment(int cell, Real x) const
+{
+	int seg = segments[cell];
+	const int last = (int)cpoints.size() - 2;
+	while(seg < last && cpoints[seg + 1].pos <= x) ++seg;
+	return seg;
+}
+
+void
+CompiledGradient::Table::exact(int cell, Real x, Real *color, Real *integral) const
+{
+	int seg = find_segment(cell, x);
+	Real x0 = cpoints[seg].pos;
+	Real w = cpoints[seg + 1].pos - x0;
+	Real l = w > 0.0 ? (x - x0)/w : 0.0;
+	const Real *p = &points[4*seg];
+	const Real *s = &point_sums[4*seg];
+	for(int j = 0; j < 4; ++j)
+	{
+		Real c = p[j] + (p[j+4] - p[j])*l;
+		if (color) color[j] = c;
+		if (integral) integral[j] = s[j] + 0.5*(p[j] + c)*(x - x0);
+	}
+}
+
+inline void
+CompiledGradient::Table::integral(Real x, Real *out) const
+{
+	if (x <= begin || step <= 0.0)
+	{
+		const Real *c = x <= begin ? front_premult : back_premult;
+		for(int j = 0; j < 4; ++j) out[j] = (x - begin)*c[j];
+		return;
+	}
+	if (x >= end)
+	{
+		const Real *s = &sums[4*size];
+		for(int j = 0; j < 4; ++j) out[j] = s[j] + (x - end)*back_premult[j];
+		return;
+	}
+
+	Real f = (x - begin)*k;
+	int i = std::max(0, std::min(size - 1, (int)f));
+	if (segments[i] != segments[i+1])
+		{ exact(i, x, NULL, out); return; }
+
+	Real l = f - i;
+	Real dx = l*step;
+	const Real *c = &colors[4*i];
+	const Real *s = &sums[4*i];
+	for(int j = 0; j < 4; ++j)
+		out[j] = s[j] + (c[j] + 0.5*l*(c[j+4] - c[j]))*dx;
+}
+
+Color
+CompiledGradient::Table::color(Real x) const
+{
+	if (x <= begin || std::isnan(x)) return front;
+	if (x >= end) return back;
+
+	Real f = (x - begin)*k;
+	int i = std::max(0, std::min(size - 1, (int)f));
+	Real out[4];
+	if (segments[i] != segments[i+1])
+	{
+		exact(i, x, out, NULL);
+		return demult(out);
+	}
+
+	Real l = f - i;
+	const Real *c = &colors[4*i];
+	for(int j = 0; j < 4; ++j)
+		out[j] = c[j] + (c[j+4] - c[j])*l;
+	return demult(out);
+}
+
+Color
+CompiledGradient::Table::average(Real x0, Real x1) const
+{
+	if (x1 <= begin || std::isnan(x0) || std::isnan(x1)) return front;
+	if (x0 >= end) return back;
+
+	Real i0[4], i1[4];
+	integral(x0, i0);
+	integral(x1, i1);
+
+	// width of region is cancelled out by demultiplication of color
+	Real a = i1[3] - i0[3];
+	Real width = x1 - x0;
+	if (std::fabs(a) <= epsilon*width)
+		return Color::alpha();
+	Real k = 1.0/a;
+	return Color((i1[0] - i0[0])*k, (i1[1] - i0[1])*k, (i1[2] - i0[2])*k, a/width);
+}
+
+CompiledGradient::CompiledGradient(const Gradient &gradient, Real min_supersample)
+{
+	if (gradient.empty()) return;
+
+	table = new Table();
+	Table &t = *table;
+	t.cpoints.assign(gradient.begin(), gradient.end());
+
+	const Gradient::CPointList &cpoints = t.cpoints;
+	const int count = (int)cpoints.size();
+	t.begin = cpoints.front().pos;
+	t.end   = cpoints.back().pos;
+	t.front = cpoints.front().color;
+	t.back  = cpoints.back().color;
+	premult(t.front, t.front_premult);
+	premult(t.back, t.back_premult);
+
+	t.step = 0.0;
+	t.k = 0.0;
+	t.size = 0;
+	if (count < 2 || !(t.end > t.begin))
+		return;
+
+	// choose count of cells, power of two to avoid frequent rebuilding
+	Real range = t.end - t.begin;
+	Real cells = min_supersample > 0.0 ? std::ceil(2.0*range/min_supersample) : (Real)DEFAULT_SIZE;
+	t.size = MIN_SIZE;
+	while(t.size < MAX_SIZE && t.size < cells) t.size *= 2;
+	t.step = range/t.size;
+	t.k = t.size/range;
+
+	// premultiplied colors of control points and integrals from the beginning to them
+	t.points.resize(4*count);
+	t.point_sums.resize(4*count);
+	for(int i = 0; i < count; ++i)
+		premult(cpoints[i].color, &t.points[4*i]);
+	for(int j = 0; j < 4; ++j) t.point_sums[j] = 0.0;
+	for(int i = 1; i < count; ++i)
+	{
+		Real w = cpoints[i].pos - cpoints[i-1].pos;
+		for(int j = 0; j < 4; ++j)
+			t.point_sums[4*i + j] = t.point_sums[4*(i-1) + j]
+			                      + 0.5*(t.points[4*(i-1) + j] + t.points[4*i + j])*w;
+	}
+
+	// sample the table, colors are right-continuous like in Gradient
+	t.colors.resize(4*(t.size + 1));
+	t.sums.resize(4*(t.size + 1));
+	t.segments.resize(t.size + 1);
+	t.segments[0] = 0;
+	for(int i = 0; i < t.size; ++i)
+	{
+		Real x = t.begin + i*t.step;
+		t.segments[i] = t.find_segment(i > 0 ? i - 1 : 0, x);
+		t.exact(i, x, &t.colors[4*i], &t.sums[4*i]);
+	}
+	t.segments[t.size] = count - 2;
+	for(int j = 0; j < 4; ++j)
+	{
+		t.colors[4*t.size + j] = t.points[4*(count - 1) + j];
+		t.sums[4*t.size + j] = t.point_sums[4*(count - 1) + j];
+	}
+}
+
+bool
+CompiledGradient::is_compiled_from(const Gradient &gradient, Real min_supersample) const
+{
+	if (!table) return gradient.empty();
+	if (table->cpoints.size() != gradient.size()) return false;
+
+	Gradient::const_iterator j = gradient.begin();
+	for(Gradient::CPointList::const_iterator i = table->cpoints.begin(); i != table->cpoints.end(); ++i, ++j)
+		if (i->pos != j->pos || !(i->color == j->color))
+			return false;
+
+	return min_supersample <= 0.0
+	    || table->step <= 0.5*min_supersample
+	    || table->size >= MAX_SIZE
+	    || table->step <= 0.0;
+}
+
+CompiledGradient
+CompiledGradientCache::get(const Gradient &gradient, Real min_supersample) const
+{
+	Mutex::Lock lock(mutex);
+	if (!compiled.is_compiled_from(gradient, min_supersample))
+		compiled = CompiledGradient(gradient, min_supersample);
+	return compiled;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,136 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file compiledgradient.h
+**	\brief Precomputed lookup table of gradient
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_COMPILEDGRADIENT_H
+#define __SYNFIG_COMPILEDGRADIENT_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <vector>
+
+#include <ETL/handle>
+
+#include "gradient.h"
+#include "mutex.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+
+/*!	\class CompiledGradient
+**	\brief Baked gradient for fast per-pixel sampling
+**
+**	Gradient is sampled into the table of premultiplied colors with
+**	uniform step, and the table of integrals of premultiplied color.
+**	So the color averaged over the supersample region of any width
+**	takes constant time: (I(x + s/2) - I(x - s/2))/s.
+**	Premultiplied color is linear between control points, so the table
+**	is exact for cells without control points inside, other cells are
+**	evaluated from the control points. Smaller step gives less such cells.
+**	Copies of CompiledGradient share the same immutable tables.
+*/
+class CompiledGradient
+{
+public:
+	enum {
+		MIN_SIZE     = 256,   //!< Minimal count of table cells
+		DEFAULT_SIZE = 4096,  //!< Count of cells if supersample width is unknown
+		MAX_SIZE     = 65536  //!< Maximal count of cells
+	};
+
+private:
+	class Table: public etl::shared_object
+	{
+	public:
+		Gradient::CPointList cpoints;
+		Real begin, end, step, k;
+		int size;
+		Color front, back;
+		Real front_premult[4], back_premult[4];
+		std::vector<Real> points;     //!< premultiplied colors of control points
+		std::vector<Real> point_sums; //!< integrals of premultiplied color from begin to control points
+		std::vector<Real> colors;     //!< premultiplied colors at begin + i*step
+		std::vector<Real> sums;       //!< integrals of premultiplied color from begin to begin + i*step
+		std::vector<int> segments;    //!< index of control point before begin + i*step
+
+		int find_segment(int cell, Real x) const;
+		void exact(int cell, Real x, Real *color, Real *integral) const;
+		void integral(Real x, Real *out) const;
+		Color color(Real x) const;
+		Color average(Real x0, Real x1) const;
+	};
+
+	etl::handle<Table> table;
+
+public:
+	CompiledGradient() { }
+
+	//! Bakes gradient, \a min_supersample is the smallest supersample width which will be used
+	explicit CompiledGradient(const Gradient &gradient, Real min_supersample = 0.0);
+
+	bool empty() const { return !table; }
+
+	//! Table step, zero for gradients without color changes
+	Real get_step() const { return table ? table->step : 0.0; }
+
+	//! Returns true when table was baked from the same control points with small enough step
+	bool is_compiled_from(const Gradient &gradient, Real min_supersample = 0.0) const;
+
+	//! Same as Gradient::operator()
+	Color operator()(Real x, Real supersample = 0.0) const
+	{
+		if (!table) return Color(0,0,0,0);
+		if (supersample < 0) supersample = -supersample;
+		if (supersample > 2.0) supersample = 2.0;
+		return supersample <= table->step || table->step <= 0.0
+		     ? table->color(x)
+		     : table->average(x - 0.5*supersample, x + 0.5*supersample);
+	}
+}; // END of class CompiledGradient
+
+/*!	\class CompiledGradientCache
+**	\brief Keeps compiled gradient of a layer between renders
+**
+**	Gradient is recompiled only when its control points are changed
+**	or when the finer table is required.
+*/
+class CompiledGradientCache
+{
+private:
+	mutable Mutex mutex;
+	mutable CompiledGradient compiled;
+
+public:
+	CompiledGradient get(const Gradient &gradient, Real min_supersample = 0.0) const;
+}; // END of class CompiledGradientCache
+
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
@@ -92,6 +92,24 @@ _print_profile_report()
 
 /* === M E T H O D S ======================================================= */
 
+void
+ContextParams::set_pixel_size(const RendDesc &renddesc)
+{
+	pixel_size = std::min(fabs(renddesc.get_pw()), fabs(renddesc.get_ph()));
+	if (!(pixel_size > real_low_precision<Real>()))
+		pixel_size = 0.0;
+}
+
+ContextParams
+ContextParams::transformed(const Matrix &matrix)const
+{
+	ContextParams params(*this);
+	// transformed vectors are never longer than original ones multiplied by this scale
+	Real scale = sqrt( matrix.m00*matrix.m00 + matrix.m01*matrix.m01
+	                 + matrix.m10*matrix.m10 + matrix.m11*matrix.m11 );
+	params.pixel_size = scale > real_low_precision<Real>() ? pixel_size/scale : 0.0;
+	return params;
+}
 
 void
 IndependentContext::set_time(Time time, bool force)const
@@ -99,8 +117,13 @@ IndependentContext::set_time(Time time, bool force)const
 	IndependentContext context(*this);
 	while(*context)
 	{
-		if ( (*context)->active() &&
-		    (force || !(*context)->get_time_mark().is_equal(time)) )
+		// layers which are the same at any time are not updated again
+		// until they are changed, see Layer::on_changed()
+		if ( (*context)->active()
+		  && ( force
+		    || ( !(*context)->get_time_mark().is_equal(time)
+		      && ( (*context)->get_time_mark().is_equal(Time::end())
+		        || !(*context)->is_time_invariant() ))))
 			break;
 		++context;
 	}
@@ -29,6 +29,7 @@
 /* === H E A D E R S ======================================================= */
 
 #include "canvas.h"
+#include "matrix.h"
 #include "rect.h"
 #include "renddesc.h"
 #include "surface.h"
@@ -94,13 +95,21 @@ public:
 	Real z_range_depth;
 	//! Layers with z_Depth inside transition are partially visibile
 	Real z_range_blur;
+	//! Size of pixel of render target in units of the context, zero if unknown
+	Real pixel_size;
 
 	explicit ContextParams(bool render_excluded_contexts = false):
 	render_excluded_contexts(render_excluded_contexts),
 	z_range(false),
 	z_range_position(0.0),
 	z_range_depth(0.0),
-	z_range_blur(0.0){ }
+	z_range_blur(0.0),
+	pixel_size(0.0){ }
+
+	//! Sets pixel size of render target described by \a renddesc
+	void set_pixel_size(const RendDesc &renddesc);
+	//! Returns parameters for the context which will be transformed by \a matrix
+	ContextParams transformed(const Matrix &matrix)const;
 };
 
 /*!	\class Context
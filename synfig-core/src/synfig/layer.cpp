@@ -160,9 +160,13 @@ Layer::Layer():
 	active_(true),
 	optimized_(false),
 	exclude_from_rendering_(false),
+	dynamic_param_bindings_valid_(false),
+	binding_param_(NULL),
 	param_z_depth(Real(0.0f)),
 	time_mark(Time::end()),
-	outline_grow_mark(0.0)
+	outline_grow_mark(0.0),
+	time_invariant_valid_(false),
+	time_invariant_(false)
 {
 	_LayerCounter::counter++;
 	SET_INTERPOLATION_DEFAULTS();
@@ -311,6 +315,7 @@ Layer::connect_dynamic_param(const String& param, etl::loose_handle<ValueNode> v
 
 	String param_noref = param;
 	dynamic_param_list_[param]=ValueNode::Handle(value_node);
+	dynamic_param_bindings_valid_ = false;
 
 	if (previous)
 	{
@@ -344,6 +349,7 @@ Layer::disconnect_dynamic_param(const String& param)
 
 	ValueNode::Handle previous(i->second);
 	dynamic_param_list_.erase(i);
+	dynamic_param_bindings_valid_ = false;
 
 	if(previous)
 	{
@@ -373,6 +379,7 @@ Layer::on_changed()
 		printf("%s:%d Layer::on_changed()\n", __FILE__, __LINE__);
 
 	clear_time_mark();
+	time_invariant_valid_ = false;
 	Node::on_changed();
 }
 
@@ -441,6 +448,40 @@ Layer::simple_clone()const
 	return ret;
 }
 
+Layer::Handle
+Layer::clone_snapshot(etl::loose_handle<Canvas> canvas)const
+{
+	if(!book().count(get_name())) return 0;
+	Handle ret = create(get_name()).get();
+
+	ret->group_=group_;
+	ret->set_description(get_description());
+	ret->set_active(active());
+	ret->set_optimized(optimized());
+	ret->set_exclude_from_rendering(get_exclude_from_rendering());
+	ret->snapshot_source_ = snapshot_source_ ? snapshot_source_ : const_cast<Layer*>(this);
+
+	// Copy current values of parameters,
+	// sub-canvases should be evaluated separately, so make snapshots of them
+	ParamList param_list(get_param_list());
+	for(ParamList::const_iterator iter(param_list.begin()); iter != param_list.end(); ++iter)
+	{
+		if(iter->second.get_type()==type_canvas)
+		{
+			Canvas::Handle sub_canvas(iter->second.get(Canvas::Handle()));
+			if(sub_canvas)
+			{
+				ret->set_param(iter->first, ValueBase(sub_canvas->clone_snapshot(canvas)));
+				continue;
+			}
+		}
+		ret->set_param(iter->first, iter->second);
+	}
+
+	ret->set_canvas(canvas);
+	return ret;
+}
+
 Layer::Handle
 Layer::clone(Canvas::LooseHandle canvas, const GUID& deriv_guid) const
 {
@@ -523,6 +564,32 @@ Layer::reads_context() const
 	return false;
 }
 
+bool
+Layer::is_render_cacheable() const
+{
+	return true;
+}
+
+bool
+Layer::uses_time() const
+{
+	return !is_render_cacheable();
+}
+
+bool
+Layer::is_time_invariant() const
+{
+	if (!time_invariant_valid_)
+	{
+		time_invariant_ = !uses_time();
+		for(DynamicParamList::const_iterator i = dynamic_param_list().begin(); time_invariant_ && i != dynamic_param_list().end(); ++i)
+			if (!i->second->is_time_invariant())
+				time_invariant_ = false;
+		time_invariant_valid_ = true;
+	}
+	return time_invariant_;
+}
+
 Rect
 Layer::get_full_bounding_rect(Context context)const
 {
@@ -595,13 +662,56 @@ Layer::reset_version()
 void
 Layer::set_time(IndependentContext context, Time time)const
 {
-	Layer::ParamList params;
-	Layer::DynamicParamList::const_iterator iter;
-	// For each parameter of the layer sets the time by the operator()(time)
-	for(iter=dynamic_param_list().begin();iter!=dynamic_param_list().end();iter++)
-		params[iter->first]=(*iter->second)(time);
-	// Sets the modified parameter list to the current context layer
-	const_cast<Layer*>(this)->set_param_list(params);
+	if (snapshot_source_)
+	{
+		Layer::ParamList params;
+		Layer::DynamicParamList::const_iterator iter;
+		// For each parameter of the layer sets the time by the operator()(time)
+		for(iter=dynamic_param_list().begin();iter!=dynamic_param_list().end();iter++)
+		{
+			// snapshot copy keeps own snapshots of sub-canvases (see clone_snapshot())
+			if(iter->second->get_type()==type_canvas)
+				continue;
+			params[iter->first]=(*iter->second)(time);
+		}
+		// Sets the modified parameter list to the current context layer
+		const_cast<Layer*>(this)->set_param_list(params);
+	}
+	else
+	{
+		if (!dynamic_param_bindings_valid_)
+		{
+			dynamic_param_bindings_.clear();
+			dynamic_param_bindings_.reserve(dynamic_param_list_.size());
+			for(DynamicParamList::const_iterator i = dynamic_param_list_.begin(); i != dynamic_param_list_.end(); ++i)
+			{
+				DynamicParamBinding binding;
+				binding.iter = i;
+				binding.slot = NULL;
+				binding.bound = false;
+				dynamic_param_bindings_.push_back(binding);
+			}
+			dynamic_param_bindings_valid_ = true;
+		}
+
+		Layer *layer = const_cast<Layer*>(this);
+		for(std::vector<DynamicParamBinding>::iterator i = dynamic_param_bindings_.begin(); i != dynamic_param_bindings_.end(); ++i)
+		{
+			ValueBase value = (*i->iter->second)(time);
+			if (i->slot && i->slot->get_type() == value.get_type())
+			{
+				// the same as IMPORT_VALUE() does for dynamic parameter
+				*i->slot = value;
+				layer->on_static_param_changed(i->iter->first);
+				continue;
+			}
+
+			binding_param_ = i->bound ? NULL : &*i;
+			layer->set_param(i->iter->first, value);
+			binding_param_ = NULL;
+			i->bound = true;
+		}
+	}
 
 	set_time_mark(time);
 
@@ -97,6 +97,7 @@
 	if (#x=="param_"+param && x.get_type()==value.get_type())                   \
 	{                                                                           \
 		x=value;                                                                \
+		bind_param_slot(param, x);                                              \
         static_param_changed(param);                                            \
 		return true;                                                            \
 	}
@@ -298,6 +299,31 @@ private:
 	//! Map of parameter with animated value nodes
 	DynamicParamList dynamic_param_list_;
 
+	//! Original layer of snapshot copy, see clone_snapshot()
+	etl::loose_handle<Layer> snapshot_source_;
+
+	//! Precompiled assignment of dynamic parameter, see set_time()
+	struct DynamicParamBinding
+	{
+		//! value node may be replaced via rhandle, so keep the iterator
+		DynamicParamList::const_iterator iter;
+		//! layer member imported by IMPORT_VALUE() without side effects,
+		//! when null, set_param() is called
+		ValueBase *slot;
+		//! slot was searched by the first call of set_param()
+		bool bound;
+	};
+
+	//! Bindings of dynamic_param_list_ in the same order,
+	//! rebuilt after connection or disconnection of dynamic parameter.
+	//! Mutable because set_time() is const but assigns parameters anyway
+	//! (like set_param_list() called there before), so set_time()
+	//! must not run simultaneously for the same layer
+	mutable std::vector<DynamicParamBinding> dynamic_param_bindings_;
+	mutable bool dynamic_param_bindings_valid_;
+	//! Binding which slot is searched by current call of set_param()
+	mutable DynamicParamBinding *binding_param_;
+
 	//! A description of what this layer does
 	String description_;
 
@@ -308,6 +334,10 @@ private:
 	mutable Time time_mark;
 	mutable Real outline_grow_mark;
 
+	//! Cached result of is_time_invariant(), reset by on_changed()
+	mutable bool time_invariant_valid_;
+	mutable bool time_invariant_;
+
 	//! Contains the name of the group that this layer belongs to
 	String group_;
 
@@ -378,6 +408,22 @@ protected:
 	void static_param_changed(const String &param);
 	void dynamic_param_changed(const String &param);
 
+	//! Called by IMPORT_VALUE(), remembers member \a x to assign values
+	//! of dynamic parameter directly in set_time()
+	void bind_param_slot(const String &param, ValueBase &x)
+	{
+		if (binding_param_ && binding_param_->iter->first == param)
+			binding_param_->slot = &x;
+	}
+
+	//! Forbids direct assignment of \a param in set_time(),
+	//! for parameters which need more than IMPORT_VALUE() does
+	void unbind_param_slot(const String &param)
+	{
+		if (binding_param_ && binding_param_->iter->first == param)
+			binding_param_->slot = NULL;
+	}
+
 	Layer();
 
 public:
@@ -405,9 +451,19 @@ public:
 	//! Gets the name of the group that this layer belongs to
 	String get_group()const;
 
-	//! Retrieves the dynamic param list member
+	//! Retrieves the dynamic param list member,
+	//! snapshot copies returns the list of original layer
 	//! \see DynamicParamList
-	const DynamicParamList &dynamic_param_list()const { return dynamic_param_list_; }
+	const DynamicParamList &dynamic_param_list()const
+		{ return snapshot_source_ ? snapshot_source_->dynamic_param_list() : dynamic_param_list_; }
+
+	//! Returns original layer if this layer is a snapshot copy
+	//! \see clone_snapshot()
+	etl::loose_handle<Layer> get_snapshot_source()const { return snapshot_source_; }
+	//! Returns original layer of snapshot copy or this layer itself,
+	//! so the same layer may be recognized in snapshots of different frames
+	const Layer* get_snapshot_origin()const
+		{ return snapshot_source_ ? snapshot_source_.get() : this; }
 
 	//! Enables the layer for rendering (Making it \em active)
 	void enable() { set_active(true); }
@@ -633,9 +689,36 @@ public:
 	**  context until the final blend operation. */
 	virtual bool reads_context()const;
 
+	//! Returns true if rendering result depends on values of parameters only
+	/*! Layers which use current time directly (noise, motion blur,
+	**  animated imported files, etc.) should return false, groups with
+	**  such layers inside are not taken from render cache.
+	**  \see Layer_PasteCanvas::fill_render_fingerprint() */
+	virtual bool is_render_cacheable()const;
+
+	//! Returns true if the layer uses current time not only to evaluate its dynamic parameters
+	/*! Layers which pass modified time to the context or to sub-canvases
+	**  (groups, time loop, free time, etc.) should return true.
+	**  By default returns !is_render_cacheable().
+	**  \see is_time_invariant() */
+	virtual bool uses_time()const;
+
+	//! Returns true if the layer is the same at any time, so IndependentContext::set_time() skips it
+	/*! The result is cached until the layer or any of its dynamic parameters are changed.
+	**  \see ValueNode::is_time_invariant() */
+	bool is_time_invariant()const;
+
 	//! Duplicates the Layer without duplicating the value nodes
 	virtual Handle simple_clone()const;
 
+	//! Makes a copy of the Layer for Canvas::snapshot()
+	/*! The copy reads value nodes of this layer without connecting to them,
+	**	so the value nodes stays unchanged. Sub-canvases are replaced by
+	**	their snapshots with \a canvas as parent.
+	**	\see Canvas::snapshot()
+	*/
+	Handle clone_snapshot(etl::loose_handle<Canvas> canvas)const;
+
 	//! Connects the parameter to another Value Node
 	virtual bool connect_dynamic_param(const String& param, etl::loose_handle<ValueNode>);
 
@@ -94,7 +94,10 @@ Layer_Bitmap::get_surface() const
 	}
 	if (!rendering::SurfaceSW::Handle::cast_dynamic(rendering_surface))
 		rendering_surface = new rendering::SurfaceSW(*rendering_surface);
-	return rendering::SurfaceSW::Handle::cast_dynamic(rendering_surface)->get_surface();
+	rendering::SurfaceSW::Handle surface_sw = rendering::SurfaceSW::Handle::cast_dynamic(rendering_surface);
+	// surface may be changed by caller, so downscaled copies will be outdated
+	surface_sw->reset_mipmap();
+	return surface_sw->get_surface();
 }
 
 bool
@@ -685,6 +688,7 @@ Layer_Bitmap::build_composite_task_vfunc(ContextParams /* context_params */) con
 	task_resample->gamma = (Color::value_type)param_gamma_adjust.get(Real());
 	task_resample->interpolation = (Color::Interpolation)param_c.get(int());
 	task_resample->antialiasing = true;
+	task_resample->mipmaps = true;
 	task_resample->sub_task() = task_surface;
 	return task_resample;
 }
@@ -64,6 +64,7 @@ public:
 	virtual bool accelerated_cairorender(Context context, cairo_t *cr, int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
 	virtual Vocab get_param_vocab()const;
 	virtual bool reads_context()const { return true; }
+	virtual bool is_render_cacheable()const { return false; }
 
 protected:
 	virtual rendering::Task::Handle build_rendering_task_vfunc(Context context) const;
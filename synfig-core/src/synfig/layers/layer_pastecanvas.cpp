@@ -49,6 +49,7 @@
 #include <synfig/valuenode.h>
 
 #include <synfig/rendering/common/task/taskblend.h>
+#include <synfig/rendering/common/task/taskcache.h>
 #include <synfig/rendering/common/task/tasksurfaceempty.h>
 #include <synfig/rendering/common/task/tasktransformation.h>
 #include <synfig/rendering/primitive/affinetransformation.h>
@@ -701,9 +702,17 @@ Layer_PasteCanvas::build_composite_task_vfunc(ContextParams context_params) cons
 	if (!canvas)
 		return new rendering::TaskSurfaceEmpty();
 
+	rendering::TaskCache::Fingerprint::Handle fingerprint(new rendering::TaskCache::Fingerprint());
+	fingerprint->add_object(get_snapshot_origin());
+	fingerprint->add_value(param_origin);
+	fingerprint->add_value(param_transformation);
+	if (!fill_render_fingerprint(*fingerprint, context_params))
+		fingerprint.reset();
+
 	CanvasBase sub_queue;
 	Context sub_context;
 	apply_z_range_to_params(context_params);
+	context_params = context_params.transformed(get_summary_transformation().get_matrix());
 	canvas->get_context_sorted(context_params, sub_queue, sub_context);
 
 	rendering::TaskTransformation::Handle task_transformation(new rendering::TaskTransformation());
@@ -711,7 +720,60 @@ Layer_PasteCanvas::build_composite_task_vfunc(ContextParams context_params) cons
 	affine_transformation->matrix = get_summary_transformation().get_matrix();
 	task_transformation->transformation = affine_transformation;
 	task_transformation->sub_task() = sub_context.build_rendering_task();
-	return task_transformation;
+
+	// use render cache only for groups which are not changed since previous build,
+	// animated groups are rendered directly, snapshots of group share its last build
+	{
+		const Layer_PasteCanvas *origin = dynamic_cast<const Layer_PasteCanvas*>(get_snapshot_origin());
+		if (!origin) origin = this;
+		Mutex::Lock lock(origin->last_fingerprint_mutex);
+		bool unchanged = fingerprint && origin->last_fingerprint && *fingerprint == *origin->last_fingerprint;
+		origin->last_fingerprint = fingerprint;
+		if (!unchanged)
+			return task_transformation;
+	}
+
+	rendering::TaskCache::Handle task_cache(new rendering::TaskCache());
+	task_cache->fingerprint = fingerprint;
+	task_cache->sub_task() = task_transformation;
+	return task_cache;
+}
+
+bool
+Layer_PasteCanvas::fill_render_fingerprint(rendering::TaskCache::Fingerprint &fingerprint, ContextParams context_params)const
+{
+	if (!canvas)
+		return true;
+
+	apply_z_range_to_params(context_params);
+	context_params = context_params.transformed(get_summary_transformation().get_matrix());
+	fingerprint.add_value(context_params.render_excluded_contexts);
+	fingerprint.add_value(context_params.z_range);
+	fingerprint.add_value(context_params.z_range_position);
+	fingerprint.add_value(context_params.z_range_depth);
+	fingerprint.add_value(context_params.z_range_blur);
+	fingerprint.add_value(context_params.pixel_size);
+
+	for(Canvas::const_iterator i = canvas->begin(); i != canvas->end(); ++i)
+	{
+		if (!*i || !Context::active(context_params, **i))
+			continue;
+		if (!(*i)->is_render_cacheable())
+			return false;
+
+		fingerprint.add_object((*i)->get_snapshot_origin());
+		fingerprint.add_value((*i)->get_outline_grow_mark());
+		ParamList params = (*i)->get_param_list();
+		for(ParamList::const_iterator j = params.begin(); j != params.end(); ++j)
+			// sub-canvas is new in each snapshot, its layers are added below
+			if (j->second.get_type() != type_canvas)
+				fingerprint.add_value(j->second);
+
+		if (Layer_PasteCanvas::Handle paste_canvas = Layer_PasteCanvas::Handle::cast_dynamic(*i))
+			if (!paste_canvas->fill_render_fingerprint(fingerprint, context_params))
+				return false;
+	}
+	return true;
 }
 
 
@@ -38,6 +38,8 @@
 #include <synfig/canvas.h>
 #include <synfig/rect.h>
 #include <synfig/transformation.h>
+#include <synfig/mutex.h>
+#include <synfig/rendering/common/task/taskcache.h>
 
 /* === M A C R O S ========================================================= */
 
@@ -76,6 +78,11 @@ private:
 	//! Boundaries of the paste canvas layer. It is the canvas's boundary
 	//! affected by the origin and transformation.
 	mutable Rect bounds;
+
+	//! Fingerprint of sub-canvas at previous build of rendering task,
+	//! group is cached only when it's unchanged since previous build
+	mutable rendering::TaskCache::Fingerprint::Handle last_fingerprint;
+	mutable Mutex last_fingerprint_mutex;
 	//! signal connection for children. Seems to be used only here
 	sigc::connection childs_changed_connection;
 
@@ -175,6 +182,9 @@ public:
 	//! See Layer::accelerated_render
 	virtual bool accelerated_render(Context context,Surface *surface,int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
 	virtual bool accelerated_cairorender(Context context, cairo_t *cr, int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
+	//! Appends everything which affects rendering of sub-canvas into \a fingerprint,
+	//! returns false if sub-canvas contains layers which can not be cached
+	bool fill_render_fingerprint(rendering::TaskCache::Fingerprint &fingerprint, ContextParams context_params)const;
 	//! Bounding rect for this layer depends from context_params
 	Rect get_bounding_rect_context_dependent(const ContextParams &context_params)const;
 	//!Returns the rectangle that includes the context of the layer and
@@ -193,6 +203,10 @@ public:
 protected:
 	//! Sets the time of the Paste Canvas Layer and those under it
 	virtual void set_time_vfunc(IndependentContext context, Time time)const;
+public:
+	//! Sub-canvas may be animated
+	virtual bool uses_time()const { return true; }
+protected:
 	//! Sets the outline_grow of the Paste Canvas Layer and those under it
 	virtual void set_outline_grow_vfunc(IndependentContext context, Real outline_grow)const;
 	//!	Function to be overloaded that fills the Time Point Set with
@@ -42,6 +42,7 @@
 #include <synfig/localization.h>
 
 #include <synfig/blur.h>
+#include <synfig/canvas.h>
 #include <synfig/context.h>
 #include <synfig/curve_helper.h>
 #include <synfig/paramdesc.h>
@@ -803,7 +804,10 @@ Layer_Shape::Layer_Shape(const Real &a, const Color::BlendMethod m):
 	param_feather        (Real(0.0)),
 	param_winding_style	 (int(rendering::Contour::WINDING_NON_ZERO)),
 	edge_table	         (new Intersector),
-	contour				 (new rendering::Contour)
+	contour				 (new rendering::Contour),
+	last_sync_outline_grow(0.0),
+	last_sync_flatness_tolerance(0.0),
+	render_pixel_size(0.0)
 {
 }
 
@@ -825,11 +829,21 @@ Layer_Shape::set_shape_param(const String &/* param */, const synfig::ValueBase
 	return false;
 }
 
+bool
+Layer_Shape::import_shape_param(const String & param, const ValueBase &value)
+{
+	if (!set_shape_param(param, value))
+		return false;
+	unbind_param_slot(param);
+	force_sync();
+	return true;
+}
+
 bool
 Layer_Shape::set_param(const String & param, const ValueBase &value)
 {
-	if (set_shape_param(param, value))
-		{ force_sync(); return true; }
+	if (import_shape_param(param, value))
+		return true;
 
 	IMPORT_VALUE_PLUS(param_color,
 	{
@@ -1057,10 +1071,12 @@ Layer_Shape::sync(bool force) const
 {
 	if ( force
 	  || !last_sync_time.is_equal(get_time_mark())
-	  || fabs(last_sync_outline_grow - get_outline_grow_mark()) > 1e-8 )
+	  || fabs(last_sync_outline_grow - get_outline_grow_mark()) > 1e-8
+	  || fabs(last_sync_flatness_tolerance - get_flatness_tolerance()) > 1e-8 )
 	{
 		last_sync_time = get_time_mark();
 		last_sync_outline_grow = get_outline_grow_mark();
+		last_sync_flatness_tolerance = get_flatness_tolerance();
 		const_cast<Layer_Shape*>(this)->sync_vfunc();
 	}
 }
@@ -1069,10 +1085,38 @@ void
 Layer_Shape::sync_vfunc()
 	{ }
 
+Real
+Layer_Shape::get_flatness_tolerance() const
+{
+	// quarter of pixel is not visible even with antialiasing
+	const Real default_pixel_size = 1.0/60.0;
+	Real pixel_size = render_pixel_size;
+	if (pixel_size > real_low_precision<Real>())
+		return 0.25*pixel_size;
+
+	pixel_size = default_pixel_size;
+	if (Canvas::LooseHandle canvas = get_canvas())
+	{
+		const RendDesc &desc = canvas->rend_desc();
+		pixel_size = std::min(fabs(desc.get_pw()), fabs(desc.get_ph()));
+		if (!(pixel_size > real_low_precision<Real>()))
+			pixel_size = default_pixel_size;
+	}
+	return 0.25*pixel_size;
+}
+
+void
+Layer_Shape::sync_pixel_size(Real pixel_size) const
+{
+	if (pixel_size > real_low_precision<Real>())
+		render_pixel_size = pixel_size;
+	sync();
+}
+
 bool
 Layer_Shape::accelerated_render(Context context,Surface *surface,int quality, const RendDesc &renddesc, ProgressCallback *cb)const
 {
-	sync();
+	sync_pixel_size(std::min(fabs(renddesc.get_pw()), fabs(renddesc.get_ph())));
 	Color color=param_color.get(Color());
 	Point origin=param_origin.get(Point());
 	bool invert =param_invert.get(bool(true));
@@ -1266,9 +1310,9 @@ Layer_Shape::render_shape(Surface *surface, bool useblend, const RendDesc &rendd
 }
 
 rendering::Task::Handle
-Layer_Shape::build_composite_task_vfunc(ContextParams /*context_params*/)const
+Layer_Shape::build_composite_task_vfunc(ContextParams context_params)const
 {
-	sync();
+	sync_pixel_size(context_params.pixel_size);
 	rendering::Task::Handle task;
 
 	rendering::TaskContour::Handle task_contour(new rendering::TaskContour());
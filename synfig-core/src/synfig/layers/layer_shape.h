@@ -77,6 +77,9 @@ private:
 
 	mutable Time last_sync_time;
 	mutable Real last_sync_outline_grow;
+	mutable Real last_sync_flatness_tolerance;
+	//! Pixel size (in units) of the last rendering, zero if layer was not rendered yet
+	mutable Real render_pixel_size;
 
 protected:
 	Layer_Shape(const Real &a = 1.0, const Color::BlendMethod m = Color::BLEND_COMPOSITE);
@@ -99,11 +102,21 @@ protected:
 	Vector get_feather() const { return feather; }
 	void set_feather(const Vector &x) { feather = x; }
 
+	//! Max allowed distance (in units) between curves and polygons
+	//! approximating them, depends on pixel size of the last rendering
+	//! or on pixel size of canvas when layer was not rendered yet
+	Real get_flatness_tolerance() const;
+	//! Remembers pixel size of rendering and syncs shape when it changes
+	void sync_pixel_size(Real pixel_size) const;
+
 public:
 	void sync(bool force = false) const;
 	void force_sync() const { sync(true); }
 
 	virtual bool set_shape_param(const String & param, const synfig::ValueBase &value);
+	//! Calls set_shape_param() and forces sync of shape on success,
+	//! so shape parameters are always passed through set_param()
+	bool import_shape_param(const String & param, const synfig::ValueBase &value);
 	virtual bool set_param(const String & param, const synfig::ValueBase &value);
 	virtual ValueBase get_param(const String & param)const;
 
@@ -3120,8 +3120,9 @@ CanvasParser::parse_layer(xmlpp::Element *element,Canvas::Handle canvas)
 }
 
 Canvas::Handle
-CanvasParser::parse_canvas(xmlpp::Element *element,Canvas::Handle parent,bool inline_,const FileSystem::Identifier &identifier,String filename)
+CanvasParser::parse_canvas_header(xmlpp::Element *element,Canvas::Handle parent,bool inline_,const FileSystem::Identifier &identifier,String filename,bool &existing)
 {
+	existing=false;
 
 	if(element->get_name()!="canvas")
 	{
@@ -3168,7 +3169,10 @@ CanvasParser::parse_canvas(xmlpp::Element *element,Canvas::Handle parent,bool in
 	{
 		GUID guid(element->get_attribute("guid")->get_value());
 		if(guid_cast<Canvas>(guid))
+		{
+			existing=true;
 			return guid_cast<Canvas>(guid);
+		}
 		else
 			canvas->set_guid(guid);
 	}
@@ -3266,152 +3270,150 @@ CanvasParser::parse_canvas(xmlpp::Element *element,Canvas::Handle parent,bool in
 	}
 
 	canvas->rend_desc().set_flags(RendDesc::PX_ASPECT|RendDesc::IM_SPAN);
+	return canvas;
+}
 
-	list<ValueNode::Handle> bone_list;
-	xmlpp::Element::NodeList list = element->get_children();
-	for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
+void
+CanvasParser::parse_canvas_child(xmlpp::Element *child,Canvas::Handle canvas,std::list<ValueNode::Handle> &bone_list)
+{
+	if(child->get_name()=="defs")
 	{
-		xmlpp::Element *child(dynamic_cast<xmlpp::Element*>(*iter));
-		if(child)
+		if(canvas->is_inline())
+			error(child,_("Group canvases cannot have a <defs> section"));
+		parse_canvas_defs(child, canvas);
+	}
+	else
+	if(child->get_name()=="bones")
+	{
+		if(canvas->is_inline())
+			error(child,_("Inline canvas cannot have a <bones> section"));
+		std::list<ValueNode::Handle> bones = parse_canvas_bones(child, canvas);
+		bone_list.splice(bone_list.end(), bones);
+	}
+	else
+	if(child->get_name()=="keyframe")
+	{
+		if(canvas->is_inline())
 		{
-			if(child->get_name()=="defs")
-			{
-				if(canvas->is_inline())
-					error(child,_("Group canvases cannot have a <defs> section"));
-				parse_canvas_defs(child, canvas);
-			}
-			else
-			if(child->get_name()=="bones")
-			{
-				if(canvas->is_inline())
-					error(child,_("Inline canvas cannot have a <bones> section"));
-				bone_list = parse_canvas_bones(child, canvas);
-			}
-			else
-			if(child->get_name()=="keyframe")
-			{
-				if(canvas->is_inline())
-				{
-					warning(child,_("Group canvases cannot have keyframes"));
-					continue;
-				}
+			warning(child,_("Group canvases cannot have keyframes"));
+			return;
+		}
 
-				canvas->keyframe_list().add(parse_keyframe(child,canvas));
-				canvas->keyframe_list().sync();
-			}
-			else
-			if(child->get_name()=="meta")
-			{
-				if(canvas->is_inline())
-				{
-					warning(child,_("Group canvases cannot have metadata"));
-					continue;
-				}
+		canvas->keyframe_list().add(parse_keyframe(child,canvas));
+		canvas->keyframe_list().sync();
+	}
+	else
+	if(child->get_name()=="meta")
+	{
+		if(canvas->is_inline())
+		{
+			warning(child,_("Group canvases cannot have metadata"));
+			return;
+		}
 
-				if(!child->get_attribute("name"))
-				{
-					warning(child,_("<meta> must have a name"));
-					continue;
-				}
+		if(!child->get_attribute("name"))
+		{
+			warning(child,_("<meta> must have a name"));
+			return;
+		}
 
-				if(!child->get_attribute("content"))
-				{
-					warning(child,_("<meta> must have content"));
-					continue;
-				}
-				
-				// In Synfig prior to version 1.0 we have messed decimal separator:
-				// some files use ".", but other ones use ","/
-				// Let's try to put a workaround for that.
-				std::vector<String> replacelist;
-				replacelist.push_back("background_first_color");
-				replacelist.push_back("background_second_color");
-				replacelist.push_back("background_size");
-				replacelist.push_back("grid_color");
-				replacelist.push_back("grid_size");
-				replacelist.push_back("jack_offset");
-				String content;
-				content=child->get_attribute("content")->get_value();
-				if(std::find(replacelist.begin(), replacelist.end(), child->get_attribute("name")->get_value()) != replacelist.end()) 
-				{
-					size_t index = 0;
-					while (true) {
-					     /* Locate the substring to replace. */
-					     index = content.find(",", index);
-					     if (index == string::npos) break;
+		if(!child->get_attribute("content"))
+		{
+			warning(child,_("<meta> must have content"));
+			return;
+		}
+		
+		// In Synfig prior to version 1.0 we have messed decimal separator:
+		// some files use ".", but other ones use ","/
+		// Let's try to put a workaround for that.
+		std::vector<String> replacelist;
+		replacelist.push_back("background_first_color");
+		replacelist.push_back("background_second_color");
+		replacelist.push_back("background_size");
+		replacelist.push_back("grid_color");
+		replacelist.push_back("grid_size");
+		replacelist.push_back("jack_offset");
+		String content;
+		content=child->get_attribute("content")->get_value();
+		if(std::find(replacelist.begin(), replacelist.end(), child->get_attribute("name")->get_value()) != replacelist.end()) 
+		{
+			size_t index = 0;
+			while (true) {
+			     /* Locate the substring to replace. */
+			     index = content.find(",", index);
+			     if (index == string::npos) break;
 
-					     /* Make the replacement. */
-					     content.replace(index, 1, ".");
+			     /* Make the replacement. */
+			     content.replace(index, 1, ".");
 
-					     /* Advance index forward so the next iteration doesn't pick it up as well. */
-					     index += 1;
-					}
-					
-				}
-				canvas->set_meta_data(child->get_attribute("name")->get_value(),content);
+			     /* Advance index forward so the next iteration doesn't pick it up as well. */
+			     index += 1;
 			}
-			else if(child->get_name()=="name")
-			{
-				xmlpp::Element::NodeList list = child->get_children();
+			
+		}
+		canvas->set_meta_data(child->get_attribute("name")->get_value(),content);
+	}
+	else if(child->get_name()=="name")
+	{
+		xmlpp::Element::NodeList list = child->get_children();
 
-				// If we don't have any name, warn
-				if(list.empty())
-					warning(child,_("blank \"name\" entity"));
+		// If we don't have any name, warn
+		if(list.empty())
+			warning(child,_("blank \"name\" entity"));
 
-				string tmp;
-				for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
-					if(dynamic_cast<xmlpp::TextNode*>(*iter))tmp+=dynamic_cast<xmlpp::TextNode*>(*iter)->get_content();
-				canvas->set_name(tmp);
-			}
-			else
-			if(child->get_name()=="desc")
-			{
+		string tmp;
+		for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
+			if(dynamic_cast<xmlpp::TextNode*>(*iter))tmp+=dynamic_cast<xmlpp::TextNode*>(*iter)->get_content();
+		canvas->set_name(tmp);
+	}
+	else
+	if(child->get_name()=="desc")
+	{
 
-				xmlpp::Element::NodeList list = child->get_children();
+		xmlpp::Element::NodeList list = child->get_children();
 
-				// If we don't have any description, warn
-				if(list.empty())
-					warning(child,_("blank \"desc\" entity"));
+		// If we don't have any description, warn
+		if(list.empty())
+			warning(child,_("blank \"desc\" entity"));
 
-				string tmp;
-				for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
-					if(dynamic_cast<xmlpp::TextNode*>(*iter))tmp+=dynamic_cast<xmlpp::TextNode*>(*iter)->get_content();
-				canvas->set_description(tmp);
-			}
-			else
-			if(child->get_name()=="author")
-			{
+		string tmp;
+		for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
+			if(dynamic_cast<xmlpp::TextNode*>(*iter))tmp+=dynamic_cast<xmlpp::TextNode*>(*iter)->get_content();
+		canvas->set_description(tmp);
+	}
+	else
+	if(child->get_name()=="author")
+	{
 
-				xmlpp::Element::NodeList list = child->get_children();
+		xmlpp::Element::NodeList list = child->get_children();
 
-				// If we don't have any description, warn
-				if(list.empty())
-					warning(child,_("blank \"author\" entity"));
+		// If we don't have any description, warn
+		if(list.empty())
+			warning(child,_("blank \"author\" entity"));
 
-				string tmp;
-				for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
-					if(dynamic_cast<xmlpp::TextNode*>(*iter))tmp+=dynamic_cast<xmlpp::TextNode*>(*iter)->get_content();
-				canvas->set_author(tmp);
-			}
-			else
-			if(child->get_name()=="layer")
-			{
-				//if(canvas->is_inline())
-				//	canvas->push_front(parse_layer(child,canvas->parent()));
-				//else
-					canvas->push_front(parse_layer(child,canvas));
-			}
-			else
-			{
-				printf("%s:%d\n", __FILE__, __LINE__);
-				error_unexpected_element(child,child->get_name());
-			}
-		}
-//		else
-//		if((child->get_name()=="text"||child->get_name()=="comment") && child->has_child_text())
-//			continue;
+		string tmp;
+		for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
+			if(dynamic_cast<xmlpp::TextNode*>(*iter))tmp+=dynamic_cast<xmlpp::TextNode*>(*iter)->get_content();
+		canvas->set_author(tmp);
 	}
+	else
+	if(child->get_name()=="layer")
+	{
+		//if(canvas->is_inline())
+		//	canvas->push_front(parse_layer(child,canvas->parent()));
+		//else
+			canvas->push_front(parse_layer(child,canvas));
+	}
+	else
+	{
+		printf("%s:%d\n", __FILE__, __LINE__);
+		error_unexpected_element(child,child->get_name());
+	}
+}
 
+void
+CanvasParser::parse_canvas_footer(xmlpp::Element *element,Canvas::Handle canvas)
+{
 	if(canvas->value_node_list().placeholder_count())
 	{
 		String nodes;
@@ -3428,6 +3430,76 @@ CanvasParser::parse_canvas(xmlpp::Element *element,Canvas::Handle parent,bool in
 	}
 
 	canvas->set_version(CURRENT_CANVAS_VERSION);
+}
+
+Canvas::Handle
+CanvasParser::parse_canvas(xmlpp::Element *element,Canvas::Handle parent,bool inline_,const FileSystem::Identifier &identifier,String filename)
+{
+	bool existing;
+	Canvas::Handle canvas = parse_canvas_header(element, parent, inline_, identifier, filename, existing);
+	if(!canvas || existing)
+		return canvas;
+
+	// bones are held here until layers which refer them by guid are parsed
+	list<ValueNode::Handle> bone_list;
+	xmlpp::Element::NodeList list = element->get_children();
+	for(xmlpp::Element::NodeList::iterator iter = list.begin(); iter != list.end(); ++iter)
+		if(xmlpp::Element *child = dynamic_cast<xmlpp::Element*>(*iter))
+			parse_canvas_child(child, canvas, bone_list);
+
+	parse_canvas_footer(element, canvas);
+	return canvas;
+}
+
+Canvas::Handle
+CanvasParser::parse_canvas_stream(xmlpp::TextReader &reader,const FileSystem::Identifier &identifier,String filename)
+{
+	while(reader.get_node_type() != xmlpp::TextReader::Element)
+		if(!reader.read())
+			throw runtime_error(_("Document has no root element"));
+
+	bool empty = reader.is_empty_element();
+
+	// attributes of root element are copied into separate tiny document,
+	// so the header of canvas is parsed by the same code in both modes
+	xmlpp::Document header;
+	xmlpp::Element *root = header.create_root_node(reader.get_name());
+	if(reader.has_attributes() && reader.move_to_first_attribute())
+	{
+		do root->set_attribute(reader.get_name(), reader.get_value());
+		while(reader.move_to_next_attribute());
+		reader.move_to_element();
+	}
+
+	bool existing;
+	Canvas::Handle canvas = parse_canvas_header(root, 0, false, identifier, filename, existing);
+	if(!canvas || existing)
+		return canvas;
+
+	// bones are held here until layers which refer them by guid are parsed
+	list<ValueNode::Handle> bone_list;
+	if(!empty)
+	{
+		// expand children of root one by one, reader frees the subtree
+		// of each child when it moves to the next sibling
+		int depth = reader.get_depth();
+		bool valid = reader.read();
+		while(valid && reader.get_depth() > depth)
+		{
+			if(reader.get_node_type() == xmlpp::TextReader::Element)
+			{
+				if(xmlpp::Element *child = dynamic_cast<xmlpp::Element*>(reader.expand()))
+					parse_canvas_child(child, canvas, bone_list);
+				valid = reader.next();
+			}
+			else
+			{
+				valid = reader.read();
+			}
+		}
+	}
+
+	parse_canvas_footer(root, canvas);
 	return canvas;
 }
 
@@ -3477,31 +3549,48 @@ CanvasParser::parse_from_file_as(const FileSystem::Identifier &identifier,const
 			if (filename_extension(identifier.filename) == ".sifz")
 				stream = FileSystem::ReadStream::Handle(new ZReadStream(stream));
 
-			xmlpp::DomParser parser;
-			parser.parse_stream(*stream);
-			stream.reset();
-			if(parser)
+			Canvas::Handle canvas;
+			if(streaming_ && !getenv("SYNFIG_DISABLE_STREAMING_LOAD"))
 			{
-				Canvas::Handle canvas(parse_canvas(parser.get_document()->get_root_node(),0,false,identifier,as));
-				if (!canvas) return canvas;
-				register_canvas_in_map(canvas, as);
+				// libxml++ has no stream input for TextReader, so the raw content
+				// is kept in memory, it is still much smaller than the whole DOM tree
+				String data;
+				char buffer[65536];
+				for(std::streamsize size; (size = stream->read(buffer, sizeof(buffer)).gcount()) > 0; )
+					data.append(buffer, size);
+				stream.reset();
 
-				const ValueNodeList& value_node_list(canvas->value_node_list());
+				xmlpp::TextReader reader((const unsigned char*)data.c_str(), data.size(), as);
+				canvas = parse_canvas_stream(reader,identifier,as);
+			}
+			else
+			{
+				xmlpp::DomParser parser;
+				parser.parse_stream(*stream);
+				stream.reset();
+				if(!parser)
+					return Canvas::Handle();
+				canvas = parse_canvas(parser.get_document()->get_root_node(),0,false,identifier,as);
+			}
 
-				again:
-				ValueNodeList::const_iterator iter;
-				for(iter=value_node_list.begin();iter!=value_node_list.end();++iter)
+			if (!canvas) return canvas;
+			register_canvas_in_map(canvas, as);
+
+			const ValueNodeList& value_node_list(canvas->value_node_list());
+
+			again:
+			ValueNodeList::const_iterator iter;
+			for(iter=value_node_list.begin();iter!=value_node_list.end();++iter)
+			{
+				ValueNode::Handle value_node(*iter);
+				if(value_node->is_exported() && value_node->get_id().find("Unnamed")==0)
 				{
-					ValueNode::Handle value_node(*iter);
-					if(value_node->is_exported() && value_node->get_id().find("Unnamed")==0)
-					{
-						canvas->remove_value_node(value_node, true);
-						goto again;
-					}
+					canvas->remove_value_node(value_node, true);
+					goto again;
 				}
-
-				return canvas;
 			}
+
+			return canvas;
 		} else {
 			throw runtime_error(String("  * ") + _("Can't find linked file") + " \"" + identifier.filename + "\"");
 		}
@@ -51,7 +51,7 @@
 
 /* === C L A S S E S & S T R U C T S ======================================= */
 
-namespace xmlpp { class Node; class Element; };
+namespace xmlpp { class Node; class Element; class TextReader; };
 
 namespace synfig {
 
@@ -74,6 +74,8 @@ private:
     int total_errors_;
 	//! True if errors doesn't stop canvas parsing
 	bool allow_errors_;
+	//! True if files should be parsed element by element without building of whole DOM tree
+	bool streaming_;
 	//! File name to parse
 	String filename;
 	//! Path of the file name to parse
@@ -95,7 +97,8 @@ public:
 		max_warnings_	(1000),
 		total_warnings_	(0),
 		total_errors_	(0),
-		allow_errors_	(false)
+		allow_errors_	(false),
+		streaming_		(true)
 	{ }
 
 	/*
@@ -113,6 +116,12 @@ public:
 	//! Returns the maximum number of warnings before a fatal_error is thrown
 	int get_max_warnings() { return max_warnings_; }
 
+	//! Sets streaming mode for parse_from_file_as(), see SYNFIG_DISABLE_STREAMING_LOAD environment variable
+	CanvasParser &set_streaming(bool x) { streaming_=x; return *this; }
+
+	//! Returns true if files will be parsed in streaming mode
+	bool get_streaming()const { return streaming_; }
+
 	//! Returns the number of errors in the last parse
 	int error_count()const { return total_errors_; }
 
@@ -163,6 +172,15 @@ private:
 
 	//! Canvas Parsing Function
 	Canvas::Handle parse_canvas(xmlpp::Element *node,Canvas::Handle parent=0,bool inline_=false,const FileSystem::Identifier &identifier = FileSystemNative::instance()->get_identifier(std::string()),String path=".");
+	//! Canvas Parsing Function for xmlpp::TextReader, expands only one child of root canvas at a time
+	Canvas::Handle parse_canvas_stream(xmlpp::TextReader &reader,const FileSystem::Identifier &identifier,String path);
+	//! Creates canvas and applies attributes of canvas element, \a existing will be set if canvas with same GUID is already loaded
+	Canvas::Handle parse_canvas_header(xmlpp::Element *node,Canvas::Handle parent,bool inline_,const FileSystem::Identifier &identifier,String path,bool &existing);
+	//! Parses one child element of canvas element (defs, bones, keyframe, meta, name, desc, author or layer),
+	//! parsed bones are appended to \a bone_list, which should be kept until parse_canvas_footer()
+	void parse_canvas_child(xmlpp::Element *node,Canvas::Handle canvas,std::list<ValueNode::Handle> &bone_list);
+	//! Checks placeholders and finalizes canvas when all children are parsed
+	void parse_canvas_footer(xmlpp::Element *node,Canvas::Handle canvas);
 	//! Canvas definitions Parsing Function (exported value nodes and exported canvases)
 	void parse_canvas_defs(xmlpp::Element *node,Canvas::Handle canvas);
 
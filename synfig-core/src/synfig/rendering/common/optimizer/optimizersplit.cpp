@@ -35,6 +35,8 @@
 #include <signal.h>
 #endif
 
+#include <algorithm>
+
 #include <synfig/general.h>
 #include <synfig/localization.h>
 
@@ -57,43 +59,51 @@ using namespace rendering;
 /* === M E T H O D S ======================================================= */
 
 void
-OptimizerSplit::run(const RunParams& /* params */) const
+OptimizerSplit::run(const RunParams& params) const
 {
-	// TODO: this version of split don't keep coordinates
-	/*
-	const int min_area = 256*256;
-	int threads = params.renderer.get_max_simultaneous_threads();
+	// Split big leaf tasks into horizontal bands, so they can be processed
+	// by several threads. Bands don't intersect, so Renderer::find_deps
+	// will not create dependencies between them.
+	// TaskSplittable::split() truncates the target rect by
+	// Task::trunc_target_rect(), which keeps source rect (coordinates)
+	// consistent with new target rect.
+
+	const int threads = params.renderer.get_max_simultaneous_threads();
+	if (threads < 2) return;
+	const int max_bands = threads*bands_per_thread;
+
 	for(Task::List::iterator i = params.list.begin(); i != params.list.end(); ++i)
 	{
-		if ( i->type_is<TaskSplittable>()
-		 &&  !i->type_pointer<TaskSplittable>()->splitted )
+		if ( !*i
+		  || !i->type_is<TaskSplittable>()
+		  || i->type_pointer<TaskSplittable>()->splitted
+		  || !i->type_pointer<TaskSplittable>()->is_splittable()
+		  || !(*i)->valid_target() )
+			continue;
+
+		const RectInt r = (*i)->get_target_rect();
+		const int w = r.get_width();
+		const int h = r.get_height();
+		const int bands = std::min(
+			std::min(h/min_band_height, (int)((long long)w*h/min_band_area)),
+			max_bands );
+		if (bands < 2) continue;
+
+		const Task::Handle task = *i;
+		for(int j = 0; j < bands; ++j)
 		{
-			RectInt r = (*i)->get_target_rect();
-			int w = r.maxx - r.minx;
-			int h = r.maxy - r.miny;
-			int t = std::min(h, std::min(w*h/min_area, threads));
-			if (t >= 2)
-			{
-				int hh = h/t;
-				int offset = r.miny;
-				for(int j = 1; j < t; ++j)
-				{
-					Task::Handle task = (*i)->clone();
-					task.type_pointer<TaskSplittable>()->split(
-						RectInt(r.minx, offset, r.maxx, offset + hh) );
-					task.type_pointer<TaskSplittable>()->splitted = true;
-					i = params.list.insert(i, task);
-					++i;
-					offset += hh;
-				}
-				*i = (*i)->clone();
-				i->type_pointer<TaskSplittable>()->split(
-					RectInt(r.minx, offset, r.maxx, r.maxy) );
-				i->type_pointer<TaskSplittable>()->splitted = true;
-			}
+			RectInt band(
+				r.minx, r.miny + (int)((long long)h*j/bands),
+				r.maxx, r.miny + (int)((long long)h*(j + 1)/bands) );
+
+			Task::Handle sub_task = task->clone();
+			sub_task.type_pointer<TaskSplittable>()->split(band);
+			sub_task.type_pointer<TaskSplittable>()->splitted = true;
+
+			// keep order of tasks, bands are placed instead of original task
+			if (j == 0) *i = sub_task; else i = params.list.insert(i + 1, sub_task);
 		}
 	}
-	*/
 }
 
 /* === E N T R Y P O I N T ================================================= */
@@ -43,6 +43,13 @@ namespace rendering
 class OptimizerSplit: public Optimizer
 {
 public:
+	//! don't split tasks to bands less than this area (in pixels)
+	static const int min_band_area = 128*128;
+	//! don't split tasks to bands less than this height (in pixels)
+	static const int min_band_height = 16;
+	//! more bands than threads gives better balance for non-uniform tasks
+	static const int bands_per_thread = 2;
+
 	OptimizerSplit()
 	{
 		category_id = CATEGORY_ID_LIST;
@@ -0,0 +1,179 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskcache.cpp
+**	\brief TaskCache
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include "taskcache.h"
+
+#include <synfig/blinepoint.h>
+#include <synfig/dashitem.h>
+#include <synfig/gradient.h>
+#include <synfig/matrix.h>
+#include <synfig/segment.h>
+#include <synfig/time.h>
+#include <synfig/transformation.h>
+#include <synfig/widthpoint.h>
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+void
+TaskCache::Fingerprint::add_value(const ValueBase &value)
+{
+	Type &type = value.get_type();
+	add_data(type.identifier);
+
+	if (type == type_real)
+		add_data(value.get(Real()));
+	else
+	if (type == type_time)
+		add_data((Real)value.get(Time()));
+	else
+	if (type == type_angle)
+		add_data(Angle::rad(value.get(Angle())).get());
+	else
+	if (type == type_vector)
+		add_data(value.get(Vector()));
+	else
+	if (type == type_color)
+		add_data(value.get(Color()));
+	else
+	if (type == type_matrix)
+		add_data(value.get(Matrix()).m);
+	else
+	if (type == type_segment)
+	{
+		const Segment &segment = value.get(Segment());
+		add_data(segment.p1); add_data(segment.t1);
+		add_data(segment.p2); add_data(segment.t2);
+	}
+	else
+	if (type == type_transformation)
+	{
+		const Transformation &transformation = value.get(Transformation());
+		add_data(transformation.offset);
+		add_data(Angle::rad(transformation.angle).get());
+		add_data(Angle::rad(transformation.skew_angle).get());
+		add_data(transformation.scale);
+	}
+	else
+	if (type == type_gradient)
+	{
+		const Gradient &gradient = value.get(Gradient());
+		add_data(gradient.size());
+		for(Gradient::const_iterator i = gradient.begin(); i != gradient.end(); ++i)
+			{ add_data(i->pos); add_data(i->color); }
+	}
+	else
+	if (type == type_bline_point)
+	{
+		const BLinePoint &point = value.get(BLinePoint());
+		add_data(point.get_vertex());
+		add_data(point.get_tangent1());
+		add_data(point.get_tangent2());
+		add_data(point.get_width());
+		add_data(point.get_origin());
+		add_data(point.get_vertex_setup());
+		add_data((char)point.get_split_tangent_radius());
+		add_data((char)point.get_split_tangent_angle());
+		add_data((char)point.get_boned_vertex_flag());
+	}
+	else
+	if (type == type_width_point)
+	{
+		const WidthPoint &point = value.get(WidthPoint());
+		add_data(point.get_position());
+		add_data(point.get_width());
+		add_data(point.get_side_type_before());
+		add_data(point.get_side_type_after());
+		add_data((char)point.get_dash());
+		add_data(point.get_lower_bound());
+		add_data(point.get_upper_bound());
+	}
+	else
+	if (type == type_dash_item)
+	{
+		const DashItem &item = value.get(DashItem());
+		add_data(item.get_offset());
+		add_data(item.get_length());
+		add_data(item.get_side_type_before());
+		add_data(item.get_side_type_after());
+	}
+	else
+	if (type == type_list)
+	{
+		const ValueBase::List &list = value.get_list();
+		add_data(list.size());
+		for(ValueBase::List::const_iterator i = list.begin(); i != list.end(); ++i)
+			add_value(*i);
+	}
+	else
+		values.push_back(value);
+}
+
+size_t
+TaskCache::Fingerprint::get_hash() const
+{
+	size_t hash = objects.size();
+	for(std::vector<const void*>::const_iterator i = objects.begin(); i != objects.end(); ++i)
+		hash = hash*31 + (size_t)*i;
+	hash = hash*31 + data.size();
+	for(std::string::const_iterator i = data.begin(); i != data.end(); ++i)
+		hash = hash*31 + (unsigned char)*i;
+	hash = hash*31 + values.size();
+	for(std::vector<ValueBase>::const_iterator i = values.begin(); i != values.end(); ++i)
+		hash = hash*31 + (size_t)i->get_type().identifier;
+	return hash;
+}
+
+VectorInt
+TaskCache::get_offset() const
+{
+	if (!sub_task()) return VectorInt::zero();
+	Vector offset = (sub_task()->get_source_rect_lt() - get_source_rect_lt()).multiply_coords(get_pixels_per_unit());
+	return VectorInt((int)round(offset[0]), (int)round(offset[1])) - sub_task()->get_target_offset();
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,107 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskcache.h
+**	\brief TaskCache Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_TASKCACHE_H
+#define __SYNFIG_RENDERING_TASKCACHE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <string>
+#include <vector>
+
+#include <synfig/value.h>
+
+#include "../../task.h"
+#include "tasktransformationpass.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+//! Result of sub-task may be taken from render cache of renderer,
+//! when sub-task with the same fingerprint was rendered before
+class TaskCache: public Task, public TaskTransformationPass
+{
+public:
+	typedef etl::handle<TaskCache> Handle;
+
+	//! Snapshot of everything which affects the rendering of sub-task
+	//! (excepting transformations and target rect), filled by layer
+	class Fingerprint: public etl::shared_object
+	{
+	private:
+		template<typename T>
+		void add_data(const T &x)
+			{ data.append((const char*)&x, sizeof(x)); }
+
+	public:
+		typedef etl::handle<Fingerprint> Handle;
+
+		std::vector<const void*> objects;
+		//! Bitwise copy of numbers from added values, so even
+		//! the smallest change of animated value gives other fingerprint
+		std::string data;
+		//! Added values without numbers (strings, canvases, bones, etc),
+		//! they are compared by ValueBase
+		std::vector<ValueBase> values;
+
+		void add_object(const void *object) { objects.push_back(object); }
+		void add_value(const ValueBase &value);
+
+		//! Equal fingerprints have equal hashes,
+		//! only types of values without numbers are hashed
+		size_t get_hash() const;
+
+		bool operator==(const Fingerprint &other) const
+			{ return this == &other || (objects == other.objects && data == other.data && values == other.values); }
+		bool operator!=(const Fingerprint &other) const
+			{ return !(*this == other); }
+	};
+
+	Fingerprint::Handle fingerprint;
+
+	Task::Handle clone() const { return clone_pointer(this); }
+
+	const Task::Handle& sub_task() const { return Task::sub_task(0); }
+	Task::Handle& sub_task() { return Task::sub_task(0); }
+
+	VectorInt get_offset() const;
+
+	virtual Rect calc_bounds() const
+		{ return sub_task() ? sub_task()->get_bounds() : Rect::zero(); }
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -0,0 +1,123 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskgradient.cpp
+**	\brief TaskGradient
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "taskgradient.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+Real
+TaskGradient::Shape::get_min_supersample(const Rect &rect, Real pw) const
+{
+	// supersample width decreases with distance from the center of shape,
+	// so the smallest one is at one of the corners
+	const Point corners[] = {
+		Point(rect.minx, rect.miny),
+		Point(rect.minx, rect.maxy),
+		Point(rect.maxx, rect.miny),
+		Point(rect.maxx, rect.maxy) };
+	Real min_supersample = std::numeric_limits<Real>::infinity();
+	for(int i = 0; i < 4; ++i)
+	{
+		Real supersample = std::fabs(pw);
+		get_position(corners[i], supersample);
+		min_supersample = std::min(min_supersample, std::fabs(supersample));
+	}
+	return min_supersample;
+}
+
+Color
+TaskGradient::Shape::get_color(const CompiledGradient &gradient, const Point &point, Real pw) const
+{
+	Real supersample = pw;
+	Real x = get_position(point, supersample);
+	return sample(gradient, x, supersample, loop, zigzag);
+}
+
+Color
+TaskGradient::sample(const CompiledGradient &gradient, Real x, Real supersample, bool loop, bool zigzag)
+{
+	if (loop)
+		x -= floor(x);
+
+	if (zigzag)
+	{
+		x *= 2.0;
+		supersample *= 2.0;
+		if (x > 1.0) x = 2.0 - x;
+	}
+
+	if (loop)
+	{
+		if (x + supersample*0.5 > 1.0)
+		{
+			Real  left(supersample*0.5 - (x - 1.0));
+			Real right(supersample*0.5 + (x - 1.0));
+			Color pool(gradient(1.0 - left*0.5, left).premult_alpha()*left/supersample);
+			if (zigzag) pool += gradient(1.0 - right*0.5, right).premult_alpha()*right/supersample;
+			else        pool += gradient(right*0.5, right).premult_alpha()*right/supersample;
+			return pool.demult_alpha();
+		}
+		if (x - supersample*0.5 < 0.0)
+		{
+			Real  left(supersample*0.5 - x);
+			Real right(supersample*0.5 + x);
+			Color pool(gradient(right*0.5, right).premult_alpha()*right/supersample);
+			if (zigzag) pool += gradient(left*0.5, left).premult_alpha()*left/supersample;
+			else        pool += gradient(1.0 - left*0.5, left).premult_alpha()*left/supersample;
+			return pool.demult_alpha();
+		}
+	}
+
+	return gradient(x, supersample);
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,89 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskgradient.h
+**	\brief TaskGradient Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_TASKGRADIENT_H
+#define __SYNFIG_RENDERING_TASKGRADIENT_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <synfig/compiledgradient.h>
+
+#include "../../task.h"
+#include "tasktransformableaffine.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+class TaskGradient: public Task, public TaskTransformableAffine
+{
+public:
+	typedef etl::handle<TaskGradient> Handle;
+
+	//! Maps points of plane to positions in gradient, implemented by layers
+	class Shape: public etl::shared_object
+	{
+	public:
+		typedef etl::handle<Shape> Handle;
+
+		bool loop;
+		bool zigzag;
+
+		Shape(): loop(false), zigzag(false) { }
+
+		//! Returns position in gradient for \a point,
+		//! converts \a supersample from units of plane to units of gradient
+		virtual Real get_position(const Point &point, Real &supersample) const = 0;
+
+		//! Smallest supersample width (in units of gradient) at corners of \a rect
+		Real get_min_supersample(const Rect &rect, Real pw) const;
+
+		//! Color at \a point averaged over the pixel of size \a pw
+		Color get_color(const CompiledGradient &gradient, const Point &point, Real pw) const;
+	};
+
+	CompiledGradient gradient;
+	Shape::Handle shape;
+
+	Task::Handle clone() const { return clone_pointer(this); }
+	virtual Rect calc_bounds() const
+		{ return !shape || gradient.empty() ? Rect::zero() : Rect::infinite(); }
+
+	//! Samples gradient, supersample region is wrapped at ends of loop
+	static Color sample(const CompiledGradient &gradient, Real x, Real supersample, bool loop, bool zigzag);
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -43,6 +43,8 @@ class TaskSplittable
 public:
 	bool splitted;
 	TaskSplittable(): splitted(false) { }
+	//! Returns false when bands of task rendered separately will not match the whole result
+	virtual bool is_splittable() const { return true; }
 	virtual void split(const RectInt &sub_target_rect) = 0;
 	virtual ~TaskSplittable() { }
 };
@@ -51,12 +51,16 @@ public:
 	Color::value_type gamma;
 	Color::Interpolation interpolation;
 	bool antialiasing;
+	//! allows to sample downscaled copies of source surface,
+	//! source surface should not be changed while it is in use
+	bool mipmaps;
 	Vector supersample;
 
 	TaskSurfaceResample():
 		gamma(1.f),
 		interpolation(Color::INTERPOLATION_LINEAR),
 		antialiasing(false),
+		mipmaps(false),
 		supersample(1.0, 1.0)
 	{ }
 
@@ -57,7 +57,9 @@
 
 #include "../software/optimizer/optimizerblendsw.h"
 #include "../software/optimizer/optimizerblursw.h"
+#include "../software/optimizer/optimizercachesw.h"
 #include "../software/optimizer/optimizercontoursw.h"
+#include "../software/optimizer/optimizergradientsw.h"
 #include "../software/optimizer/optimizerlayersw.h"
 #include "../software/optimizer/optimizermeshsw.h"
 #include "../software/optimizer/optimizerpixelcolormatrixsw.h"
@@ -84,7 +86,9 @@ RendererGL::RendererGL()
 
 	register_optimizer(new OptimizerBlendGL());
 	register_optimizer(new OptimizerBlurSW());
+	register_optimizer(new OptimizerCacheSW());
 	register_optimizer(new OptimizerContourGL());
+	register_optimizer(new OptimizerGradientSW());
 	register_optimizer(new OptimizerLayerSW());
 	register_optimizer(new OptimizerPixelColorMatrixSW());
 	register_optimizer(new OptimizerPixelGammaSW());
@@ -35,6 +35,9 @@
 #include <signal.h>
 #endif
 
+#include <cmath>
+#include <algorithm>
+
 #include "contour.h"
 
 #endif
@@ -419,4 +422,44 @@ Contour::split(
 	Helper::contour_split(params, *this, transform_matrix);
 }
 
+int
+Contour::cubic_segments(
+	const Vector &p0,
+	const Vector &p1,
+	const Vector &pp0,
+	const Vector &pp1,
+	Real offset,
+	Real tolerance,
+	int max_segments )
+{
+	if (max_segments <= 1 || !(tolerance > 0.0))
+		return std::max(1, max_segments);
+
+	// second derivative of curve is not greater than 6*dd,
+	// so polyline with n segments differs from curve less than 6*dd/(8*n^2)
+	Real dd = std::max( (p0 - pp0*2.0 + pp1).mag(),
+	                    (pp0 - pp1*2.0 + p1).mag() );
+	Real segments = sqrt(0.75*dd/tolerance);
+
+	// curve turns not more than its control polygon,
+	// arc of radius r turning by angle a differs from its chord by r*a^2/8
+	if (offset > 0.0)
+	{
+		const Vector d[] = { pp0 - p0, pp1 - pp0, p1 - pp1 };
+		Real angle = 0.0;
+		const Vector *prev = NULL;
+		for(int i = 0; i < 3; ++i)
+		{
+			if (d[i].is_equal_to(Vector::zero())) continue;
+			if (prev) angle += fabs(atan2(prev->perp()*d[i], *prev*d[i]));
+			prev = &d[i];
+		}
+		segments += angle*sqrt(0.125*offset/tolerance);
+	}
+
+	if (!(segments < (Real)max_segments))
+		return max_segments;
+	return std::max(1, (int)approximate_ceil_lp(segments));
+}
+
 /* === E N T R Y P O I N T ================================================= */
@@ -153,6 +153,19 @@ public:
 		const Vector &pp0,
 		const Vector &pp1 )
 	{ return Rect(p0).expand(p1).expand(pp0).expand(pp1); }
+
+	//! Returns count of segments (with equal steps of curve parameter)
+	//! of polyline which differs from cubic curve less than \a tolerance.
+	//! Curves shifted along normal by any distance up to \a offset
+	//! (sides of outline) are also taken into account.
+	static int cubic_segments(
+		const Vector &p0,
+		const Vector &p1,
+		const Vector &pp0,
+		const Vector &pp1,
+		Real offset,
+		Real tolerance,
+		int max_segments );
 };
 
 } /* end namespace rendering */
@@ -684,6 +684,9 @@ Renderer::run(const Task::List &list) const
 					: Surface::Handle(),
 				get_debug_options().result_image,
 				true );
+
+		if (!get_debug_options().queue_counters_log.empty())
+			queue->log_counters(get_debug_options().queue_counters_log);
 	}
 
 	return success;
@@ -804,6 +807,8 @@ Renderer::initialize()
 		debug_options.task_list_optimized_log = s;
 	if (const char *s = getenv("SYNFIG_RENDERING_DEBUG_RESULT_IMAGE"))
 		debug_options.result_image = s;
+	if (const char *s = getenv("SYNFIG_RENDERING_DEBUG_QUEUE_COUNTERS_LOG"))
+		debug_options.queue_counters_log = s;
 
 	renderers = new std::map<String, Handle>();
 	queue = new RenderQueue();
@@ -55,6 +55,7 @@ public:
 		String task_list_log;
 		String task_list_optimized_log;
 		String result_image;
+		String queue_counters_log;
 	};
 
 private:
@@ -123,6 +124,10 @@ public:
 	static const DebugOptions& get_debug_options()
 		{ return debug_options; }
 
+	//! rendering queue, use it to read per-thread counters (see RenderQueue::get_counters())
+	static const RenderQueue& get_queue()
+		{ assert(queue); return *queue; }
+
 	static bool subsys_init()
 	{
 		initialize();
@@ -76,8 +76,21 @@ using namespace rendering;
 
 /* === M E T H O D S ======================================================= */
 
-RenderQueue::RenderQueue(): started(false) { start(); }
-RenderQueue::~RenderQueue() { stop(); }
+RenderQueue::RenderQueue():
+	ready_count(0),
+	gl_ready_count(0),
+	sleeping(0),
+	gl_sleeping(0),
+	next_lane(0),
+	started(false)
+{ start(); }
+
+RenderQueue::~RenderQueue()
+{
+	stop();
+	for(LaneList::iterator i = lanes.begin(); i != lanes.end(); ++i)
+		delete *i;
+}
 
 void
 RenderQueue::start()
@@ -100,12 +113,25 @@ RenderQueue::start()
 	if (count > SYNFIG_RENDERING_MAX_THREADS) count = SYNFIG_RENDERING_MAX_THREADS;
 	if (count < 2) count = 2;
 
+	// lanes should be ready before threads will started
+	if (lanes.empty())
+	{
+		lanes.reserve(count);
+		for(int i = 0; i < count; ++i)
+		{
+			Lane *lane = new Lane();
+			lane->counters.thread_index = i;
+			lane->counters.gl = i == 0;
+			lanes.push_back(lane);
+		}
+	}
+
+	started = true;
 	for(int i = 0; i < count; ++i)
 		threads.push_back(
 			Glib::Threads::Thread::create(
 				sigc::bind(sigc::mem_fun(*this, &RenderQueue::process), i) ));
 	info("rendering threads %d", count);
-	started = true;
 }
 
 void
@@ -165,70 +191,186 @@ RenderQueue::process(int thread_index)
 	}
 }
 
+bool
+RenderQueue::is_gl_task(const Task::Handle &task)
+{
+#ifdef WITH_OPENGL
+	return task.type_is<TaskGL>();
+#else
+	(void)task;
+	return false;
+#endif
+}
+
+int
+RenderQueue::choose_lane(bool gl)
+{
+	if (gl) return 0;
+	// spread tasks from outside of worker threads over all worker lanes
+	int workers = (int)lanes.size() - 1;
+	int index = g_atomic_int_add(&next_lane, 1);
+	return 1 + (int)((unsigned int)index % (unsigned int)workers);
+}
+
+void
+RenderQueue::push(int lane_index, const Task::Handle &task)
+{
+	Lane &lane = *lanes[lane_index];
+	Glib::Threads::Mutex::Lock lock(lane.mutex);
+	lane.tasks.push_back(task);
+	lane.counters.queue_depth = (int)lane.tasks.size();
+	if (lane.counters.max_queue_depth < lane.counters.queue_depth)
+		lane.counters.max_queue_depth = lane.counters.queue_depth;
+}
+
+void
+RenderQueue::wake(bool gl, int count, int signals)
+{
+	if (count <= 0) return;
+
+	// ready counter should be increased before checking of sleeping threads,
+	// and get() increases sleeping counter before checking of ready counter,
+	// so at least one side always sees the changes of other side
+	g_atomic_int_add(gl ? &gl_ready_count : &ready_count, count);
+	if (signals > 0 && g_atomic_int_get(gl ? &gl_sleeping : &sleeping) > 0)
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		if (gl)
+			condgl.signal();
+		else
+		if (signals == 1)
+			cond.signal();
+		else
+			cond.broadcast();
+	}
+}
+
+Task::Handle
+RenderQueue::take(int thread_index)
+{
+	Lane &own = *lanes[thread_index];
+
+	// OpenGL thread processes own tasks in order
+	if (own.counters.gl)
+	{
+		Glib::Threads::Mutex::Lock lock(own.mutex);
+		if (own.tasks.empty()) return Task::Handle();
+		Task::Handle task = own.tasks.front();
+		own.tasks.pop_front();
+		own.counters.queue_depth = (int)own.tasks.size();
+		g_atomic_int_add(&gl_ready_count, -1);
+		return task;
+	}
+
+	// take last pushed task from own lane, it's dependencies most likely still in cache
+	{
+		Glib::Threads::Mutex::Lock lock(own.mutex);
+		if (!own.tasks.empty())
+		{
+			Task::Handle task = own.tasks.back();
+			own.tasks.pop_back();
+			own.counters.queue_depth = (int)own.tasks.size();
+			g_atomic_int_add(&ready_count, -1);
+			return task;
+		}
+	}
+
+	// nothing to do, try to steal the oldest task from other worker lanes
+	if (g_atomic_int_get(&ready_count) <= 0) return Task::Handle();
+	int workers = (int)lanes.size() - 1;
+	for(int i = 1; i < workers; ++i)
+	{
+		Lane &victim = *lanes[1 + (thread_index - 1 + i) % workers];
+		Glib::Threads::Mutex::Lock lock(victim.mutex);
+		if (!victim.tasks.empty())
+		{
+			Task::Handle task = victim.tasks.front();
+			victim.tasks.pop_front();
+			victim.counters.queue_depth = (int)victim.tasks.size();
+			g_atomic_int_add(&ready_count, -1);
+			lock.release();
+
+			Glib::Threads::Mutex::Lock own_lock(own.mutex);
+			++own.counters.tasks_stolen;
+			return task;
+		}
+	}
+
+	return Task::Handle();
+}
+
 void
 RenderQueue::done(int thread_index, const Task::Handle &task)
 {
 	assert(task);
-	bool found = false;
-	Glib::Threads::Mutex::Lock lock(mutex);
+
+	bool gl_thread = thread_index == 0;
+	int count = 0;
+	int gl_count = 0;
 	for(Task::Set::iterator i = task->back_deps.begin(); i != task->back_deps.end(); ++i)
 	{
 		assert(*i);
-		--(*i)->deps_count;
-		if ((*i)->deps_count == 0)
+		// failure is passed to dependent tasks,
+		// so the last task of list knows whether the whole list succeeded
+		if (!task->success)
+			(*i)->success = false;
+		if (g_atomic_int_dec_and_test(&(*i)->deps_count))
 		{
-#ifdef WITH_OPENGL
-			bool gl = i->type_is<TaskGL>();
-#else
-			bool gl = false;
-#endif
-			TaskQueue &queue = gl ? gl_ready_tasks     : ready_tasks;
-			TaskSet   &wait  = gl ? gl_not_ready_tasks : not_ready_tasks;
-			wait.erase(*i);
-			queue.push_back(*i);
-
-			// current process will take one task,
-			// so we don't need to call signal by first time
-			if (!found)
-				found = true;
-			else
-				(gl ? condgl : cond).signal();
+			// keep ready tasks in local lane, other threads will steal them if they are idle
+			bool gl = is_gl_task(*i);
+			push(gl ? 0 : gl_thread ? choose_lane(false) : thread_index, *i);
+			++(gl ? gl_count : count);
 		}
 	}
 	task->back_deps.clear();
-	assert( tasks_in_process.count(thread_index) == 1 );
-	tasks_in_process.erase(thread_index);
-	//info("rendering threads used %d", tasks_in_process.size());
+
+	{
+		Lane &lane = *lanes[thread_index];
+		Glib::Threads::Mutex::Lock lock(lane.mutex);
+		++lane.counters.tasks_done;
+	}
+
+	// current thread will take one task,
+	// so we don't need to wake up other thread for it
+	wake(true, gl_count, gl_thread ? gl_count - 1 : gl_count);
+	wake(false, count, gl_thread ? count : count - 1);
 }
 
 Task::Handle
 RenderQueue::get(int thread_index)
 {
-	Glib::Threads::Mutex::Lock lock(mutex);
+	bool gl = thread_index == 0;
+	volatile gint &ready = gl ? gl_ready_count : ready_count;
+	volatile gint &sleep = gl ? gl_sleeping : sleeping;
 
-	TaskQueue &queue  = thread_index == 0 ? gl_ready_tasks     : ready_tasks;
-	TaskQueue &queue2 = thread_index != 0 ? gl_ready_tasks     : ready_tasks;
-	TaskSet   &wait   = thread_index == 0 ? gl_not_ready_tasks : not_ready_tasks;
-	while(started)
+	while(true)
 	{
-		if (!queue.empty())
-		{
-			Task::Handle task = queue.front();
-			queue.pop_front();
-			assert( tasks_in_process.count(thread_index) == 0 );
-			tasks_in_process[thread_index] = task;
-			//info("rendering threads used %d", tasks_in_process.size());
+		if (Task::Handle task = take(thread_index))
 			return task;
+
+		Glib::Threads::Mutex::Lock lock(mutex);
+		if (!started) break;
+
+		g_atomic_int_inc(&sleep);
+		if (g_atomic_int_get(&ready) > 0)
+		{
+			// task was pushed while we looked for it, try again
+			g_atomic_int_add(&sleep, -1);
+			continue;
 		}
 
 		#ifdef DEBUG_THREAD_WAIT
-		if (!wait.empty())
-			info("thread %d: rendering wait for task", thread_index);
+		info("thread %d: rendering wait for task", thread_index);
 		#endif
 
-		assert( wait.empty() || !tasks_in_process.empty() || !queue2.empty() );
+		gint64 wait_begin = g_get_monotonic_time();
+		(gl ? condgl : cond).wait(mutex);
+		g_atomic_int_add(&sleep, -1);
+		lock.release();
 
-		(thread_index ? cond : condgl).wait(mutex);
+		Lane &lane = *lanes[thread_index];
+		Glib::Threads::Mutex::Lock lane_lock(lane.mutex);
+		lane.counters.idle_time += g_get_monotonic_time() - wait_begin;
 	}
 	return Task::Handle();
 }
@@ -246,7 +388,7 @@ RenderQueue::fix_task(const Task &task, const Task::RunParams &params)
 int
 RenderQueue::get_threads_count() const
 {
-	return threads.size();
+	return lanes.size();
 }
 
 void
@@ -254,22 +396,11 @@ RenderQueue::enqueue(const Task::Handle &task, const Task::RunParams &params)
 {
 	if (!task) return;
 	fix_task(*task, params);
-	Glib::Threads::Mutex::Lock lock(mutex);
-
-#ifdef WITH_OPENGL
-	bool gl = task.type_is<TaskGL>();
-#else
-	bool gl = false;
-#endif
-	TaskQueue &queue = gl ? gl_ready_tasks     : ready_tasks;
-	TaskSet   &wait  = gl ? gl_not_ready_tasks : not_ready_tasks;
-	if (task->deps_count == 0) {
-		queue.push_back(task);
-		(gl ? condgl : cond).signal();
-	}
-	else
+	if (task->deps_count == 0)
 	{
-		wait.insert(task);
+		bool gl = is_gl_task(task);
+		push(choose_lane(gl), task);
+		wake(gl, 1, 1);
 	}
 }
 
@@ -278,53 +409,71 @@ RenderQueue::enqueue(const Task::List &tasks, const Task::RunParams &params)
 {
 	Task::RunParams p(params);
 	p.sub_queue.clear();
-	int count = 0;
-	for(Task::List::const_iterator i = tasks.begin(); i != tasks.end(); ++i)
-		if (*i) { fix_task(**i, p); ++count; }
-	if (!count) return;
 
-	Glib::Threads::Mutex::Lock lock(mutex);
-	int glsignals = 0;
-	int signals = 0;
-	int threads = get_threads_count() - 1;
+	// collect ready tasks before pushing of any of them,
+	// because pushed tasks may be done and may change deps_count of others
+	Task::List ready;
 	for(Task::List::const_iterator i = tasks.begin(); i != tasks.end(); ++i)
-	{
 		if (*i)
 		{
-#ifdef WITH_OPENGL
-			bool gl = i->type_is<TaskGL>();
-#else
-			bool gl = false;
-#endif
-			TaskQueue &queue = gl ? gl_ready_tasks     : ready_tasks;
-			TaskSet   &wait  = gl ? gl_not_ready_tasks : not_ready_tasks;
-			if ((*i)->deps_count == 0) {
-				queue.push_back(*i);
-				if (gl)
-				{
-					if (glsignals < 1) { condgl.signal(); ++glsignals; }
-				}
-				else
-				{
-					if (signals < threads) { cond.signal(); ++signals; }
-				}
-			}
-			else
-			{
-				wait.insert(*i);
-			}
+			fix_task(**i, p);
+			if ((*i)->deps_count == 0)
+				ready.push_back(*i);
 		}
+	if (ready.empty()) return;
+
+	int count = 0;
+	int gl_count = 0;
+	for(Task::List::const_iterator i = ready.begin(); i != ready.end(); ++i)
+	{
+		bool gl = is_gl_task(*i);
+		push(choose_lane(gl), *i);
+		++(gl ? gl_count : count);
 	}
+
+	wake(true, gl_count, gl_count);
+	wake(false, count, count);
 }
 
 void
 RenderQueue::clear()
 {
-	Glib::Threads::Mutex::Lock lock(mutex);
-	ready_tasks.clear();
-	gl_ready_tasks.clear();
-	not_ready_tasks.clear();
-	gl_not_ready_tasks.clear();
+	for(LaneList::iterator i = lanes.begin(); i != lanes.end(); ++i)
+	{
+		Glib::Threads::Mutex::Lock lock((*i)->mutex);
+		g_atomic_int_add((*i)->counters.gl ? &gl_ready_count : &ready_count, -(int)(*i)->tasks.size());
+		(*i)->tasks.clear();
+		(*i)->counters.queue_depth = 0;
+	}
+}
+
+RenderQueue::CountersList
+RenderQueue::get_counters() const
+{
+	CountersList list;
+	list.reserve(lanes.size());
+	for(LaneList::const_iterator i = lanes.begin(); i != lanes.end(); ++i)
+	{
+		Glib::Threads::Mutex::Lock lock((*i)->mutex);
+		list.push_back((*i)->counters);
+	}
+	return list;
+}
+
+void
+RenderQueue::log_counters(const String &logfile) const
+{
+	CountersList list = get_counters();
+	for(CountersList::const_iterator i = list.begin(); i != list.end(); ++i)
+		debug::Log::info(logfile,
+			"rendering thread %d%s: tasks %lld, stolen %lld, idle %.3fs, queue depth %d (max %d)",
+			i->thread_index,
+			i->gl ? " (gl)" : "",
+			i->tasks_done,
+			i->tasks_stolen,
+			(double)i->idle_time*1e-6,
+			i->queue_depth,
+			i->max_queue_depth );
 }
 
 /* === E N T R Y P O I N T ================================================= */
@@ -29,7 +29,9 @@
 
 #include <cstdio>
 
-#include <map>
+#include <deque>
+#include <list>
+#include <vector>
 
 #include <glibmm/threads.h>
 
@@ -50,9 +52,26 @@ class RenderQueue
 {
 public:
 	typedef std::list<Glib::Threads::Thread*> ThreadList;
-	typedef std::map<int, Task::Handle> ThreadTaskMap;
 	typedef std::set<Task::Handle> TaskSet;
-	typedef std::list<Task::Handle> TaskQueue;
+	typedef std::deque<Task::Handle> TaskQueue;
+
+	//! Statistics of one rendering thread, see get_counters()
+	struct ThreadCounters
+	{
+		int thread_index;
+		bool gl;                 //!< thread reserved for OpenGL tasks
+		long long tasks_done;
+		long long tasks_stolen;  //!< tasks taken from queues of other threads
+		long long idle_time;     //!< microseconds spent waiting for tasks
+		int queue_depth;         //!< tasks currently waiting in the local queue
+		int max_queue_depth;
+
+		ThreadCounters():
+			thread_index(), gl(), tasks_done(), tasks_stolen(),
+			idle_time(), queue_depth(), max_queue_depth() { }
+	};
+
+	typedef std::vector<ThreadCounters> CountersList;
 
 private:
 	class TaskSubQueue: public Task
@@ -66,20 +85,35 @@ private:
 		Task::Handle& sub_task() { return Task::sub_task(0); }
 	};
 
+	//! Local deque of ready tasks owned by one thread.
+	//! Owner pushes and pops from the back, other threads steals from the front.
+	class Lane
+	{
+	public:
+		Glib::Threads::Mutex mutex;
+		TaskQueue tasks;
+		ThreadCounters counters;
+	};
+
+	typedef std::vector<Lane*> LaneList;
+
+	// mutex and conditions used only to sleep and to wake up idle threads
 	Glib::Threads::Mutex mutex;
-	Glib::Threads::Mutex threads_mutex;
 	Glib::Threads::Cond cond;
 	Glib::Threads::Cond condgl;
 
-	TaskQueue ready_tasks;
-	TaskQueue gl_ready_tasks;
-	TaskSet not_ready_tasks;
-	TaskSet gl_not_ready_tasks;
+	// lane 0 is dedicated to OpenGL thread, it never steals and never robbed
+	LaneList lanes;
+
+	volatile gint ready_count;
+	volatile gint gl_ready_count;
+	volatile gint sleeping;
+	volatile gint gl_sleeping;
+	volatile gint next_lane;
 
 	bool started;
 
 	ThreadList threads;
-	ThreadTaskMap tasks_in_process;
 
 	void start();
 	void stop();
@@ -88,7 +122,13 @@ private:
 	void done(int thread_index, const Task::Handle &task);
 	Task::Handle get(int thread_index);
 
+	Task::Handle take(int thread_index);
+	int choose_lane(bool gl);
+	void push(int lane_index, const Task::Handle &task);
+	void wake(bool gl, int count, int signals);
+
 	static void fix_task(const Task &task, const Task::RunParams &params);
+	static bool is_gl_task(const Task::Handle &task);
 
 public:
 	RenderQueue();
@@ -98,6 +138,9 @@ public:
 	void enqueue(const Task::Handle &task, const Task::RunParams &params);
 	void enqueue(const Task::List &tasks, const Task::RunParams &params);
 	void clear();
+
+	CountersList get_counters() const;
+	void log_counters(const String &logfile) const;
 };
 
 } /* end namespace rendering */
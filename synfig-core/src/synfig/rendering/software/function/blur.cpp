@@ -303,23 +303,30 @@ void
 software::Blur::blur_fft(const Params &params)
 {
 	// init
+	// convolution with real pattern keeps real and imaginary parts separated,
+	// so two real channels are packed into one complex value,
+	// and each FFT processes two channels at once
 	const int channels = 4;
+	const int pairs = channels/2;
 	int rows = FFT::get_valid_count(params.src_rect.get_size()[1]);
 	int cols = FFT::get_valid_count(params.src_rect.get_size()[0]);
-	vector<Complex> surface(rows*cols*channels);
+	vector<Complex> surface(rows*cols*pairs);
 	vector<Complex> full_pattern;
 	vector<Complex> row_pattern;
 	vector<Complex> col_pattern;
 	bool full = false;
 	bool cross = false;
 
-	Array<Real, 4> arr_surface((Real*)&surface.front());
-
+	Array<Real, 3> arr_surface((Real*)&surface.front());
 	arr_surface
-		.set_dim(rows, cols*channels*2)
-		.set_dim(cols, channels*2)
-		.set_dim(channels, 2)
-		.set_dim(2, 1);
+		.set_dim(rows, cols*channels)
+		.set_dim(cols, channels)
+		.set_dim(channels, 1);
+	Array<Complex, 3> arr_surface_pairs(&surface.front());
+	arr_surface_pairs
+		.set_dim(pairs, 1)
+		.set_dim(rows, cols*pairs)
+		.set_dim(cols, pairs);
 	Array<Real, 3> arr_full_pattern;
 	arr_full_pattern
 		.set_dim(rows, 2*cols)
@@ -335,7 +342,7 @@ software::Blur::blur_fft(const Params &params)
 		.set_dim(2, 1);
 
 	// convert surface to complex
-	BlurTemplates::surface_read(arr_surface.reorder(0, 1, 2), *params.src, VectorInt(0, 0), params.src_rect);
+	BlurTemplates::surface_read(arr_surface, *params.src, VectorInt(0, 0), params.src_rect);
 
 	// alloc memory
 	switch(params.type)
@@ -394,12 +401,10 @@ software::Blur::blur_fft(const Params &params)
 		BlurTemplates::normalize_full_pattern_2d( arr_full_pattern.reorder(0, 1) );
 
 		FFT::fft2d(arr_full_pattern.group_items<Complex>(), false);
-		for(Array<Complex, 3>::Iterator channel(arr_surface.group_items<Complex>().reorder(2, 0, 1)); channel; ++channel)
-		{
-			FFT::fft2d(*channel, false);
-			channel->process< std::multiplies<Complex> >(arr_full_pattern.group_items<Complex>());
-			FFT::fft2d(*channel, true);
-		}
+		FFT::batch_fft2d(arr_surface_pairs, false);
+		for(Array<Complex, 3>::Iterator pair(arr_surface_pairs); pair; ++pair)
+			pair->process< std::multiplies<Complex> >(arr_full_pattern.group_items<Complex>());
+		FFT::batch_fft2d(arr_surface_pairs, true);
 	}
 	else
 	{
@@ -409,7 +414,7 @@ software::Blur::blur_fft(const Params &params)
 		BlurTemplates::normalize_full_pattern( arr_col_pattern.reorder(0) );
 
 		vector<Complex> surface_copy;
-		Array<Complex, 3> arr_surface_rows(arr_surface.group_items<Complex>().reorder(2, 0, 1));
+		Array<Complex, 3> arr_surface_rows(arr_surface_pairs);
 		Array<Complex, 3> arr_surface_cols(arr_surface_rows.reorder(0, 2, 1));
 
 		if (cross)
@@ -421,37 +426,33 @@ software::Blur::blur_fft(const Params &params)
 		}
 
 		FFT::fft(arr_row_pattern.group_items<Complex>(), false);
-		for(Array<Complex, 3>::Iterator channel(arr_surface_rows); channel; ++channel)
-		{
-			FFT::fft2d(*channel, false, true, false);
-			for(Array<Complex, 2>::Iterator r(*channel); r; ++r)
+		FFT::batch_fft2d(arr_surface_rows, false, true, false);
+		for(Array<Complex, 3>::Iterator pair(arr_surface_rows); pair; ++pair)
+			for(Array<Complex, 2>::Iterator r(*pair); r; ++r)
 				r->process< std::multiplies<Complex> >(arr_row_pattern.group_items<Complex>());
-			FFT::fft2d(*channel, true, true, false);
-		}
+		FFT::batch_fft2d(arr_surface_rows, true, true, false);
 
 		FFT::fft(arr_col_pattern.group_items<Complex>(), false);
-		for(Array<Complex, 3>::Iterator channel(arr_surface_cols); channel; ++channel)
-		{
-			FFT::fft2d(*channel, false, true, false);
-			for(Array<Complex, 2>::Iterator c(*channel); c; ++c)
+		FFT::batch_fft2d(arr_surface_cols, false, true, false);
+		for(Array<Complex, 3>::Iterator pair(arr_surface_cols); pair; ++pair)
+			for(Array<Complex, 2>::Iterator c(*pair); c; ++c)
 				c->process< std::multiplies<Complex> >(arr_col_pattern.group_items<Complex>());
-			FFT::fft2d(*channel, true, true, false);
-		}
+		FFT::batch_fft2d(arr_surface_cols, true, true, false);
 
-		arr_surface_rows.process< BlurTemplates::Abs<Complex> >();
+		arr_surface.process< BlurTemplates::Abs<Real> >();
 		if (cross)
 		{
-			arr_surface_cols.process< BlurTemplates::Abs<Complex> >();
-			arr_surface_rows.split_items<Real>().reorder(0, 1, 2)
-				.process< std::plus<Real> >(
-					arr_surface_cols.split_items<Real>().reorder(0, 2, 1) );
+			Array<Real, 3> arr_surface_copy(arr_surface);
+			arr_surface_copy.pointer = (Real*)&surface_copy.front();
+			arr_surface_copy.process< BlurTemplates::Abs<Real> >();
+			arr_surface.process< std::plus<Real> >(arr_surface_copy);
 		}
 	}
 
 	// convert surface from complex to color
 	BlurTemplates::surface_write(
 		*params.dest,
-		arr_surface.reorder(0, 1, 2),
+		arr_surface,
 		params.dest_rect,
 		params.offset,
 		params.blend,
@@ -28,6 +28,8 @@
 /* === H E A D E R S ======================================================= */
 
 #include <cassert>
+#include <cmath>
+#include <complex>
 
 #include <algorithm>
 #include <deque>
@@ -66,7 +68,7 @@ public:
 
 
 	template<typename T>
-	struct Abs { T operator() (const T &x) { return abs(x); } };
+	struct Abs { T operator() (const T &x) { using std::abs; return abs(x); } };
 
 	template<typename T>
 	static T gauss(const T &x, const T &r)
@@ -37,15 +37,19 @@
 
 #include <cassert>
 #include <climits>
+#include <cstdlib>
 //#include <ccomplex>
 
 #include <glibmm/thread.h>
 
 #include <vector>
 #include <set>
+#include <map>
 
 #include <fftw3.h>
 
+#include <synfig/general.h>
+
 #include "fft.h"
 
 #endif
@@ -64,12 +68,115 @@ using namespace rendering;
 class software::FFT::Internal
 {
 public:
+	//! FFTW plans are reused for the same dimensions, strides, direction and alignment
+	typedef std::vector<int> PlanKey;
+	typedef std::map<PlanKey, fftw_plan> PlanMap;
+
+	//! plans are not evicted from cache while it may be executing in other thread,
+	//! so just stop to cache new plans when this limit is reached
+	static const size_t max_plans = 256;
+
 	static std::set<int> counts;
+	//! guards FFTW planner and plans cache,
+	//! execution of plans (fftw_execute_dft) is thread-safe
 	static Glib::Mutex mutex;
+	static PlanMap plans;
+	static unsigned int planner_flags;
+	static String wisdom_filename;
+	static bool wisdom_changed;
+
+	static void add_key(PlanKey &key, int count, const fftw_iodim *dims)
+	{
+		key.push_back(count);
+		for(int i = 0; i < count; ++i)
+		{
+			key.push_back(dims[i].n);
+			key.push_back(dims[i].is);
+			key.push_back(dims[i].os);
+		}
+	}
+
+	static fftw_plan create_plan(
+		int rank, const fftw_iodim *dims,
+		int howmany_rank, const fftw_iodim *howmany_dims,
+		Complex *data, bool invert )
+	{
+		const int sign = invert ? FFTW_BACKWARD : FFTW_FORWARD;
+
+		// FFTW_ESTIMATE don't touch data while planning
+		if (planner_flags & FFTW_ESTIMATE)
+			return fftw_plan_guru_dft(
+				rank, dims, howmany_rank, howmany_dims,
+				(fftw_complex*)data, (fftw_complex*)data,
+				sign, planner_flags );
+
+		// other planners overwrite data, so use temporary buffer
+		// with same layout and same alignment
+		ptrdiff_t size = 1;
+		for(int i = 0; i < rank; ++i)
+			size += (dims[i].n - 1)*(ptrdiff_t)std::abs(dims[i].is);
+		for(int i = 0; i < howmany_rank; ++i)
+			size += (howmany_dims[i].n - 1)*(ptrdiff_t)std::abs(howmany_dims[i].is);
+
+		const int alignment = fftw_alignment_of((double*)data);
+		char *buffer = (char*)fftw_malloc(size*sizeof(fftw_complex) + alignment);
+		fftw_plan plan = fftw_plan_guru_dft(
+			rank, dims, howmany_rank, howmany_dims,
+			(fftw_complex*)(buffer + alignment), (fftw_complex*)(buffer + alignment),
+			sign, planner_flags );
+		fftw_free(buffer);
+
+		wisdom_changed = true;
+		return plan;
+	}
+
+	static void execute(
+		int rank, const fftw_iodim *dims,
+		int howmany_rank, const fftw_iodim *howmany_dims,
+		Complex *data, bool invert )
+	{
+		PlanKey key;
+		key.reserve(3*(rank + howmany_rank) + 4);
+		add_key(key, rank, dims);
+		add_key(key, howmany_rank, howmany_dims);
+		key.push_back(invert);
+		key.push_back(fftw_alignment_of((double*)data));
+
+		fftw_plan plan = NULL;
+		bool cached = true;
+		{
+			Glib::Mutex::Lock lock(mutex);
+			PlanMap::const_iterator i = plans.find(key);
+			if (i != plans.end())
+			{
+				plan = i->second;
+			}
+			else
+			{
+				plan = create_plan(rank, dims, howmany_rank, howmany_dims, data, invert);
+				if (plans.size() < max_plans)
+					plans[key] = plan;
+				else
+					cached = false;
+			}
+		}
+
+		fftw_execute_dft(plan, (fftw_complex*)data, (fftw_complex*)data);
+
+		if (!cached)
+		{
+			Glib::Mutex::Lock lock(mutex);
+			fftw_destroy_plan(plan);
+		}
+	}
 };
 
 std::set<int> software::FFT::Internal::counts;
 Glib::Mutex software::FFT::Internal::mutex;
+software::FFT::Internal::PlanMap software::FFT::Internal::plans;
+unsigned int software::FFT::Internal::planner_flags = FFTW_ESTIMATE;
+String software::FFT::Internal::wisdom_filename;
+bool software::FFT::Internal::wisdom_changed = false;
 
 void
 software::FFT::initialize()
@@ -83,15 +190,59 @@ software::FFT::initialize()
 			for(int c5 = c3; c5 < max5; c5 *= 5)
 				for(int c7 = c5; c7 < max7; c7 *= 7)
 					Internal::counts.insert(c7);
-	fftw_set_timelimit(0.0);
+
+	Glib::Mutex::Lock lock(Internal::mutex);
+
+	Internal::planner_flags = FFTW_ESTIMATE;
+	if (const char *s = getenv("SYNFIG_FFTW_PLANNER"))
+	{
+		String planner(s);
+		if (planner == "measure")    Internal::planner_flags = FFTW_MEASURE;    else
+		if (planner == "patient")    Internal::planner_flags = FFTW_PATIENT;    else
+		if (planner == "exhaustive") Internal::planner_flags = FFTW_EXHAUSTIVE; else
+		if (planner != "estimate")
+			warning("SYNFIG_FFTW_PLANNER: unknown planner '%s', use 'estimate'", s);
+	}
+	// estimating planner should not spend any time for planning,
+	// measuring planners keep the default unlimited time
+	if (Internal::planner_flags & FFTW_ESTIMATE)
+		fftw_set_timelimit(0.0);
+
+	Internal::wisdom_changed = false;
+	Internal::wisdom_filename.clear();
+	if (const char *s = getenv("SYNFIG_FFTW_WISDOM"))
+	{
+		Internal::wisdom_filename = s;
+		if (!fftw_import_wisdom_from_filename(s))
+			info("FFT: cannot import wisdom from '%s'", s);
+	}
 }
 
 void
 software::FFT::deinitialize()
 {
+	{
+		Glib::Mutex::Lock lock(Internal::mutex);
+		for(Internal::PlanMap::iterator i = Internal::plans.begin(); i != Internal::plans.end(); ++i)
+			fftw_destroy_plan(i->second);
+		Internal::plans.clear();
+
+		if (Internal::wisdom_changed && !Internal::wisdom_filename.empty())
+			if (!fftw_export_wisdom_to_filename(Internal::wisdom_filename.c_str()))
+				warning("FFT: cannot export wisdom to '%s'", Internal::wisdom_filename.c_str());
+		Internal::wisdom_changed = false;
+	}
 	Internal::counts.clear();
 }
 
+unsigned int
+software::FFT::get_planner_flags()
+	{ return Internal::planner_flags; }
+
+const String&
+software::FFT::get_wisdom_filename()
+	{ return Internal::wisdom_filename; }
+
 int
 software::FFT::get_valid_count(int x)
 {
@@ -123,15 +274,7 @@ software::FFT::fft(const Array<Complex, 1> &x, bool invert)
 	iodim.is = x.stride;
 	iodim.os = x.stride;
 
-	{
-		Glib::Mutex::Lock lock(Internal::mutex);
-		fftw_plan plan = fftw_plan_guru_dft(
-			1, &iodim, 0, NULL,
-			(fftw_complex*)x.pointer, (fftw_complex*)x.pointer,
-			invert ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_ESTIMATE );
-		fftw_execute(plan);
-		fftw_destroy_plan(plan);
-	}
+	Internal::execute(1, &iodim, 0, NULL, x.pointer, invert);
 
 	// divide by count to complete back-FFT
 	if (invert)
@@ -141,50 +284,49 @@ software::FFT::fft(const Array<Complex, 1> &x, bool invert)
 void
 software::FFT::fft2d(const Array<Complex, 2> &x, bool invert, bool do_rows, bool do_cols)
 {
-	if (x.count == 0 || x.sub().count == 0) return;
-	if ( (!do_cols || x.count == 1)
-	  && (!do_rows || x.sub().count == 1) )
+	Array<Complex, 3> batch(x.pointer, 1, 0, x);
+	batch_fft2d(batch, invert, do_rows, do_cols);
+}
+
+void
+software::FFT::batch_fft2d(const Array<Complex, 3> &x, bool invert, bool do_rows, bool do_cols)
+{
+	const Array<Complex, 2> &x2d = x.sub();
+	if (x.count == 0 || x2d.count == 0 || x2d.sub().count == 0) return;
+	if ( (!do_cols || x2d.count == 1)
+	  && (!do_rows || x2d.sub().count == 1) )
 		return;
 
-	assert(is_valid_count(x.count) && is_valid_count(x.sub().count));
+	assert(is_valid_count(x2d.count) && is_valid_count(x2d.sub().count));
 
 	if (!do_rows && !do_cols) return;
 
-	fftw_iodim iodim[2];
-	iodim[0].n  = x.sub().count;
-	iodim[0].is = x.sub().stride;
-	iodim[0].os = x.sub().stride;
-	iodim[1].n  = x.count;
-	iodim[1].is = x.stride;
-	iodim[1].os = x.stride;
-
+	fftw_iodim iodim[3];
+	iodim[0].n  = x2d.sub().count;
+	iodim[0].is = x2d.sub().stride;
+	iodim[0].os = x2d.sub().stride;
+	iodim[1].n  = x2d.count;
+	iodim[1].is = x2d.stride;
+	iodim[1].os = x2d.stride;
+	iodim[2].n  = x.count;
+	iodim[2].is = x.stride;
+	iodim[2].os = x.stride;
+
+	if (do_rows && do_cols)
 	{
-		Glib::Mutex::Lock lock(Internal::mutex);
-
-		fftw_plan plan;
-		if (do_rows && do_cols)
-		{
-			plan = fftw_plan_guru_dft(
-				2, iodim, 0, NULL,
-				(fftw_complex*)x.pointer, (fftw_complex*)x.pointer,
-				invert ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_ESTIMATE );
-		}
-		else
-		{
-			plan = fftw_plan_guru_dft(
-				1, &iodim[do_rows ? 0 : 1], 1, &iodim[do_rows ? 1 : 0],
-				(fftw_complex*)x.pointer, (fftw_complex*)x.pointer,
-				invert ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_ESTIMATE );
-		}
-		fftw_execute(plan);
-		fftw_destroy_plan(plan);
+		Internal::execute(2, iodim, 1, &iodim[2], x.pointer, invert);
+	}
+	else
+	{
+		fftw_iodim howmany_iodim[2] = { iodim[do_rows ? 1 : 0], iodim[2] };
+		Internal::execute(1, &iodim[do_rows ? 0 : 1], 2, howmany_iodim, x.pointer, invert);
 	}
 
 	// divide by count to complete back-FFT
 	if (invert)
 	{
-		int count = (do_cols ? x.count : 1)
-			      * (do_rows ? x.sub().count : 1);
+		int count = (do_cols ? x2d.count : 1)
+			      * (do_rows ? x2d.sub().count : 1);
 		x.process< std::multiplies<Complex> >( Complex(1.0/(Real)count) );
 	}
 }
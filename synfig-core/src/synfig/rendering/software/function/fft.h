@@ -29,6 +29,7 @@
 
 #include "array.h"
 #include <synfig/complex.h>
+#include <synfig/string.h>
 
 /* === M A C R O S ========================================================= */
 
@@ -54,6 +55,14 @@ public:
 
 	static void fft(const Array<Complex, 1> &x, bool invert);
 	static void fft2d(const Array<Complex, 2> &x, bool invert, bool do_rows = true, bool do_cols = true);
+	//! transforms each of x[i] as separate 2d-array, all of them by single call of FFTW
+	static void batch_fft2d(const Array<Complex, 3> &x, bool invert, bool do_rows = true, bool do_cols = true);
+
+	//! FFTW planner flags, see SYNFIG_FFTW_PLANNER environment variable
+	static unsigned int get_planner_flags();
+	//! file to load FFTW wisdom at initialize() and to save it at deinitialize(),
+	//! see SYNFIG_FFTW_WISDOM environment variable
+	static const String& get_wisdom_filename();
 
 	static void initialize();
 	static void deinitialize();
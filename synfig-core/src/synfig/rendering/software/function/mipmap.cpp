@@ -0,0 +1,162 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/mipmap.cpp
+**	\brief Mipmap
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <algorithm>
+
+#include "mipmap.h"
+#include "packedsurface.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+using namespace software;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	class SurfaceReader
+	{
+	private:
+		const synfig::Surface &surface;
+	public:
+		explicit SurfaceReader(const synfig::Surface &surface): surface(surface) { }
+		Color operator()(int x, int y) const { return surface[y][x]; }
+	};
+
+	class PackedSurfaceReader
+	{
+	private:
+		PackedSurface::Reader reader;
+		PackedSurfaceReader(const PackedSurfaceReader&); // non-copyable
+	public:
+		explicit PackedSurfaceReader(const PackedSurface &surface): reader(surface) { }
+		Color operator()(int x, int y) const { return reader.get_pixel(x, y); }
+	};
+
+	template<typename T>
+	void downscale_generic(synfig::Surface &dest, const T &reader, int width, int height)
+	{
+		const int w = Mipmap::get_level_size(width, 1);
+		const int h = Mipmap::get_level_size(height, 1);
+		dest.set_wh(w, h);
+
+		for(int y = 0; y < h; ++y)
+		{
+			const int y0 = 2*y;
+			const int y1 = std::min(y0 + 1, height - 1);
+			for(int x = 0; x < w; ++x)
+			{
+				const int x0 = 2*x;
+				const int x1 = std::min(x0 + 1, width - 1);
+				const Color c[] = { reader(x0, y0), reader(x1, y0), reader(x0, y1), reader(x1, y1) };
+
+				ColorReal r = 0, g = 0, b = 0, a = 0;
+				for(int i = 0; i < 4; ++i)
+				{
+					const ColorReal ca = c[i].get_a();
+					r += c[i].get_r()*ca;
+					g += c[i].get_g()*ca;
+					b += c[i].get_b()*ca;
+					a += ca;
+				}
+
+				dest[y][x] = std::fabs(a) > 1e-8
+				           ? Color(r/a, g/a, b/a, a*ColorReal(0.25))
+				           : Color(0, 0, 0, 0);
+			}
+		}
+	}
+}
+
+/* === M E T H O D S ======================================================= */
+
+int
+Mipmap::get_max_level(int width, int height)
+{
+	int level = 0;
+	while( level < MaxLevel
+	    && (get_level_size(width, level) > 1 || get_level_size(height, level) > 1) )
+		++level;
+	return level;
+}
+
+void
+Mipmap::downscale(synfig::Surface &dest, const synfig::Surface &src)
+{
+	if (!src.is_valid())
+		{ dest.set_wh(0, 0); return; }
+	downscale_generic(dest, SurfaceReader(src), src.get_w(), src.get_h());
+}
+
+void
+Mipmap::downscale(synfig::Surface &dest, const PackedSurface &src)
+{
+	if (src.get_width() <= 0 || src.get_height() <= 0)
+		{ dest.set_wh(0, 0); return; }
+	PackedSurfaceReader reader(src);
+	downscale_generic(dest, reader, src.get_width(), src.get_height());
+}
+
+int
+Mipmap::choose_level(const Matrix &transformation, int max_level)
+{
+	// count of pixels of surface per pixel of target along the less compressed axis
+	Real scale = std::max(transformation.get_axis_x().mag(), transformation.get_axis_y().mag());
+	if (!(scale > 0.0) || scale >= 0.5)
+		return 0;
+	int level = (int)std::floor(std::log(1.0/scale)/std::log(2.0) + 1e-6);
+	return std::max(0, std::min(level, max_level));
+}
+
+Matrix
+Mipmap::get_level_transformation(const Matrix &transformation, int level)
+{
+	Real k = (Real)(1 << level);
+	return Matrix().set_scale(k, k) * transformation;
+}
+
+RectInt
+Mipmap::get_level_bounds(const RectInt &bounds, int level)
+{
+	return RectInt(
+		bounds.minx >> level,
+		bounds.miny >> level,
+		bounds.maxx > 0 ? ((bounds.maxx - 1) >> level) + 1 : 0,
+		bounds.maxy > 0 ? ((bounds.maxy - 1) >> level) + 1 : 0 );
+}
+
+/* === E N T R Y P O I N T ================================================= */
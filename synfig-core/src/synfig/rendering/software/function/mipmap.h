@@ -0,0 +1,82 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/mipmap.h
+**	\brief Mipmap Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SOFTWARE_MIPMAP_H
+#define __SYNFIG_RENDERING_SOFTWARE_MIPMAP_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <synfig/matrix.h>
+#include <synfig/rect.h>
+#include <synfig/surface.h>
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+namespace software
+{
+
+class PackedSurface;
+
+//! Helpers for chains of downscaled copies of surface,
+//! level N is 2^N times smaller than the original surface (level 0)
+class Mipmap
+{
+public:
+	enum { MaxLevel = 15 };
+
+	//! Width or height of level
+	static int get_level_size(int size, int level)
+		{ return ((size - 1) >> level) + 1; }
+	//! Last level which is bigger than one pixel
+	static int get_max_level(int width, int height);
+
+	//! Averages premultiplied colors of 2x2 blocks of \a src,
+	//! \a dest gets size of next level of \a src
+	static void downscale(synfig::Surface &dest, const synfig::Surface &src);
+	static void downscale(synfig::Surface &dest, const PackedSurface &src);
+
+	//! Chooses level for sampling of surface with \a transformation
+	//! from pixels of surface to pixels of target
+	static int choose_level(const Matrix &transformation, int max_level);
+	//! Transformation from pixels of level to pixels of target
+	static Matrix get_level_transformation(const Matrix &transformation, int level);
+	//! Bounds in pixels of level
+	static RectInt get_level_bounds(const RectInt &bounds, int level);
+};
+
+} /* end namespace software */
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -40,9 +40,12 @@
 
 #include <vector>
 #include <map>
+#include <list>
+#include <utility>
 
 #include "packedsurface.h"
 
+#include <synfig/general.h>
 #include <synfig/real.h>
 #include <synfig/zstreambuf.h>
 
@@ -60,6 +63,137 @@ using namespace software;
 
 /* === M E T H O D S ======================================================= */
 
+//! Unpacked chunks shared by all readers of all surfaces,
+//! so chunks are unpacked once when surface is resampled by several threads.
+//! Cache is split into stripes with separate locks to reduce contention.
+class PackedSurface::ChunkCache
+{
+public:
+	enum { StripeCount = 16 };
+
+	typedef std::pair<long long, int> Key;
+
+private:
+	struct Stripe
+	{
+		typedef std::list< std::pair<Key, std::vector<char> > > List;
+		typedef std::map<Key, List::iterator> Map;
+
+		synfig::Mutex mutex;
+		List items; //!< most recently used chunks are at front
+		Map index;
+		size_t size;
+		long long hits;
+		long long misses;
+
+		Stripe(): size(), hits(), misses() { }
+
+		void erase(Map::iterator i)
+		{
+			size -= i->second->second.size();
+			items.erase(i->second);
+			index.erase(i);
+		}
+	};
+
+	static synfig::Mutex id_mutex;
+	static long long last_id;
+	static Stripe stripes[StripeCount];
+
+	static Stripe& stripe(const Key &key)
+		{ return stripes[(unsigned int)(key.first*31 + key.second) % StripeCount]; }
+
+	static size_t get_max_stripe_size()
+	{
+		static size_t max_stripe_size = get_max_size()/StripeCount;
+		return max_stripe_size;
+	}
+
+	static size_t get_max_size()
+	{
+		size_t max_size = 64*1024*1024;
+		if (const char *s = getenv("SYNFIG_PACK_IMAGES_CACHE_SIZE"))
+		{
+			// size in megabytes
+			int megabytes = atoi(s);
+			if (megabytes >= 0)
+				max_size = (size_t)megabytes*1024*1024;
+			else
+				warning("SYNFIG_PACK_IMAGES_CACHE_SIZE: invalid size '%s', use default", s);
+		}
+		return max_size;
+	}
+
+public:
+	static long long new_id()
+	{
+		synfig::Mutex::Lock lock(id_mutex);
+		return ++last_id;
+	}
+
+	//! copies unpacked chunk into dest, returns false if chunk is not cached
+	static bool get(const Key &key, void *dest, size_t size)
+	{
+		Stripe &s = stripe(key);
+		synfig::Mutex::Lock lock(s.mutex);
+		Stripe::Map::iterator i = s.index.find(key);
+		if (i == s.index.end() || i->second->second.size() != size)
+			{ ++s.misses; return false; }
+		++s.hits;
+		s.items.splice(s.items.begin(), s.items, i->second);
+		memcpy(dest, &i->second->second.front(), size);
+		return true;
+	}
+
+	static void put(const Key &key, const void *src, size_t size)
+	{
+		const size_t max_size = get_max_stripe_size();
+		if (size == 0 || size > max_size)
+			return;
+
+		Stripe &s = stripe(key);
+		synfig::Mutex::Lock lock(s.mutex);
+		Stripe::Map::iterator i = s.index.find(key);
+		if (i != s.index.end())
+			s.erase(i);
+		while(s.size + size > max_size && !s.items.empty())
+			s.erase(s.index.find(s.items.back().first));
+
+		s.items.push_front(std::make_pair(key, std::vector<char>((const char*)src, (const char*)src + size)));
+		s.index[key] = s.items.begin();
+		s.size += size;
+	}
+
+	static void get_stats(long long &hits, long long &misses)
+	{
+		hits = misses = 0;
+		for(int j = 0; j < StripeCount; ++j)
+		{
+			Stripe &s = stripes[j];
+			synfig::Mutex::Lock lock(s.mutex);
+			hits += s.hits;
+			misses += s.misses;
+		}
+	}
+
+	//! removes all chunks of surface
+	static void erase(long long id)
+	{
+		for(int j = 0; j < StripeCount; ++j)
+		{
+			Stripe &s = stripes[j];
+			synfig::Mutex::Lock lock(s.mutex);
+			Stripe::Map::iterator i = s.index.lower_bound(Key(id, 0));
+			while(i != s.index.end() && i->first.first == id)
+				s.erase(i++);
+		}
+	}
+};
+
+synfig::Mutex PackedSurface::ChunkCache::id_mutex;
+long long PackedSurface::ChunkCache::last_id = 0;
+PackedSurface::ChunkCache::Stripe PackedSurface::ChunkCache::stripes[PackedSurface::ChunkCache::StripeCount];
+
 
 PackedSurface::Reader::Reader():
 	surface(NULL),
@@ -172,7 +306,13 @@ PackedSurface::Reader::get_pixel(int x, int y) const
 				chunks[entry->chunk_index] = NULL;
 			entry->chunk_index = chunk_index;
 			chunks[chunk_index] = entry;
-			zstreambuf::unpack(entry->data(), surface->chunk_size, data, size);
+
+			ChunkCache::Key key(surface->id, chunk_index);
+			if (!ChunkCache::get(key, entry->data(), surface->chunk_size))
+			{
+				surface->unpack_chunk(chunk_index, data, size, entry->data());
+				ChunkCache::put(key, entry->data(), surface->chunk_size);
+			}
 		}
 		if (first != entry)
 		{
@@ -204,7 +344,9 @@ PackedSurface::PackedSurface():
 	chunk_size(0),
 	chunk_row_size(0),
 	chunks_width(0),
-	chunks_height(0)
+	chunks_height(0),
+	codec(CodecNone),
+	id(0)
 {
 	memset(channels, 0, sizeof(channels));
 	memset(discrete_to_float, 0, sizeof(discrete_to_float));
@@ -220,6 +362,8 @@ void
 PackedSurface::clear() {
 	while(!readers.empty())
 		(*readers.begin())->close();
+	if (chunk_size)
+		ChunkCache::erase(id);
 	width = 0;
 	height = 0;
 	channel_type = ChannelUInt8;
@@ -232,6 +376,8 @@ PackedSurface::clear() {
 	chunk_row_size = 0;
 	chunks_width = 0;
 	chunks_height = 0;
+	codec = CodecNone;
+	id = 0;
 	data.clear();
 }
 
@@ -297,6 +443,89 @@ PackedSurface::get_compressed_chunk(int index, const void *&data, int &size, boo
 	compressed = size != chunk_size;
 }
 
+void
+PackedSurface::unpack_chunk(int /* index */, const void *data, int size, void *dest) const
+{
+	if (codec == CodecRLE)
+		unpack_rle(dest, chunk_size, data, size, pixel_size);
+	else
+		zstreambuf::unpack(dest, chunk_size, data, size);
+}
+
+size_t
+PackedSurface::pack_rle(void *dest, size_t dest_size, const void *src, size_t size, int pixel_size)
+{
+	// each byte is replaced by difference with the same byte of previous pixel,
+	// then runs of equal bytes are encoded as (128 + count - 2, byte)
+	// and the other bytes as (count - 1, byte, byte, ...)
+	const unsigned char *s = (const unsigned char*)src;
+	unsigned char *d = (unsigned char*)dest;
+	unsigned char *d_end = d + dest_size;
+	std::vector<unsigned char> delta(size);
+	for(size_t i = 0; i < size; ++i)
+		delta[i] = (int)i < pixel_size ? s[i] : (unsigned char)(s[i] - s[i - pixel_size]);
+
+	size_t i = 0;
+	while(i < size)
+	{
+		size_t run = 1;
+		while(i + run < size && run < 129 && delta[i + run] == delta[i]) ++run;
+		if (run >= 2)
+		{
+			if (d + 2 > d_end) return 0;
+			*d++ = (unsigned char)(128 + run - 2);
+			*d++ = delta[i];
+			i += run;
+			continue;
+		}
+
+		size_t count = 1;
+		while( i + count < size && count < 128
+		   && !(i + count + 1 < size && delta[i + count] == delta[i + count + 1]) )
+			++count;
+		if (d + 1 + count > d_end) return 0;
+		*d++ = (unsigned char)(count - 1);
+		memcpy(d, &delta[i], count);
+		d += count;
+		i += count;
+	}
+	return d - (unsigned char*)dest;
+}
+
+void
+PackedSurface::unpack_rle(void *dest, size_t dest_size, const void *src, size_t size, int pixel_size)
+{
+	unsigned char *d = (unsigned char*)dest;
+	unsigned char *d_end = d + dest_size;
+	const unsigned char *s = (const unsigned char*)src;
+	const unsigned char *s_end = s + size;
+	while(s < s_end && d < d_end)
+	{
+		int control = *s++;
+		if (control >= 128)
+		{
+			if (s >= s_end) break;
+			size_t count = std::min((size_t)(control - 126), (size_t)(d_end - d));
+			memset(d, *s++, count);
+			d += count;
+		}
+		else
+		{
+			size_t count = std::min(std::min((size_t)(control + 1), (size_t)(s_end - s)), (size_t)(d_end - d));
+			memcpy(d, s, count);
+			d += count;
+			s += count;
+		}
+	}
+	if (d < d_end)
+		memset(d, 0, d_end - d);
+
+	// restore bytes from differences
+	d = (unsigned char*)dest;
+	for(size_t i = pixel_size; i < dest_size; ++i)
+		d[i] = (unsigned char)(d[i] + d[i - pixel_size]);
+}
+
 void
 PackedSurface::set_pixels(const Color *pixels, int width, int height, int pitch) {
 	clear();
@@ -356,6 +585,10 @@ PackedSurface::set_pixels(const Color *pixels, int width, int height, int pitch)
 							++discrete_values[j].count;
 						else
 						{
+							// keep values sorted, value may be less than the first one
+							if (c < discrete_values[i].value)
+								discrete_values.insert(discrete_values.begin() + i, DiscreteHelper(c));
+							else
 							if (c < discrete_values[j].value)
 								discrete_values.insert(discrete_values.begin() + j, DiscreteHelper(c));
 							else
@@ -406,14 +639,22 @@ PackedSurface::set_pixels(const Color *pixels, int width, int height, int pitch)
 	row_size = width * pixel_size;
 
 	const char *s;
-	bool gzip = (s = getenv("SYNFIG_PACK_IMAGES_GZIP")) && atoi(s) != 0;
+	Codec codec = (s = getenv("SYNFIG_PACK_IMAGES_GZIP")) && atoi(s) != 0 ? CodecGzip : CodecNone;
+	if ((s = getenv("SYNFIG_PACK_IMAGES_CODEC")))
+	{
+		String name(s);
+		if (name == "gzip") codec = CodecGzip; else
+		if (name == "rle")  codec = CodecRLE;  else
+		if (name == "none") codec = CodecNone; else
+			warning("SYNFIG_PACK_IMAGES_CODEC: unknown codec '%s'", s);
+	}
 	bool split = (s = getenv("SYNFIG_PACK_IMAGES_SPLIT")) && atoi(s) != 0;
 
 	if (pixel_size == 0) {
 		// do nothing
 	}
 	else
-	if ((!gzip && !split) || std::max((width-1)/ChunkSize + 1, (height-1)/ChunkSize + 1)*CacheRows*ChunkSize*ChunkSize*16 > width*height)
+	if ((codec == CodecNone && !split) || std::max((width-1)/ChunkSize + 1, (height-1)/ChunkSize + 1)*CacheRows*ChunkSize*ChunkSize*16 > width*height)
 	{
 		// no compression
 		data.resize(row_size*height);
@@ -429,6 +670,8 @@ PackedSurface::set_pixels(const Color *pixels, int width, int height, int pitch)
 		chunk_size = chunk_row_size*ChunkSize;
 		chunks_width = (width-1)/ChunkSize + 1;
 		chunks_height = (height-1)/ChunkSize + 1;
+		this->codec = codec;
+		id = ChunkCache::new_id();
 
 		int count = chunks_width*chunks_height;
 		std::vector<char> data((count + 1)*sizeof(int), 0);
@@ -450,7 +693,7 @@ PackedSurface::set_pixels(const Color *pixels, int width, int height, int pitch)
 			const void* current_data = &chunk.front();
 			int size = (int)chunk.size();
 
-			if (gzip) {
+			if (codec == CodecGzip) {
 				int gzip_size = (int)zstreambuf::pack(&compressed_chunk.front(), compressed_chunk.size(), &chunk.front(), chunk.size(), true);
 				if (gzip_size <= (int)chunk.size()/4)
 				{
@@ -458,6 +701,15 @@ PackedSurface::set_pixels(const Color *pixels, int width, int height, int pitch)
 					size = gzip_size;
 				}
 			}
+			else
+			if (codec == CodecRLE) {
+				int rle_size = (int)pack_rle(&compressed_chunk.front(), compressed_chunk.size(), &chunk.front(), chunk.size(), pixel_size);
+				if (rle_size > 0 && rle_size <= (int)chunk.size()/2)
+				{
+					current_data = &compressed_chunk.front();
+					size = rle_size;
+				}
+			}
 
 			((int*)(void*)&data.front())[i] = data.size();
 			data.resize(data.size() + size);
@@ -469,6 +721,22 @@ PackedSurface::set_pixels(const Color *pixels, int width, int height, int pitch)
 	}
 }
 
+long long
+PackedSurface::get_chunk_cache_hits()
+{
+	long long hits, misses;
+	ChunkCache::get_stats(hits, misses);
+	return hits;
+}
+
+long long
+PackedSurface::get_chunk_cache_misses()
+{
+	long long hits, misses;
+	ChunkCache::get_stats(hits, misses);
+	return misses;
+}
+
 void
 PackedSurface::get_pixels(Color *target) const {
 	if (target == NULL || width <= 0 || height <= 0)
@@ -58,11 +58,20 @@ public:
 		ChannelFloat32
 	};
 
+	//! Compression of chunks, see SYNFIG_PACK_IMAGES_CODEC environment variable
+	enum Codec {
+		CodecNone,
+		CodecGzip, //!< zlib, best ratio, slow unpacking
+		CodecRLE   //!< bytewise delta between neighbour pixels and run-length encoding, fast unpacking
+	};
+
 	enum {
 		ChunkSize = 32,
 		CacheRows = 2
 	};
 
+	class ChunkCache;
+
 	class Reader
 	{
 	private:
@@ -133,6 +142,10 @@ private:
 	int chunks_width;
 	int chunks_height;
 
+	Codec codec;
+	//! unique identifier of pixels for the shared cache of unpacked chunks
+	long long id;
+
 	std::vector<char> data;
 
 	static Color::value_type get_channel(const void *pixel, int offset, ChannelType type, Color::value_type constant, const Color::value_type *discrete_to_float);
@@ -142,6 +155,10 @@ private:
 	void set_pixel(void *pixel, const Color &color);
 
 	void get_compressed_chunk(int index, const void *&data, int &size, bool &compressed) const;
+	void unpack_chunk(int index, const void *data, int size, void *dest) const;
+
+	static size_t pack_rle(void *dest, size_t dest_size, const void *src, size_t size, int pixel_size);
+	static void unpack_rle(void *dest, size_t dest_size, const void *src, size_t size, int pixel_size);
 
 public:
 	PackedSurface();
@@ -151,7 +168,12 @@ public:
 	void set_pixels(const Color *pixels, int width, int height, int pitch = 0);
 	int get_width() const { return width; }
 	int get_height() const { return height; }
+	Codec get_codec() const { return codec; }
 	void get_pixels(Color *target) const;
+
+	//! Statistics of the shared cache of unpacked chunks
+	static long long get_chunk_cache_hits();
+	static long long get_chunk_cache_misses();
 };
 
 } /* end namespace software */
@@ -0,0 +1,250 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/rendercache.cpp
+**	\brief RenderCache
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cstdlib>
+
+#include <list>
+#include <map>
+
+#include <synfig/general.h>
+#include <synfig/mutex.h>
+
+#include "rendercache.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+class software::RenderCache::Internal
+{
+public:
+	class Item
+	{
+	public:
+		size_t hash;
+		Key key;
+		Entry::Handle entry;
+		Item(size_t hash, const Key &key, const Entry::Handle &entry):
+			hash(hash), key(key), entry(entry) { }
+	};
+	//! most recently used entries are at front
+	typedef std::list<Item> List;
+	//! items by hash of key, so only keys with equal hashes are compared
+	typedef std::multimap<size_t, List::iterator> Index;
+
+	static const size_t default_max_size = 256*1024*1024;
+
+	static Mutex mutex;
+	static List items;
+	static Index index;
+	static size_t size;
+	static size_t max_size;
+	static long long hits;
+	static long long misses;
+
+	static List::iterator find(size_t hash, const Key &key)
+	{
+		std::pair<Index::iterator, Index::iterator> range = index.equal_range(hash);
+		for(Index::iterator i = range.first; i != range.second; ++i)
+			if (i->second->key == key)
+				return i->second;
+		return items.end();
+	}
+
+	static void erase(List::iterator item)
+	{
+		std::pair<Index::iterator, Index::iterator> range = index.equal_range(item->hash);
+		for(Index::iterator i = range.first; i != range.second; ++i)
+			if (i->second == item)
+				{ index.erase(i); break; }
+		size -= item->entry->get_size();
+		items.erase(item);
+	}
+
+	static void shrink(size_t max)
+	{
+		while(size > max && !items.empty())
+			erase(--items.end());
+	}
+
+	static void clear()
+	{
+		items.clear();
+		index.clear();
+		size = 0;
+	}
+};
+
+Mutex software::RenderCache::Internal::mutex;
+software::RenderCache::Internal::List software::RenderCache::Internal::items;
+software::RenderCache::Internal::Index software::RenderCache::Internal::index;
+size_t software::RenderCache::Internal::size = 0;
+size_t software::RenderCache::Internal::max_size = software::RenderCache::Internal::default_max_size;
+long long software::RenderCache::Internal::hits = 0;
+long long software::RenderCache::Internal::misses = 0;
+
+
+size_t
+software::RenderCache::Key::get_hash() const
+{
+	size_t hash = (size_t)renderer;
+	hash = hash*31 + (size_t)target_size[0];
+	hash = hash*31 + (size_t)target_size[1];
+	hash = hash*31 + transformations.size();
+	if (fingerprint)
+		hash = hash*31 + fingerprint->get_hash();
+	return hash;
+}
+
+bool
+software::RenderCache::Key::operator==(const Key &other) const
+{
+	return renderer == other.renderer
+		&& target_size == other.target_size
+		&& source_rect_lt == other.source_rect_lt
+		&& source_rect_rb == other.source_rect_rb
+		&& transformations == other.transformations
+		&& fingerprint && other.fingerprint
+		&& *fingerprint == *other.fingerprint;
+}
+
+bool
+software::RenderCache::is_enabled()
+	{ return Internal::max_size > 0; }
+
+software::RenderCache::Entry::Handle
+software::RenderCache::get(const Key &key)
+{
+	size_t hash = key.get_hash();
+
+	Mutex::Lock lock(Internal::mutex);
+	Internal::List::iterator i = Internal::find(hash, key);
+	if (i == Internal::items.end())
+	{
+		++Internal::misses;
+		return Entry::Handle();
+	}
+	if (i != Internal::items.begin())
+		Internal::items.splice(Internal::items.begin(), Internal::items, i);
+	++Internal::hits;
+	return i->entry;
+}
+
+void
+software::RenderCache::put(const Key &key, const Entry::Handle &entry)
+{
+	if (!entry) return;
+	size_t entry_size = entry->get_size();
+	size_t hash = key.get_hash();
+
+	Mutex::Lock lock(Internal::mutex);
+	if (entry_size > Internal::max_size)
+		return;
+
+	Internal::List::iterator i = Internal::find(hash, key);
+	if (i != Internal::items.end())
+		Internal::erase(i);
+
+	Internal::shrink(Internal::max_size - entry_size);
+	Internal::items.push_front(Internal::Item(hash, key, entry));
+	Internal::index.insert(Internal::Index::value_type(hash, Internal::items.begin()));
+	Internal::size += entry_size;
+}
+
+void
+software::RenderCache::clear()
+{
+	Mutex::Lock lock(Internal::mutex);
+	Internal::clear();
+}
+
+size_t
+software::RenderCache::get_max_size()
+	{ return Internal::max_size; }
+
+size_t
+software::RenderCache::get_size()
+{
+	Mutex::Lock lock(Internal::mutex);
+	return Internal::size;
+}
+
+long long
+software::RenderCache::get_hits()
+{
+	Mutex::Lock lock(Internal::mutex);
+	return Internal::hits;
+}
+
+long long
+software::RenderCache::get_misses()
+{
+	Mutex::Lock lock(Internal::mutex);
+	return Internal::misses;
+}
+
+void
+software::RenderCache::initialize()
+{
+	Mutex::Lock lock(Internal::mutex);
+	Internal::max_size = Internal::default_max_size;
+	if (const char *s = getenv("SYNFIG_RENDER_CACHE_SIZE"))
+	{
+		// size in megabytes, zero disables the cache
+		int megabytes = atoi(s);
+		if (megabytes >= 0)
+			Internal::max_size = (size_t)megabytes*1024*1024;
+		else
+			warning("SYNFIG_RENDER_CACHE_SIZE: invalid size '%s', use default", s);
+	}
+	Internal::hits = 0;
+	Internal::misses = 0;
+}
+
+void
+software::RenderCache::deinitialize()
+{
+	Mutex::Lock lock(Internal::mutex);
+	if (Internal::hits || Internal::misses)
+		info("RenderCache: %lld hits, %lld misses", Internal::hits, Internal::misses);
+	Internal::clear();
+}
+
+/* === E N T R Y P O I N T ================================================= */
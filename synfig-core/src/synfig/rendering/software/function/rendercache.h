@@ -0,0 +1,114 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/function/rendercache.h
+**	\brief RenderCache Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SOFTWARE_RENDERCACHE_H
+#define __SYNFIG_RENDERING_SOFTWARE_RENDERCACHE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <cstddef>
+#include <vector>
+
+#include <synfig/matrix.h>
+#include <synfig/surface.h>
+
+#include "../../common/task/taskcache.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+namespace software
+{
+
+//! Keeps rendered results of TaskCache between renderings (frames),
+//! least recently used entries are dropped when memory limit is reached
+class RenderCache
+{
+private:
+	class Internal;
+
+public:
+	class Key
+	{
+	public:
+		const void *renderer;
+		TaskCache::Fingerprint::Handle fingerprint;
+		//! transformations of optimized sub-task tree in order of traversal
+		std::vector<Matrix> transformations;
+		Vector source_rect_lt;
+		Vector source_rect_rb;
+		VectorInt target_size;
+
+		Key(): renderer() { }
+
+		//! Equal keys have equal hashes
+		size_t get_hash() const;
+		bool operator==(const Key &other) const;
+	};
+
+	class Entry: public etl::shared_object
+	{
+	public:
+		typedef etl::handle<Entry> Handle;
+
+		//! rendered area relative to the origin of target rect of task
+		RectInt rect;
+		synfig::Surface surface;
+
+		size_t get_size() const
+			{ return sizeof(*this) + sizeof(Color)*(size_t)surface.get_w()*(size_t)surface.get_h(); }
+	};
+
+	//! Returns false when cache is disabled, see SYNFIG_RENDER_CACHE_SIZE environment variable
+	static bool is_enabled();
+
+	//! Returns cached entry or null handle, counts hits and misses
+	static Entry::Handle get(const Key &key);
+	//! Stores entry, entries bigger than the whole cache are skipped
+	static void put(const Key &key, const Entry::Handle &entry);
+	static void clear();
+
+	static size_t get_max_size();
+	static size_t get_size();
+	static long long get_hits();
+	static long long get_misses();
+
+	static void initialize();
+	static void deinitialize();
+};
+
+} /* end namespace software */
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -0,0 +1,143 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/optimizer/optimizercachesw.cpp
+**	\brief OptimizerCacheSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include "optimizercachesw.h"
+
+#include "../task/taskcachesw.h"
+#include "../surfacesw.h"
+#include "../../common/task/tasktransformableaffine.h"
+#include "../../common/task/tasktransformation.h"
+#include "../../primitive/affinetransformation.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+bool
+OptimizerCacheSW::collect_transformations(const Task::Handle &task, std::vector<Matrix> &out)
+{
+	if (!task)
+		return true;
+
+	if (TaskTransformation::Handle transformation = TaskTransformation::Handle::cast_dynamic(task))
+	{
+		AffineTransformation::Handle affine = AffineTransformation::Handle::cast_dynamic(transformation->transformation);
+		if (!affine)
+			return false;
+		out.push_back(affine->matrix);
+	}
+	else
+	if (TaskTransformableAffine *transformable_affine = task.type_pointer<TaskTransformableAffine>())
+	{
+		out.push_back(transformable_affine->transformation);
+	}
+
+	for(Task::List::const_iterator i = task->sub_tasks.begin(); i != task->sub_tasks.end(); ++i)
+		if (!collect_transformations(*i, out))
+			return false;
+	return true;
+}
+
+void
+OptimizerCacheSW::run(const RunParams& params) const
+{
+	TaskCache::Handle cache = TaskCache::Handle::cast_dynamic(params.ref_task);
+	if ( cache
+	  && cache->target_surface
+	  && cache.type_equal<TaskCache>() )
+	{
+		// transformations are already applied to sub-tasks, so the same
+		// fingerprint and the same transformations gives the same result
+		software::RenderCache::Key key;
+		bool cacheable = cache->fingerprint
+		              && cache->sub_task()
+		              && cache->valid_target_rect()
+		              && software::RenderCache::is_enabled()
+		              && collect_transformations(cache->sub_task(), key.transformations);
+
+		if (!cacheable)
+		{
+			// just replace by sub-task
+			Task::Handle task;
+			if (cache->sub_task())
+			{
+				task = cache->sub_task()->clone();
+				task->target_surface = cache->target_surface;
+				task->init_target_rect(cache->get_target_rect(), cache->get_source_rect_lt(), cache->get_source_rect_rb());
+				task->trunc_target_by_bounds();
+			}
+			apply(params, task);
+			return;
+		}
+
+		TaskCacheSW::Handle cache_sw;
+		init_and_assign_all<rendering::SurfaceSW>(cache_sw, cache);
+		if (!cache_sw->valid_target_rect())
+		{
+			// nothing to render
+			cache_sw->sub_tasks.clear();
+			apply(params, cache_sw);
+			return;
+		}
+
+		key.renderer = &params.renderer;
+		key.fingerprint = cache_sw->fingerprint;
+		key.source_rect_lt = cache_sw->get_source_rect_lt();
+		key.source_rect_rb = cache_sw->get_source_rect_rb();
+		key.target_size = cache_sw->get_target_rect().get_size();
+
+		cache_sw->key = key;
+		cache_sw->entry = software::RenderCache::get(key);
+		if (cache_sw->entry)
+			cache_sw->sub_tasks.clear();
+		else
+			assert( cache_sw->sub_task()->check() );
+
+		apply(params, cache_sw);
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,67 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/optimizer/optimizergradientsw.cpp
+**	\brief OptimizerGradientSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include "optimizergradientsw.h"
+
+#include "../task/taskgradientsw.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+void
+OptimizerGradientSW::run(const RunParams& params) const
+{
+	TaskGradient::Handle gradient = TaskGradient::Handle::cast_dynamic(params.ref_task);
+	if ( gradient
+	  && gradient->target_surface
+	  && gradient.type_equal<TaskGradient>() )
+	{
+		apply(params, create_and_assign<TaskGradientSW>(gradient));
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
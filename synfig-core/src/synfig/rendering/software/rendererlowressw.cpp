@@ -61,7 +61,9 @@
 
 #include "optimizer/optimizerblendsw.h"
 #include "optimizer/optimizerblursw.h"
+#include "optimizer/optimizercachesw.h"
 #include "optimizer/optimizercontoursw.h"
+#include "optimizer/optimizergradientsw.h"
 #include "optimizer/optimizerlayersw.h"
 #include "optimizer/optimizermeshsw.h"
 #include "optimizer/optimizerpixelcolormatrixsw.h"
@@ -92,7 +94,9 @@ RendererLowResSW::RendererLowResSW(int level):
 
 	register_optimizer(new OptimizerBlendSW());
 	register_optimizer(new OptimizerBlurSW());
+	register_optimizer(new OptimizerCacheSW());
 	register_optimizer(new OptimizerContourSW());
+	register_optimizer(new OptimizerGradientSW());
 	register_optimizer(new OptimizerLayerSW());
 	register_optimizer(new OptimizerPixelColorMatrixSW());
 	register_optimizer(new OptimizerPixelGammaSW());
@@ -60,7 +60,9 @@
 
 #include "optimizer/optimizerblendsw.h"
 #include "optimizer/optimizerblursw.h"
+#include "optimizer/optimizercachesw.h"
 #include "optimizer/optimizercontoursw.h"
+#include "optimizer/optimizergradientsw.h"
 #include "optimizer/optimizerlayersw.h"
 #include "optimizer/optimizermeshsw.h"
 #include "optimizer/optimizerpixelcolormatrixsw.h"
@@ -68,6 +70,7 @@
 #include "optimizer/optimizersurfaceresamplesw.h"
 
 #include "function/fft.h"
+#include "function/rendercache.h"
 
 #endif
 
@@ -91,7 +94,9 @@ RendererSW::RendererSW()
 
 	register_optimizer(new OptimizerBlendSW());
 	register_optimizer(new OptimizerBlurSW());
+	register_optimizer(new OptimizerCacheSW());
 	register_optimizer(new OptimizerContourSW());
+	register_optimizer(new OptimizerGradientSW());
 	register_optimizer(new OptimizerLayerSW());
 	register_optimizer(new OptimizerPixelColorMatrixSW());
 	register_optimizer(new OptimizerPixelGammaSW());
@@ -109,7 +114,7 @@ RendererSW::RendererSW()
 
 	register_optimizer(new OptimizerLinear());
 	register_optimizer(new OptimizerSurfaceCreate());
-	//register_optimizer(new OptimizerSplit());
+	register_optimizer(new OptimizerSplit());
 }
 
 RendererSW::~RendererSW() { }
@@ -119,11 +124,13 @@ String RendererSW::get_name() const { return _("Cobra (software)"); }
 void RendererSW::initialize()
 {
 	software::FFT::initialize();
+	software::RenderCache::initialize();
 
 }
 
 void RendererSW::deinitialize()
 {
+	software::RenderCache::deinitialize();
 	software::FFT::deinitialize();
 }
 
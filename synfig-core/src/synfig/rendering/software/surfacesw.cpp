@@ -37,6 +37,8 @@
 
 #include <synfig/rendering/software/surfacesw.h>
 
+#include "function/mipmap.h"
+
 #endif
 
 using namespace synfig;
@@ -69,6 +71,7 @@ SurfaceSW::~SurfaceSW()
 bool
 SurfaceSW::create_vfunc()
 {
+	reset_mipmap();
 	surface->set_wh(get_width(), get_height());
 	surface->clear();
 	return true;
@@ -77,6 +80,7 @@ SurfaceSW::create_vfunc()
 bool
 SurfaceSW::assign_vfunc(const rendering::Surface &surface)
 {
+	reset_mipmap();
 	this->surface->set_wh(get_width(), get_height());
 	if (surface.get_pixels(&(*this->surface)[0][0]))
 		return true;
@@ -88,6 +92,7 @@ void
 SurfaceSW::destroy_vfunc()
 {
 	assert(surface);
+	reset_mipmap();
 	surface->set_wh(0, 0);
 }
 
@@ -109,6 +114,7 @@ SurfaceSW::set_surface(synfig::Surface &surface, bool own_surface)
 		return;
 
 	unset_alternative();
+	reset_mipmap();
 
 	this->surface = &surface;
 	assert(this->surface);
@@ -121,6 +127,7 @@ void
 SurfaceSW::reset_surface()
 {
 	unset_alternative();
+	reset_mipmap();
 	if (!own_surface)
 	{
 		own_surface = true;
@@ -130,4 +137,39 @@ SurfaceSW::reset_surface()
 	mark_as_created(false);
 }
 
+SurfaceSW::Handle
+SurfaceSW::get_mipmap(int level) const
+{
+	assert(level > 0);
+	if (level <= 0 || level > get_mipmap_max_level())
+		return Handle();
+
+	Mutex::Lock lock(mipmap_mutex);
+	while((int)mipmap.size() < level)
+	{
+		const synfig::Surface &src = mipmap.empty() ? *surface : mipmap.back()->get_surface();
+		Handle dest(new SurfaceSW());
+		software::Mipmap::downscale(*dest->surface, src);
+		dest->set_size(dest->surface->get_w(), dest->surface->get_h());
+		dest->mark_as_created(!dest->empty());
+		mipmap.push_back(dest);
+	}
+	return mipmap[level - 1];
+}
+
+int
+SurfaceSW::get_mipmap_max_level() const
+{
+	return is_created() && surface
+	     ? software::Mipmap::get_max_level(surface->get_w(), surface->get_h())
+	     : 0;
+}
+
+void
+SurfaceSW::reset_mipmap()
+{
+	Mutex::Lock lock(mipmap_mutex);
+	mipmap.clear();
+}
+
 /* === E N T R Y P O I N T ================================================= */
@@ -27,6 +27,9 @@
 
 /* === H E A D E R S ======================================================= */
 
+#include <vector>
+
+#include <synfig/mutex.h>
 #include <synfig/surface.h>
 
 #include "../surface.h"
@@ -51,6 +54,9 @@ private:
 	bool own_surface;
 	synfig::Surface *surface;
 
+	mutable Mutex mipmap_mutex;
+	mutable std::vector<Handle> mipmap;
+
 protected:
 	virtual bool create_vfunc();
 	virtual bool assign_vfunc(const Surface &surface);
@@ -69,6 +75,13 @@ public:
 
 	void set_surface(synfig::Surface &surface, bool own_surface = false);
 	void reset_surface();
+
+	//! Returns downscaled copy of surface (see software::Mipmap),
+	//! levels are built on demand, \a level should be greater than zero
+	Handle get_mipmap(int level) const;
+	int get_mipmap_max_level() const;
+	//! Drops downscaled copies, should be called after direct changes of surface
+	void reset_mipmap();
 };
 
 } /* end namespace rendering */
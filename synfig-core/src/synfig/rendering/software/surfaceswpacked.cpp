@@ -35,7 +35,10 @@
 #include <signal.h>
 #endif
 
+#include <synfig/surface.h>
+
 #include "surfaceswpacked.h"
+#include "function/mipmap.h"
 
 #endif
 
@@ -53,12 +56,14 @@ using namespace rendering;
 bool
 SurfaceSWPacked::create_vfunc()
 {
+	reset_mipmap();
 	return false;
 }
 
 bool
 SurfaceSWPacked::assign_vfunc(const rendering::Surface &surface)
 {
+	reset_mipmap();
 	std::vector<Color> pixels(get_pixels_count());
 	surface.get_pixels(&pixels.front());
 	this->surface.set_pixels(&pixels.front(), get_width(), get_height());
@@ -68,6 +73,7 @@ SurfaceSWPacked::assign_vfunc(const rendering::Surface &surface)
 void
 SurfaceSWPacked::destroy_vfunc()
 {
+	reset_mipmap();
 	surface.clear();
 }
 
@@ -78,4 +84,43 @@ SurfaceSWPacked::get_pixels_vfunc(Color *buffer) const
 	return true;
 }
 
+SurfaceSWPacked::Handle
+SurfaceSWPacked::get_mipmap(int level) const
+{
+	assert(level > 0);
+	if (level <= 0 || level > get_mipmap_max_level())
+		return Handle();
+
+	Mutex::Lock lock(mipmap_mutex);
+	while((int)mipmap.size() < level)
+	{
+		const software::PackedSurface &src = mipmap.empty() ? surface : mipmap.back()->surface;
+		synfig::Surface pixels;
+		software::Mipmap::downscale(pixels, src);
+
+		Handle dest(new SurfaceSWPacked());
+		if (pixels.is_valid())
+			dest->surface.set_pixels(&pixels[0][0], pixels.get_w(), pixels.get_h());
+		dest->set_size(pixels.get_w(), pixels.get_h());
+		dest->mark_as_created(!dest->empty());
+		mipmap.push_back(dest);
+	}
+	return mipmap[level - 1];
+}
+
+int
+SurfaceSWPacked::get_mipmap_max_level() const
+{
+	return is_created()
+	     ? software::Mipmap::get_max_level(surface.get_width(), surface.get_height())
+	     : 0;
+}
+
+void
+SurfaceSWPacked::reset_mipmap()
+{
+	Mutex::Lock lock(mipmap_mutex);
+	mipmap.clear();
+}
+
 /* === E N T R Y P O I N T ================================================= */
@@ -27,6 +27,10 @@
 
 /* === H E A D E R S ======================================================= */
 
+#include <vector>
+
+#include <synfig/mutex.h>
+
 #include "../surface.h"
 
 #include "function/packedsurface.h"
@@ -56,6 +60,9 @@ protected:
 private:
 	software::PackedSurface surface;
 
+	mutable Mutex mipmap_mutex;
+	mutable std::vector<Handle> mipmap;
+
 public:
 	SurfaceSWPacked()
 		{ }
@@ -67,6 +74,12 @@ public:
 		{ destroy(); }
 
 	const software::PackedSurface& get_surface() const { return surface; }
+
+	//! Returns downscaled copy of surface (see software::Mipmap),
+	//! levels are built on demand, \a level should be greater than zero
+	Handle get_mipmap(int level) const;
+	int get_mipmap_max_level() const;
+	void reset_mipmap();
 };
 
 } /* end namespace rendering */
@@ -37,6 +37,7 @@
 
 #include <synfig/debug/debugsurface.h>
 #include <synfig/general.h>
+#include <synfig/color/colorblendspan.h>
 
 #include "taskblendsw.h"
 #include "../surfacesw.h"
@@ -146,15 +147,13 @@ TaskBlendSW::run(RunParams & /* params */) const
 			for(int i = 0; i < 4; ++i)
 			{
 				if (fill[i].valid())
-				{
-					synfig::Surface::alpha_pen ap(
-						c.get_pen(fill[i].minx, fill[i].miny) );
-					ap.set_blend_method(blend_method);
-					ap.set_alpha(amount);
-					c.fill( Color(0, 0, 0, 0), ap,
+					for(int y = fill[i].miny; y < fill[i].maxy; ++y)
+						ColorBlendSpan::fill(
+							&c[y][fill[i].minx],
+							Color(0, 0, 0, 0),
 							fill[i].maxx - fill[i].minx,
-							fill[i].maxy - fill[i].miny );
-				}
+							amount,
+							blend_method );
 			}
 		}
 	}
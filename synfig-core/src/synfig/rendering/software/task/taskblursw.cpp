@@ -82,7 +82,7 @@ TaskBlurSW::run(RunParams & /* params */) const
 			blur.type, s,
 			blend, blend_method, amount ));
 
-	return false;
+	return true;
 }
 
 /* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,106 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskcachesw.cpp
+**	\brief TaskCacheSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <cstring>
+
+#include "taskcachesw.h"
+
+#include "../surfacesw.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+bool
+TaskCacheSW::run(RunParams & /* params */) const
+{
+	RectInt rd = get_target_rect();
+	if (!rd.valid())
+		return true;
+
+	software::RenderCache::Entry::Handle e = entry;
+	if (!e)
+	{
+		// copy result of sub-task and store it into cache
+		if (!sub_task() || !sub_task()->target_surface)
+			return true;
+		// result of failed sub-task is not stored, so it will be rendered again
+		if (!sub_task()->success)
+			return false;
+		const synfig::Surface &src =
+			rendering::SurfaceSW::Handle::cast_dynamic( sub_task()->target_surface )->get_surface();
+
+		VectorInt offset = get_offset();
+		RectInt rs = sub_task()->get_target_rect() + rd.get_min() + offset;
+		etl::set_intersect(rs, rs, rd);
+
+		e = new software::RenderCache::Entry();
+		if (rs.valid())
+		{
+			e->rect = rs - rd.get_min();
+			e->surface.set_wh(rs.get_width(), rs.get_height());
+			for(int y = rs.miny; y < rs.maxy; ++y)
+				memcpy(
+					&e->surface[y - rs.miny][0],
+					&src[y - rd.miny - offset[1]][rs.minx - rd.minx - offset[0]],
+					sizeof(Color)*rs.get_width() );
+		}
+		software::RenderCache::put(key, e);
+	}
+
+	if (e->rect.valid())
+	{
+		synfig::Surface &dst =
+			rendering::SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
+		RectInt r = e->rect + rd.get_min();
+		for(int y = r.miny; y < r.maxy; ++y)
+			memcpy(&dst[y][r.minx], &e->surface[y - r.miny][0], sizeof(Color)*r.get_width());
+	}
+
+	return true;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,63 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskcachesw.h
+**	\brief TaskCacheSW Header
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_TASKCACHESW_H
+#define __SYNFIG_RENDERING_TASKCACHESW_H
+
+/* === H E A D E R S ======================================================= */
+
+#include "tasksw.h"
+#include "../../common/task/taskcache.h"
+#include "../function/rendercache.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+class TaskCacheSW: public TaskCache, public TaskSW
+{
+public:
+	typedef etl::handle<TaskCacheSW> Handle;
+
+	software::RenderCache::Key key;
+	//! Cached result, sub-task is not used when it's set
+	software::RenderCache::Entry::Handle entry;
+
+	Task::Handle clone() const { return clone_pointer(this); }
+	virtual bool run(RunParams &params) const;
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
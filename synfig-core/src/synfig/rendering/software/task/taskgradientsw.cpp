@@ -0,0 +1,114 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskgradientsw.cpp
+**	\brief TaskGradientSW
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <signal.h>
+#endif
+
+#include <cmath>
+#include <vector>
+
+#include "taskgradientsw.h"
+
+#include "../surfacesw.h"
+
+#include <synfig/color/colorblendspan.h>
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+void
+TaskGradientSW::split(const RectInt &sub_target_rect)
+{
+	trunc_target_rect(sub_target_rect);
+}
+
+bool
+TaskGradientSW::run(RunParams & /* params */) const
+{
+	synfig::Surface &a =
+		SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
+
+	if (valid_target() && shape)
+	{
+		Matrix bounds_transfromation;
+		bounds_transfromation.m00 = get_pixels_per_unit()[0];
+		bounds_transfromation.m11 = get_pixels_per_unit()[1];
+		bounds_transfromation.m20 = -get_source_rect_lt()[0]*bounds_transfromation.m00 + get_target_rect().minx;
+		bounds_transfromation.m21 = -get_source_rect_lt()[1]*bounds_transfromation.m11 + get_target_rect().miny;
+
+		Matrix matrix = transformation * bounds_transfromation;
+		if (!matrix.is_invertible())
+			return true;
+		matrix.invert();
+
+		// steps between pixels in the plane of gradient
+		const Vector dx = matrix.get_axis_x();
+		const Vector dy = matrix.get_axis_y();
+		const Real pw = std::sqrt(std::fabs(dx[0]*dy[1] - dx[1]*dy[0]));
+
+		const RectInt &r = get_target_rect();
+		const int count = r.maxx - r.minx;
+		std::vector<Color> row(count);
+
+		// sample at top left corners of pixels like the software rendering of layers
+		Point start = matrix.get_transformed(Vector(r.minx, r.miny));
+		for(int y = r.miny; y < r.maxy; ++y, start += dy)
+		{
+			Point p = start;
+			for(std::vector<Color>::iterator i = row.begin(); i != row.end(); ++i, p += dx)
+				*i = shape->get_color(gradient, p, pw);
+
+			ColorBlendSpan::blend(
+				&a[y][r.minx],
+				&row.front(),
+				count,
+				blend ? amount : 1.0,
+				blend ? blend_method : Color::BLEND_COMPOSITE );
+		}
+	}
+
+	return true;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -58,6 +58,37 @@ using namespace rendering;
 
 /* === M E T H O D S ======================================================= */
 
+bool
+TaskLayerSW::is_splittable() const
+{
+	// layer may be rendered in bands only when it takes pixels of context
+	// from the same place, blurs and distortions would show seams between bands
+	if (!layer || layer->reads_context() || !valid_target())
+		return false;
+
+	RendDesc desc;
+	desc.set_tl(get_source_rect_lt());
+	desc.set_br(get_source_rect_rb());
+	desc.set_wh(get_target_rect().get_width(), get_target_rect().get_height());
+
+	std::vector<RendDesc> sub_descs;
+	layer->get_sub_renddesc(desc, sub_descs);
+	return sub_descs.size() == 1
+	    && sub_descs.front().get_tl() == desc.get_tl()
+	    && sub_descs.front().get_br() == desc.get_br()
+	    && sub_descs.front().get_w() == desc.get_w()
+	    && sub_descs.front().get_h() == desc.get_h();
+}
+
+void
+TaskLayerSW::split(const RectInt &sub_target_rect)
+{
+	trunc_target_rect(sub_target_rect);
+	// bands are rendering simultaneously, so each band needs own copy of layer
+	if (layer)
+		layer = layer->clone(NULL);
+}
+
 bool
 TaskLayerSW::run(RunParams & /* params */) const
 {
@@ -66,18 +97,33 @@ TaskLayerSW::run(RunParams & /* params */) const
 	synfig::Surface &target =
 		SurfaceSW::Handle::cast_dynamic( target_surface )->get_surface();
 
-	Vector upp = get_units_per_pixel();
-	Vector lt = get_source_rect_lt();
-	Vector rb = get_source_rect_rb();
-	lt[0] -= get_target_rect().minx*upp[0];
-	lt[1] -= get_target_rect().miny*upp[1];
-	rb[0] += (target.get_w() - get_target_rect().maxx)*upp[0];
-	rb[1] += (target.get_h() - get_target_rect().maxy)*upp[1];
-
 	RendDesc desc;
-	desc.set_tl(lt);
-	desc.set_br(rb);
-	desc.set_wh(target.get_w(), target.get_h());
+	synfig::Surface band;
+	synfig::Surface *surface = &target;
+	if (splitted)
+	{
+		// render band only, into separate surface
+		if (!valid_target()) return true;
+		desc.set_tl(get_source_rect_lt());
+		desc.set_br(get_source_rect_rb());
+		desc.set_wh(get_target_rect().get_width(), get_target_rect().get_height());
+		band.set_wh(desc.get_w(), desc.get_h());
+		surface = &band;
+	}
+	else
+	{
+		Vector upp = get_units_per_pixel();
+		Vector lt = get_source_rect_lt();
+		Vector rb = get_source_rect_rb();
+		lt[0] -= get_target_rect().minx*upp[0];
+		lt[1] -= get_target_rect().miny*upp[1];
+		rb[0] += (target.get_w() - get_target_rect().maxx)*upp[0];
+		rb[1] += (target.get_h() - get_target_rect().maxy)*upp[1];
+
+		desc.set_tl(lt);
+		desc.set_br(rb);
+		desc.set_wh(target.get_w(), target.get_h());
+	}
 	desc.set_antialias(1);
 
 	etl::handle<Layer_RenderingTask> sub_layer(new Layer_RenderingTask());
@@ -93,7 +139,13 @@ TaskLayerSW::run(RunParams & /* params */) const
 	fake_canvas_base.push_back(Layer::Handle());
 
 	Context context(fake_canvas_base.begin(), ContextParams());
-	bool result = context.accelerated_render(&target, 4, desc, NULL);
+	bool result = context.accelerated_render(surface, 4, desc, NULL);
+
+	if (result && surface == &band)
+	{
+		synfig::Surface::pen pen = target.get_pen(get_target_rect().minx, get_target_rect().miny);
+		band.blit_to(pen);
+	}
 
 	//debug::DebugSurface::save_to_file(target, "TaskLayerSW__run__target");
 
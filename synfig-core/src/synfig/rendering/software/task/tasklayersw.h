@@ -29,6 +29,7 @@
 
 #include "tasksw.h"
 #include "../../common/task/tasklayer.h"
+#include "../../common/task/tasksplittable.h"
 
 /* === M A C R O S ========================================================= */
 
@@ -41,11 +42,13 @@ namespace synfig
 namespace rendering
 {
 
-class TaskLayerSW: public TaskLayer, public TaskSW
+class TaskLayerSW: public TaskLayer, public TaskSW, public TaskSplittable
 {
 public:
 	typedef etl::handle<TaskLayerSW> Handle;
 	Task::Handle clone() const { return clone_pointer(this); }
+	virtual bool is_splittable() const;
+	virtual void split(const RectInt &sub_target_rect);
 	virtual bool run(RunParams &params) const;
 };
 
@@ -55,21 +55,13 @@ using namespace rendering;
 
 /* === M E T H O D S ======================================================= */
 
-/*
 void
 TaskPixelColorMatrixSW::split(const RectInt &sub_target_rect)
 {
+	// source area is intersected with target rect in run(),
+	// so sub-task may stay untouched
 	trunc_target_rect(sub_target_rect);
-	if (valid_target() && sub_task() && sub_task()->valid_target())
-	{
-		sub_task() = sub_task()->clone();
-		sub_task()->trunc_target_rect(
-			get_target_rect()
-			- get_target_offset()
-			- get_offset() );
-	}
 }
-*/
 
 bool
 TaskPixelColorMatrixSW::run(RunParams & /* params */) const
@@ -198,6 +198,14 @@ namespace {
 }
 
 
+void
+TaskPixelGammaSW::split(const RectInt &sub_target_rect)
+{
+	// source area is intersected with target rect in run(),
+	// so sub-task may stay untouched
+	trunc_target_rect(sub_target_rect);
+}
+
 bool
 TaskPixelGammaSW::run(RunParams & /* params */) const
 {
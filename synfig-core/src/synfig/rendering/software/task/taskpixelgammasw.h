@@ -29,6 +29,7 @@
 
 #include "tasksw.h"
 #include "../../common/task/taskpixelgamma.h"
+#include "../../common/task/tasksplittable.h"
 
 /* === M A C R O S ========================================================= */
 
@@ -41,11 +42,12 @@ namespace synfig
 namespace rendering
 {
 
-class TaskPixelGammaSW: public TaskPixelGamma, public TaskSW
+class TaskPixelGammaSW: public TaskPixelGamma, public TaskSW, public TaskSplittable
 {
 public:
 	typedef etl::handle<TaskPixelGammaSW> Handle;
 	Task::Handle clone() const { return clone_pointer(this); }
+	virtual void split(const RectInt &sub_target_rect);
 	virtual bool run(RunParams &params) const;
 };
 
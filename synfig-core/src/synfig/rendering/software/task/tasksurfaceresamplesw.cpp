@@ -42,6 +42,7 @@
 #include "tasksurfaceresamplesw.h"
 
 #include "../surfacesw.h"
+#include "../function/mipmap.h"
 #include "../function/packedsurface.h"
 
 #endif
@@ -411,6 +412,12 @@ TaskSurfaceResampleSW::resample(
 		blend_method );
 }
 
+void
+TaskSurfaceResampleSW::split(const RectInt &sub_target_rect)
+{
+	trunc_target_rect(sub_target_rect);
+}
+
 bool
 TaskSurfaceResampleSW::run(RunParams & /* params */) const
 {
@@ -436,13 +443,23 @@ TaskSurfaceResampleSW::run(RunParams & /* params */) const
 		Matrix matrix = src_pixels_to_units * transformation * dest_units_to_pixels;
 
 		// resample
+		RectInt src_bounds = sub_task()->get_target_rect();
 		if (SurfaceSW::Handle a_sw = SurfaceSW::Handle::cast_dynamic(sub_task()->target_surface))
 		{
+			// take downscaled copy of surface when it's reduced
+			int level = mipmaps ? software::Mipmap::choose_level(matrix, a_sw->get_mipmap_max_level()) : 0;
+			if (SurfaceSW::Handle level_sw = level > 0 ? a_sw->get_mipmap(level) : SurfaceSW::Handle())
+			{
+				a_sw = level_sw;
+				src_bounds = software::Mipmap::get_level_bounds(src_bounds, level);
+				matrix = software::Mipmap::get_level_transformation(matrix, level);
+			}
+
 			resample(
 				target,
 				get_target_rect(),
 				a_sw->get_surface(),
-				sub_task()->get_target_rect(),
+				src_bounds,
 				matrix,
 				gamma,
 				interpolation,
@@ -454,11 +471,19 @@ TaskSurfaceResampleSW::run(RunParams & /* params */) const
 		else
 		if (SurfaceSWPacked::Handle a_swpacked = SurfaceSWPacked::Handle::cast_dynamic(sub_task()->target_surface))
 		{
+			int level = mipmaps ? software::Mipmap::choose_level(matrix, a_swpacked->get_mipmap_max_level()) : 0;
+			if (SurfaceSWPacked::Handle level_swpacked = level > 0 ? a_swpacked->get_mipmap(level) : SurfaceSWPacked::Handle())
+			{
+				a_swpacked = level_swpacked;
+				src_bounds = software::Mipmap::get_level_bounds(src_bounds, level);
+				matrix = software::Mipmap::get_level_transformation(matrix, level);
+			}
+
 			resample(
 				target,
 				get_target_rect(),
 				a_swpacked->get_surface(),
-				sub_task()->get_target_rect(),
+				src_bounds,
 				matrix,
 				gamma,
 				interpolation,
@@ -32,6 +32,7 @@
 #include "../surfaceswpacked.h"
 #include "../../common/task/tasksurfaceresample.h"
 #include "../../common/task/taskcomposite.h"
+#include "../../common/task/tasksplittable.h"
 
 /* === M A C R O S ========================================================= */
 
@@ -54,11 +55,12 @@ namespace software
 	class PackedSurface;
 }
 
-class TaskSurfaceResampleSW: public TaskSurfaceResample, public TaskComposite, public TaskSW
+class TaskSurfaceResampleSW: public TaskSurfaceResample, public TaskComposite, public TaskSW, public TaskSplittable
 {
 public:
 	typedef etl::handle<TaskSurfaceResampleSW> Handle;
 	Task::Handle clone() const { return clone_pointer(this); }
+	virtual void split(const RectInt &sub_target_rect);
 	virtual bool run(RunParams &params) const;
 	virtual bool is_supported_source(const Surface::Handle &surface)
 		{ return TaskSW::is_supported_source(surface) || surface.type_is<SurfaceSWPacked>(); }
@@ -38,6 +38,7 @@
 #include "target_cairo.h"
 #include "target_tile.h"
 #include "general.h"
+#include "color/colorblendspan.h"
 #include <synfig/localization.h>
 
 #ifdef HAS_VIMAGE
@@ -271,6 +272,46 @@ synfig::Surface::blit_to(alpha_pen& pen, int x, int y, int w, int h)
 		return;
 	}
 #endif
+
+	if (ColorBlendSpan::is_accelerated(pen.get_blend_method()))
+	{
+		if(x>=get_w() || y>=get_h())
+			return;
+
+		//clip source origin
+		if(x<0)
+		{
+			w+=x;	//decrease
+			x=0;
+		}
+
+		if(y<0)
+		{
+			h+=y;	//decrease
+			y=0;
+		}
+
+		//clip width against dest width
+		w = min((long)w,(long)(pen.end_x()-pen.x()));
+		h = min((long)h,(long)(pen.end_y()-pen.y()));
+
+		//clip width against src width
+		w = min(w,get_w()-x);
+		h = min(h,get_h()-y);
+
+		if(w<=0 || h<=0)
+			return;
+
+		// blend whole rows, results are the same as for per-pixel pen
+		for(int i=0;i<h;i++)
+		{
+			const Color* src(operator[](y+i)+x);
+			Color* dest((Color*)((char*)pen.x()+i*pen.get_pitch()));
+			ColorBlendSpan::blend(dest,src,w,alpha,pen.get_blend_method());
+		}
+		return;
+	}
+
 	etl::surface<Color, ColorAccumulator, ColorPrep>::blit_to(pen,x,y,w,h);
 }
 
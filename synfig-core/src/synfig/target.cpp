@@ -34,6 +34,8 @@
 #include "target_null_tile.h"
 #include "targetparam.h"
 
+#include <ETL/stringf>
+
 using namespace synfig;
 using namespace etl;
 using namespace std;
@@ -121,6 +123,15 @@ Target::create(const String &name, const String &filename,
 	return Target::Handle(book()[name].factory(filename.c_str(), params));
 }
 
+String
+Target::get_sequence_filename(const String &filename, const String &separator, int frame)
+{
+	return filename_sans_extension(filename) +
+		   separator +
+		   strprintf("%04d",frame) +
+		   filename_extension(filename);
+}
+
 int
 Target::next_frame(Time& time)
 {
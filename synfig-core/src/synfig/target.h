@@ -234,10 +234,17 @@ public:
 	 ** \returns true if the initialization has no errors
 	*/
 	virtual bool init(ProgressCallback *cb=NULL) { (void)cb; return true; }
+	//! Returns true if target writes each frame of animation into separate file,
+	//! named by get_sequence_filename()
+	virtual bool writes_frame_per_file()const { return false; }
 
 	//! Creates a new Target described by \a type, outputting to a file described by \a filename.
 	static Handle create(const String &type, const String &filename,
 						 synfig::TargetParam params);
+
+	//! Returns name of file for \a frame of image sequence,
+	//! the number is inserted before extension: "name" + \a separator + "0001.png"
+	static String get_sequence_filename(const String &filename, const String &separator, int frame);
 	
 	//!	Sets the time for the next frame at \a time
 	/*! It modifies the curr_frame_ member which has to be set to zero when next_frame is called for the first time
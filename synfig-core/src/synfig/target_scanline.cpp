@@ -44,6 +44,14 @@
 #include "rendering/software/surfacesw.h"
 #include "rendering/renderer.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include <glibmm/threads.h>
+
 #endif
 
 /* === U S I N G =========================================================== */
@@ -59,18 +67,283 @@ using namespace rendering;
 
 #define USE_PIXELRENDERING_LIMIT 1
 
+//! Default memory (in bytes) for frames queued for writing, if pipeline memory is unlimited
+#define FRAME_WRITER_MEMORY_LIMIT (256*1024*1024)
+
 /* === G L O B A L S ======================================================= */
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+//! Frames in flight for Target_Scanline::render_pipelined()
+class FramePipeline
+{
+public:
+	struct Frame
+	{
+		SurfaceSW::Handle surface;
+		//! layers of rendering task belongs to this snapshot
+		Canvas::Handle snapshot;
+		bool ready;
+		bool rendered;
+		Frame(): surface(new SurfaceSW()), ready(), rendered() { }
+	};
+
+	Target_Scanline &target;
+	Glib::Threads::Mutex mutex;
+	Glib::Threads::Cond cond;
+	std::list<Frame> frames;
+	bool closed;
+	bool failed;
+	//! Renderer failed, frames after the failed one are not passed to target
+	bool render_failed;
+	String error;
+
+	explicit FramePipeline(Target_Scanline &target):
+		target(target), closed(), failed(), render_failed() { }
+
+	//! Waits for free slot and adds new frame, returns NULL if target fails
+	Frame* reserve(int max_frames)
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		while(!failed && (int)frames.size() >= max_frames)
+			cond.wait(mutex);
+		if (failed) return NULL;
+		frames.push_back(Frame());
+		return &frames.back();
+	}
+
+	//! Marks frame as processed by renderer, calls from rendering threads,
+	//! frame which is not \a rendered fails whole pipeline
+	void finish(Frame *frame, bool rendered)
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		frame->ready = true;
+		frame->rendered = rendered;
+		cond.broadcast();
+	}
+
+	//! No more frames will be added,
+	//! if \a abort is set then remaining frames will not be passed to target
+	void close(bool abort = false)
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		closed = true;
+		if (abort) failed = true;
+		cond.broadcast();
+	}
+
+	//! Passes rendered frames to target in order of rendering,
+	//! runs in separate thread
+	void process()
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		while(true)
+		{
+			if (frames.empty())
+			{
+				if (closed) break;
+				cond.wait(mutex);
+				continue;
+			}
+
+			// frame may be released only after rendering,
+			// even if target already failed
+			if (!frames.front().ready)
+				{ cond.wait(mutex); continue; }
+
+			SurfaceSW::Handle surface = frames.front().surface;
+			if (!failed && !frames.front().rendered)
+				failed = render_failed = true;
+			if (!failed)
+			{
+				lock.release();
+				bool success = false;
+				String message;
+				try
+				{
+					success = target.add_frame(&surface->get_surface());
+				}
+				catch(String str) { message = str; }
+				catch(...) { message = _("Caught unknown error in target"); }
+				surface->destroy();
+				lock.acquire();
+				if (!success) failed = true;
+				if (error.empty()) error = message;
+			}
+
+			frames.pop_front();
+			cond.broadcast();
+		}
+	}
+};
+
+//! Task to mark frame as rendered, enqueued after all tasks of frame
+class TaskFrameDone: public rendering::Task
+{
+public:
+	typedef etl::handle<TaskFrameDone> Handle;
+
+	FramePipeline *pipeline;
+	FramePipeline::Frame *frame;
+
+	TaskFrameDone(): pipeline(), frame() { }
+
+	Task::Handle clone() const { return clone_pointer(this); }
+
+	virtual bool run(RunParams & /* params */) const
+	{
+		if (!pipeline || !frame) return false;
+		// success is cleared by renderer when any task of frame fails
+		pipeline->finish(frame, success);
+		return true;
+	}
+};
+
+} // end of anonymous namespace
+
 /* === M E T H O D S ======================================================= */
 
+//! Pool of threads which write frames by Target_Scanline::write_frame(),
+//! add_frame() waits while queue is full
+class Target_Scanline::FrameWriter
+{
+public:
+	struct Frame
+	{
+		int number;
+		Surface surface;
+		Frame(): number() { }
+	};
+
+	Target_Scanline &target;
+	Glib::Threads::Mutex mutex;
+	Glib::Threads::Cond cond;
+	std::list<Frame*> queue;
+	std::vector<Glib::Threads::Thread*> threads;
+	int max_queue;
+	int next_number;
+	bool closed;
+	//! Lowest number of failed frame, errors are reported in order of frames
+	int failed_number;
+	String error;
+
+	FrameWriter(Target_Scanline &target, int count, int first_number):
+		target(target),
+		max_queue(count),
+		next_number(first_number),
+		closed(),
+		failed_number(INT_MAX)
+	{
+		for(int i = 0; i < count; ++i)
+			threads.push_back( Glib::Threads::Thread::create(
+				sigc::mem_fun(*this, &FrameWriter::process) ));
+	}
+
+	~FrameWriter()
+	{
+		finish(true);
+	}
+
+	bool failed() const
+		{ return failed_number != INT_MAX; }
+
+	//! Waits for free place in queue, takes ownership of frame
+	bool push(Frame *frame)
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		while(!failed() && (int)queue.size() >= max_queue)
+			cond.wait(mutex);
+		if (failed() || closed)
+			{ delete frame; return false; }
+		queue.push_back(frame);
+		cond.broadcast();
+		return true;
+	}
+
+	//! Writes queued frames, runs in each thread of pool
+	void process()
+	{
+		Glib::Threads::Mutex::Lock lock(mutex);
+		while(true)
+		{
+			if (queue.empty())
+			{
+				if (closed) break;
+				cond.wait(mutex);
+				continue;
+			}
+
+			Frame *frame = queue.front();
+			queue.pop_front();
+			cond.broadcast();
+
+			// frames after failed one are not written
+			if (frame->number > failed_number)
+				{ delete frame; continue; }
+
+			lock.release();
+			bool success = false;
+			String message;
+			try
+			{
+				success = target.write_frame(frame->surface, frame->number);
+			}
+			catch(String str) { message = str; }
+			catch(std::bad_alloc) { message = _("Ran out of memory (Probably a bug)"); }
+			catch(...) { message = _("Caught unknown error in target"); }
+			int number = frame->number;
+			delete frame;
+			lock.acquire();
+
+			if (!success && number < failed_number)
+			{
+				failed_number = number;
+				error = message.empty()
+				      ? strprintf(_("Unable to write frame %d"), number)
+				      : strprintf(_("Unable to write frame %d: %s"), number, message.c_str());
+				cond.broadcast();
+			}
+		}
+	}
+
+	//! Waits until all frames will be written and stops threads,
+	//! if \a abort is set then queued frames are dropped
+	bool finish(bool abort = false)
+	{
+		{
+			Glib::Threads::Mutex::Lock lock(mutex);
+			closed = true;
+			if (abort)
+			{
+				while(!queue.empty())
+					{ delete queue.front(); queue.pop_front(); }
+			}
+			cond.broadcast();
+		}
+
+		for(std::vector<Glib::Threads::Thread*>::iterator i = threads.begin(); i != threads.end(); ++i)
+			(*i)->join();
+		threads.clear();
+		return !failed();
+	}
+};
+
 Target_Scanline::Target_Scanline():
-	threads_(2)
+	threads_(2),
+	pipeline_frames_(0),
+	pipeline_memory_(0),
+	write_threads_(0),
+	frame_writer_(NULL)
 {
 	curr_frame_=0;
 	if (const char *s = getenv("SYNFIG_TARGET_DEFAULT_ENGINE"))
 		set_engine(s);
+	if (const char *s = getenv("SYNFIG_TARGET_PIPELINE_FRAMES"))
+		set_pipeline_frames(atoi(s));
+	if (const char *s = getenv("SYNFIG_TARGET_WRITE_THREADS"))
+		set_write_threads(atoi(s));
 }
 
 int
@@ -79,8 +352,8 @@ Target_Scanline::next_frame(Time& time)
 	return Target::next_frame(time);
 }
 
-bool
-synfig::Target_Scanline::call_renderer(Context &context, const etl::handle<rendering::SurfaceSW> &surfacesw, int /* quality */, const RendDesc &renddesc, ProgressCallback * /* cb */)
+rendering::Task::Handle
+synfig::Target_Scanline::build_frame_task(Context &context, const etl::handle<rendering::SurfaceSW> &surfacesw, const RendDesc &renddesc)
 {
 	rendering::Task::Handle task;
 	surfacesw->set_size(renddesc.get_w(), renddesc.get_h());
@@ -88,14 +361,16 @@ synfig::Target_Scanline::call_renderer(Context &context, const etl::handle<rende
 		// TODO: quick hack
 		// we need to pass already sorted context to renderer
 		// when old renderer will finally removed
+		ContextParams params = context.get_params();
+		params.set_pixel_size(renddesc);
 		CanvasBase sub_queue;
 		Context sub_context;
 		if (*context && (*context)->get_canvas()) {
-			(*context)->get_canvas()->get_context_sorted(context.get_params(), sub_queue, sub_context);
+			(*context)->get_canvas()->get_context_sorted(params, sub_queue, sub_context);
 		}
 		else
 		{
-			sub_context = context;
+			sub_context = Context(context, params);
 		}
 
 		task = sub_context.build_rendering_task();
@@ -103,23 +378,180 @@ synfig::Target_Scanline::call_renderer(Context &context, const etl::handle<rende
 
 	if (task)
 	{
-		rendering::Renderer::Handle renderer = rendering::Renderer::get_renderer(get_engine());
-		if (!renderer)
-			throw "Renderer '" + get_engine() + "' not found";
-
 		task->target_surface = surfacesw;
 		task->target_surface->create();
 		task->init_target_rect(RectInt(VectorInt::zero(), surfacesw->get_size()), renddesc.get_tl(), renddesc.get_br());
+	}
+	return task;
+}
+
+bool
+synfig::Target_Scanline::call_renderer(Context &context, const etl::handle<rendering::SurfaceSW> &surfacesw, int /* quality */, const RendDesc &renddesc, ProgressCallback * /* cb */)
+{
+	rendering::Task::Handle task = build_frame_task(context, surfacesw, renddesc);
+	if (task)
+	{
+		rendering::Renderer::Handle renderer = rendering::Renderer::get_renderer(get_engine());
+		if (!renderer)
+			throw "Renderer '" + get_engine() + "' not found";
 
 		rendering::Task::List list;
 		list.push_back(task);
-		renderer->run(list);
+		return renderer->run(list);
 	}
 	return true;
 }
 
+bool
+synfig::Target_Scanline::render_pipelined(ProgressCallback *cb)
+{
+	int
+		frames=0,
+		total_frames,
+		frame_start,
+		frame_end;
+	Time
+		t=0;
+
+	rendering::Renderer::Handle renderer = rendering::Renderer::get_renderer(get_engine());
+	if (!renderer)
+		throw "Renderer '" + get_engine() + "' not found";
+
+	frame_start=desc.get_frame_start();
+	frame_end=desc.get_frame_end();
+	total_frames=frame_end-frame_start+1;
+	if(total_frames<=0)total_frames=1;
+
+	// limit frames in flight by memory budget
+	int max_frames = pipeline_frames_;
+	size_t frame_size = (size_t)desc.get_w()*(size_t)desc.get_h()*sizeof(Color);
+	if (pipeline_memory_ > 0 && frame_size > 0)
+		max_frames = std::max(1, std::min(max_frames, (int)(pipeline_memory_/frame_size)));
+	synfig::info("Pipelined rendering, up to %d frames in flight", max_frames);
+
+	ContextParams context_params(desc.get_render_excluded_contexts());
+
+	FramePipeline pipeline(*this);
+	Glib::Threads::Thread *thread = Glib::Threads::Thread::create(
+		sigc::mem_fun(pipeline, &FramePipeline::process) );
+
+	bool success = true;
+	FramePipeline::Frame *frame = NULL;
+	try
+	{
+		do{
+			// Grab the time
+			frames=next_frame(t);
+
+			// If we have a callback, and it returns
+			// false, go ahead and bail. (it may be a user cancel)
+			if(cb && !cb->amount_complete(total_frames-frames,total_frames))
+				{ success = false; break; }
+
+			// wait for free slot, while target writes oldest frames
+			frame = pipeline.reserve(max_frames);
+			if (!frame)
+				break;
+
+			// task of frame is built from snapshot of canvas, so layers used by
+			// rendering threads are not changed while next frames are prepared
+			frame->snapshot = canvas->snapshot(t, desc.get_outline_grow());
+			Context context = frame->snapshot->get_context(context_params);
+			context.set_render_method(SOFTWARE);
+
+			rendering::Task::Handle task = build_frame_task(context, frame->surface, desc);
+			if (!task)
+			{
+				pipeline.finish(frame, true);
+				frame = NULL;
+				continue;
+			}
+
+			TaskFrameDone::Handle task_done(new TaskFrameDone());
+			task_done->pipeline = &pipeline;
+			task_done->frame = frame;
+
+			rendering::Task::List list;
+			list.push_back(task);
+			renderer->enqueue(list, task_done);
+			frame = NULL;
+		}while(frames);
+	}
+	catch(...)
+	{
+		// frame which was not enqueued will never be rendered
+		if (frame) pipeline.finish(frame, false);
+		pipeline.close(true);
+		thread->join();
+		throw;
+	}
+
+	pipeline.close();
+	thread->join();
+
+	if (pipeline.render_failed)
+	{
+		if(cb)cb->error(_("Accelerated Renderer Failure"));
+		return false;
+	}
+	if (!pipeline.error.empty())
+		throw pipeline.error;
+	if (pipeline.failed)
+	{
+		if(cb)cb->error(_("Unable to put surface on target"));
+		return false;
+	}
+	return success;
+}
+
 bool
 synfig::Target_Scanline::render(ProgressCallback *cb)
+{
+	if (desc.get_frame_end() <= desc.get_frame_start() || !can_write_frames_async())
+		return render_frames(cb);
+
+	#if USE_PIXELRENDERING_LIMIT
+	// large frames are rendered and passed to target by strips
+	if (desc.get_w()*desc.get_h() > PIXEL_RENDERING_LIMIT)
+		return render_frames(cb);
+	#endif
+
+	// each thread holds one frame and the same count of frames waits in queue
+	int threads = write_threads_ > 0 ? write_threads_ : (int)g_get_num_processors();
+	size_t memory = pipeline_memory_ > 0 ? pipeline_memory_ : (size_t)FRAME_WRITER_MEMORY_LIMIT;
+	size_t frame_size = (size_t)desc.get_w()*(size_t)desc.get_h()*sizeof(Color);
+	if (frame_size > 0)
+		threads = std::min(threads, (int)std::min(memory/frame_size/2, (size_t)INT_MAX));
+	if (threads < 2)
+		return render_frames(cb);
+
+	synfig::info("Frames are written by %d threads", threads);
+	FrameWriter writer(*this, threads, desc.get_frame_start());
+	frame_writer_ = &writer;
+	bool success;
+	try
+	{
+		success = render_frames(cb);
+	}
+	catch(...)
+	{
+		frame_writer_ = NULL;
+		writer.finish(true);
+		throw;
+	}
+	frame_writer_ = NULL;
+
+	// wait for last frames
+	if (!writer.finish(!success))
+	{
+		if(cb)cb->error(writer.error);
+		return false;
+	}
+	return success;
+}
+
+bool
+synfig::Target_Scanline::render_frames(ProgressCallback *cb)
 {
 	SuperCallback super_cb;
 	int
@@ -152,6 +584,14 @@ synfig::Target_Scanline::render(ProgressCallback *cb)
 
 	//synfig::info("1time_set_to %s",t.get_string().c_str());
 
+	#if USE_PIXELRENDERING_LIMIT
+	bool use_pipeline = desc.get_w()*desc.get_h() <= PIXEL_RENDERING_LIMIT;
+	#else
+	bool use_pipeline = true;
+	#endif
+	if(use_pipeline && total_frames>1 && pipeline_frames_>1)
+		return render_pipelined(cb);
+
 	if(total_frames>=1)
 	{
 		do{
@@ -451,9 +891,17 @@ Target_Scanline::add_frame(const Surface *surface)
 {
 	assert(surface);
 
+	if (frame_writer_)
+	{
+		FrameWriter::Frame *frame = new FrameWriter::Frame();
+		frame->number = frame_writer_->next_number++;
+		frame->surface.set_wh(surface->get_w(), surface->get_h());
+		for(int y = 0; y < surface->get_h(); ++y)
+			process_alpha(frame->surface[y], (*surface)[y], surface->get_w());
+		return frame_writer_->push(frame);
+	}
 
 	int y;
-	int rowspan=sizeof(Color)*surface->get_w();
 	Surface::const_pen pen=surface->begin();
 
 	if(!start_frame())
@@ -471,27 +919,7 @@ Target_Scanline::add_frame(const Surface *surface)
 			return false;
 		}
 
-		switch(get_alpha_mode())
-		{
-			case TARGET_ALPHA_MODE_FILL:
-				for(int i=0;i<surface->get_w();i++)
-					colordata[i]=Color::blend((*surface)[y][i],desc.get_bg_color(),1.0f);
-				break;
-			case TARGET_ALPHA_MODE_EXTRACT:
-				for(int i=0;i<surface->get_w();i++)
-				{
-					float a=(*surface)[y][i].get_a();
-					colordata[i] = Color(a,a,a,a);
-				}
-				break;
-			case TARGET_ALPHA_MODE_REDUCE:
-				for(int i = 0; i < surface->get_w(); i++)
-					colordata[i] = Color((*surface)[y][i].get_r(),(*surface)[y][i].get_g(),(*surface)[y][i].get_b(),1.0f);
-				break;
-			case TARGET_ALPHA_MODE_KEEP:
-				memcpy(colordata,(*surface)[y],rowspan);
-				break;
-		}
+		process_alpha(colordata, (*surface)[y], surface->get_w());
 
 		if(!end_scanline())
 		{
@@ -504,3 +932,35 @@ Target_Scanline::add_frame(const Surface *surface)
 
 	return true;
 }
+
+void
+Target_Scanline::process_alpha(Color *dest, const Color *src, int count) const
+{
+	switch(get_alpha_mode())
+	{
+		case TARGET_ALPHA_MODE_FILL:
+			for(int i = 0; i < count; i++)
+				dest[i] = Color::blend(src[i],desc.get_bg_color(),1.0f);
+			break;
+		case TARGET_ALPHA_MODE_EXTRACT:
+			for(int i = 0; i < count; i++)
+			{
+				float a=src[i].get_a();
+				dest[i] = Color(a,a,a,a);
+			}
+			break;
+		case TARGET_ALPHA_MODE_REDUCE:
+			for(int i = 0; i < count; i++)
+				dest[i] = Color(src[i].get_r(),src[i].get_g(),src[i].get_b(),1.0f);
+			break;
+		case TARGET_ALPHA_MODE_KEEP:
+			memcpy(dest,src,sizeof(Color)*count);
+			break;
+	}
+}
+
+bool
+Target_Scanline::write_frame(const Surface & /* surface */, int /* frame */)
+{
+	return false;
+}
@@ -29,6 +29,7 @@
 /* === H E A D E R S ======================================================= */
 
 #include "target.h"
+#include "rendering/task.h"
 
 /* === M A C R O S ========================================================= */
 
@@ -51,8 +52,34 @@ class Target_Scanline : public Target
 
 	String engine_;
 
+	//! Number of frames which may be in flight simultaneously (see render_pipelined())
+	int pipeline_frames_;
+
+	//! Max memory (in bytes) for frame buffers in flight, zero means unlimited.
+	//! Also limits frames queued for writing (see write_frame()), with default limit when zero
+	size_t pipeline_memory_;
+
+	//! Number of threads which write frames (see write_frame()), zero means number of processors
+	int write_threads_;
+
+	class FrameWriter;
+	//! Pool of threads which write frames, exists only while render() runs
+	FrameWriter *frame_writer_;
+
+	rendering::Task::Handle build_frame_task(Context &context, const etl::handle<rendering::SurfaceSW> &surfacesw, const RendDesc &renddesc);
 	bool call_renderer(Context &context, const etl::handle<rendering::SurfaceSW> &surfacesw, int quality, const RendDesc &renddesc, ProgressCallback *cb);
 
+	//! Renders frames in three overlapping stages:
+	//! canvas evaluation in current thread, rendering in the rendering queue
+	//! and passing of frames to target in a separate thread
+	bool render_pipelined(ProgressCallback *cb);
+
+	//! Renders all frames, render() wraps it by pool of threads which write frames
+	bool render_frames(ProgressCallback *cb);
+
+	//! Applies alpha mode to \a count pixels of \a src and writes them into \a dest
+	void process_alpha(Color *dest, const Color *src, int count) const;
+
 public:
 	typedef etl::handle<Target_Scanline> Handle;
 	typedef etl::loose_handle<Target_Scanline> LooseHandle;
@@ -93,8 +120,22 @@ public:
 	**	\see start_scanline()
 	*/
 	virtual bool end_scanline()=0;
-	//! Sets the number of threads
 
+	//! Returns true if target can write whole frames concurrently by write_frame().
+	//! Usually these are targets which write each frame into separate file,
+	//! but not into stdout, where frames must stay in order.
+	virtual bool can_write_frames_async()const { return false; }
+
+	//! Writes whole frame with given number.
+	/*! Called from several threads simultaneously for different frames
+	**	if can_write_frames_async() returns true, instead of start_frame(),
+	**	start_scanline(), end_scanline() and end_frame() sequence.
+	**	Alpha mode is already applied to \a surface.
+	**	\return \c true on success, \c false on failure, may throw String with error message.
+	*/
+	virtual bool write_frame(const Surface &surface, int frame);
+
+	//! Sets the number of threads
 	void set_threads(int x) { threads_=x; }
 	//! Gets the number of threads
 	int get_threads()const { return threads_; }
@@ -102,6 +143,18 @@ public:
 	const String& get_engine()const { return engine_; }
 	//! Sets engine
 	void set_engine(const String &x) { engine_=x; }
+	//! Sets the number of frames in flight, values less than 2 disables pipelining
+	void set_pipeline_frames(int x) { pipeline_frames_=x; }
+	//! Gets the number of frames in flight
+	int get_pipeline_frames()const { return pipeline_frames_; }
+	//! Sets memory limit (in bytes) for frames in flight, zero means unlimited
+	void set_pipeline_memory(size_t x) { pipeline_memory_=x; }
+	//! Gets memory limit for frames in flight
+	size_t get_pipeline_memory()const { return pipeline_memory_; }
+	//! Sets the number of threads which write frames, zero means number of processors, one disables concurrent writing
+	void set_write_threads(int x) { write_threads_=x; }
+	//! Gets the number of threads which write frames
+	int get_write_threads()const { return write_threads_; }
 
 	//! Puts the rendered surface onto the target.
 	bool add_frame(const synfig::Surface *surface);
@@ -133,14 +133,16 @@ synfig::Target_Tile::call_renderer(Context &context, const etl::handle<rendering
 		// TODO: quick hack
 		// we need to pass already sorted context to renderer
 		// when old renderer will finally removed
+		ContextParams params = context.get_params();
+		params.set_pixel_size(renddesc);
 		CanvasBase sub_queue;
 		Context sub_context;
 		if (*context && (*context)->get_canvas()) {
-			(*context)->get_canvas()->get_context_sorted(context.get_params(), sub_queue, sub_context);
+			(*context)->get_canvas()->get_context_sorted(params, sub_queue, sub_context);
 		}
 		else
 		{
-			sub_context = context;
+			sub_context = Context(context, params);
 		}
 
 		task = sub_context.build_rendering_task();
@@ -45,7 +45,8 @@ struct TargetParam
 	 *  its own valid default settings.
 	 */
 	TargetParam (const std::string& Video_codec = "none", int Bitrate = -1):
-		video_codec(Video_codec), bitrate(Bitrate), sequence_separator("."), offset_x(0), offset_y(0),rows(0),columns(0),append(true),dir(HR)
+		video_codec(Video_codec), bitrate(Bitrate), sequence_separator("."), offset_x(0), offset_y(0),rows(0),columns(0),append(true),dir(HR),
+		compression_level(-1), bit_depth(-1), threads(0)
 	{ }
 
 	std::string video_codec;
@@ -58,6 +59,18 @@ struct TargetParam
 	int columns;
 	bool append;
 	Direction dir;
+	//! zlib compression level 0-9, -1 means default of target
+	int compression_level;
+	//! zlib strategy: default, filtered, huffman, rle or fixed
+	std::string compression_strategy;
+	//! PNG row filter: none, sub, up, avg, paeth or all (adaptive)
+	std::string filter;
+	//! Bits per channel, -1 means default of target
+	int bit_depth;
+	//! Threads of video encoder, 0 means number of processors
+	int threads;
+	//! Pixel format of raw video passed to encoder: rgb24, rgba, rgb48 or rgba64
+	std::string pixel_format;
 };
 
 }; // END of namespace synfig
@@ -30,7 +30,9 @@
 #include <cassert>
 #include <vector>
 #include <map>
+#include <new>
 #include <typeinfo>
+#include <type_traits>
 #include "string.h"
 
 /* === M A C R O S ========================================================= */
@@ -136,6 +138,7 @@ public:
 	enum OperationType {
 		TYPE_NONE,
 		TYPE_CREATE,
+		TYPE_CONSTRUCT,
 		TYPE_DESTROY,
 		TYPE_SET,
 		TYPE_PUT,
@@ -146,7 +149,13 @@ public:
 		TYPE_TO_STRING,
 	};
 
+	//! Size of buffer inside of ValueBase for values of small types
+	enum { InlineDataSize = 4*sizeof(double) };
+
 	typedef InternalPointer	(*CreateFunc)	();
+	//! Creates value inside of given buffer of InlineDataSize bytes,
+	//! such values are copied bytewise and never destroyed
+	typedef InternalPointer	(*ConstructFunc)(InternalPointer buffer);
 	typedef void			(*DestroyFunc)	(ConstInternalPointer);
 	typedef void			(*CopyFunc)		(InternalPointer dest, ConstInternalPointer src);
 	typedef bool			(*EqualFunc)	(ConstInternalPointer, ConstInternalPointer);
@@ -172,6 +181,9 @@ public:
 		static InternalPointer create()
 			{ return new Inner(); }
 		template<typename Inner>
+		static InternalPointer construct(InternalPointer buffer)
+			{ return new(buffer) Inner(); }
+		template<typename Inner>
 		static void destroy(ConstInternalPointer x)
 			{ return delete (Inner*)x; }
 		template<typename Inner, typename Outer>
@@ -199,6 +211,15 @@ public:
 		DefaultFuncs() { }
 	};
 
+	//! Returns true if values of type can be stored inside of ValueBase
+	template<typename Inner>
+	static bool can_construct()
+	{
+		return std::is_trivially_copyable<Inner>::value
+		    && sizeof(Inner) <= (size_t)InlineDataSize
+		    && alignof(Inner) <= alignof(double);
+	}
+
 	struct Description
 	{
 		OperationType operation_type;
@@ -226,6 +247,8 @@ public:
 
 		inline static Description get_create(TypeId type)
 			{ return Description(TYPE_CREATE, type); }
+		inline static Description get_construct(TypeId type)
+			{ return Description(TYPE_CONSTRUCT, type); }
 		inline static Description get_destroy(TypeId type)
 			{ return Description(TYPE_DESTROY, 0, type); }
 		inline static Description get_set(TypeId type)
@@ -483,6 +506,8 @@ public:
 private:
 	inline void register_create(TypeId type, Operation::CreateFunc func)
 		{ register_operation(Operation::Description::get_create(type), func); }
+	inline void register_construct(TypeId type, Operation::ConstructFunc func)
+		{ register_operation(Operation::Description::get_construct(type), func); }
 	inline void register_destroy(TypeId type, Operation::DestroyFunc func)
 		{ register_operation(Operation::Description::get_destroy(type), func); }
 	template<typename T>
@@ -517,6 +542,8 @@ protected:
 
 	inline void register_create(Operation::CreateFunc func)
 		{ register_create(identifier, func); }
+	inline void register_construct(Operation::ConstructFunc func)
+		{ register_construct(identifier, func); }
 	inline void register_destroy(Operation::DestroyFunc func)
 		{ register_destroy(identifier, func); }
 	template<typename T>
@@ -549,6 +576,8 @@ protected:
 	inline void register_all_but_compare()
 	{
 		register_create     ( Operation::DefaultFuncs::create<Inner>          );
+		if (Operation::can_construct<Inner>())
+			register_construct( Operation::DefaultFuncs::construct<Inner>     );
 		register_destroy    ( Operation::DefaultFuncs::destroy<Inner>         );
 		register_copy       ( Operation::DefaultFuncs::copy<Inner>            );
 		register_to_string  ( Operation::DefaultFuncs::to_string<Inner, Func> );
@@ -102,7 +102,7 @@ ValueBase::get_string() const
 bool
 ValueBase::is_valid()const
 {
-	return type != &type_nil && ref_count;
+	return type != &type_nil && (ref_count || is_inline());
 }
 
 void
@@ -112,6 +112,19 @@ ValueBase::create(Type &type)
 	type.initialize();
 #endif
 	if (type == type_nil) { clear(); return; }
+
+	Operation::ConstructFunc construct_func =
+		Type::get_operation<Operation::ConstructFunc>(
+			Operation::Description::get_construct(type.identifier) );
+	if (construct_func != NULL)
+	{
+		// small value, no allocations required
+		clear();
+		this->type = &type;
+		data = construct_func(&inline_data);
+		return;
+	}
+
 	Operation::CreateFunc func =
 		Type::get_operation<Operation::CreateFunc>(
 			Operation::Description::get_create(type.identifier) );
@@ -130,7 +143,7 @@ ValueBase::copy(const ValueBase& x)
 			Operation::Description::get_copy(type->identifier, x.type->identifier));
 	if (func != NULL)
 	{
-		if (!ref_count.unique()) create();
+		if (!is_unique()) create();
 		func(data, x.data);
 	}
 	else
@@ -140,7 +153,7 @@ ValueBase::copy(const ValueBase& x)
 				Operation::Description::get_copy(x.type->identifier, x.type->identifier));
 		if (func != NULL)
 		{
-			if (!ref_count.unique()) create(*x.type);
+			if (!is_unique()) create(*x.type);
 			func(data, x.data);
 		}
 	}
@@ -181,10 +194,18 @@ ValueBase::operator=(const ValueBase& x)
 				Operation::Description::get_copy(current_type.identifier, new_type.identifier) );
 		if (func != NULL)
 		{
-			create(current_type);
+			if (!is_inline()) create(current_type);
 			func(data, x.data);
 		}
 		else
+		if (x.is_inline())
+		{
+			clear();
+			type=x.type;
+			inline_data=x.inline_data;
+			data=&inline_data;
+		}
+		else
 		{
 			clear();
 			type=x.type;
@@ -201,6 +222,7 @@ ValueBase::operator=(const ValueBase& x)
 void
 ValueBase::clear()
 {
+	// inline data is never destroyed, see Operation::ConstructFunc
 	if(ref_count.unique() && data)
 	{
 		Operation::DestroyFunc func =
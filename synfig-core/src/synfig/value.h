@@ -94,6 +94,13 @@ protected:
 	bool static_;
 	//! Parameter interpolation
 	Interpolation interpolation_;
+	//! Storage for values of small types, \see Operation::ConstructFunc
+	//! Such values are never shared, so they don't need the ref_count
+	union InlineData
+	{
+		double d;
+		char bytes[Operation::InlineDataSize];
+	} inline_data;
 
 	/*
  --	** -- C O N S T R U C T O R S -----------------------------------
@@ -130,6 +137,15 @@ public:
 	//! Copy constructor. The data is not copied, just the type.
 	ValueBase(Type &x);
 
+	//! Copy constructor. Shares the data, only small values are copied.
+	ValueBase(const ValueBase &x):
+		type(x.type),data(x.data),ref_count(x.ref_count),loop_(x.loop_), static_(x.static_),
+		interpolation_(x.interpolation_)
+	{
+		if (x.is_inline())
+			{ inline_data = x.inline_data; data = &inline_data; }
+	}
+
 	//! Default destructor
 	~ValueBase();
 
@@ -342,6 +358,11 @@ private:
 	void create(Type &type);
 	inline void create() { create(*type); }
 
+	//! Returns true if the data is stored inside of this object
+	inline bool is_inline() const { return data == (const void*)&inline_data; }
+	//! Returns true if the data is not shared with other ValueBase objects
+	inline bool is_unique() const { return is_inline() || ref_count.unique(); }
+
 	template <typename T>
 	inline static bool _can_get(const TypeId type, const T &)
 	{
@@ -417,7 +438,7 @@ private:
 					Operation::Description::get_set(current_type.identifier) );
 			if (func != NULL)
 			{
-				if (!ref_count.unique()) create(current_type);
+				if (!is_unique()) create(current_type);
 				func(data, x);
 				return;
 			}
@@ -67,7 +67,10 @@ ValueNode::breakpoint()
 	return;
 }
 
-ValueNode::ValueNode(Type &type):type(&type)
+ValueNode::ValueNode(Type &type):
+	type(&type),
+	time_invariant_valid_(false),
+	time_invariant_(false)
 {
 	value_node_count++;
 }
@@ -138,6 +141,8 @@ ValueNode::on_changed()
 	if (getenv("SYNFIG_DEBUG_ON_CHANGED"))
 		printf("%s:%d ValueNode::on_changed()\n", __FILE__, __LINE__);
 
+	time_invariant_valid_ = false;
+
 	etl::loose_handle<Canvas> parent_canvas = get_parent_canvas();
 	if(parent_canvas)
 		do						// signal to all the ancestor canvases
@@ -324,8 +329,14 @@ ValueNode::calc_values(std::map<Time, ValueBase> &x, int begin, int end, Real fp
 	{
 		Real k = 1.0/fps;
 		if (begin > end) swap(begin, end);
+		std::vector<Time> times;
+		std::vector<ValueBase> values;
+		times.reserve(end - begin + 1);
 		for(int i = begin; i <= end; ++i)
-			add_value_to_map(x, i*k, (*this)(i*k));
+			times.push_back(i*k);
+		calc_values(times, values);
+		for(size_t i = 0; i < times.size(); ++i)
+			add_value_to_map(x, times[i], values[i]);
 	}
 }
 
@@ -347,12 +358,42 @@ ValueNode::calc_values(std::map<Time, ValueBase> &x) const
 	calc_values(x, begin, end, fps);
 }
 
+void
+ValueNode::calc_values(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+{
+	x.resize(times.size());
+	if (!times.empty())
+		calc_values_vfunc(times, x);
+}
+
 void
 ValueNode::get_values_vfunc(std::map<Time, ValueBase> &x) const
 {
 	calc_values(x);
 }
 
+bool
+ValueNode::is_time_invariant()const
+{
+	if (!time_invariant_valid_)
+	{
+		time_invariant_ = is_time_invariant_vfunc();
+		time_invariant_valid_ = true;
+	}
+	return time_invariant_;
+}
+
+bool
+ValueNode::is_time_invariant_vfunc()const
+	{ return false; }
+
+void
+ValueNode::calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+{
+	for(size_t i = 0; i < times.size(); ++i)
+		x[i] = (*this)(times[i]);
+}
+
 
 ValueNodeList::ValueNodeList():
 	placeholder_count_(0)
@@ -674,6 +715,18 @@ void LinkableValueNode::get_times_vfunc(Node::time_set &set) const
 	}
 }
 
+bool
+LinkableValueNode::is_time_invariant_vfunc()const
+{
+	for(int i = 0; i < link_count(); ++i)
+	{
+		ValueNode::LooseHandle link = get_link(i);
+		if (!link || !link->is_time_invariant())
+			return false;
+	}
+	return true;
+}
+
 String
 LinkableValueNode::get_description(int index, bool show_exported_name)const
 {
@@ -46,6 +46,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 #include <memory>
 
 /* === M A C R O S ========================================================= */
@@ -129,6 +130,9 @@ private:
 	etl::loose_handle<Canvas> canvas_;
 	//! The root canvas this Value Node belongs to
 	etl::loose_handle<Canvas> root_canvas_;
+	//! Cached result of is_time_invariant(), reset by on_changed()
+	mutable bool time_invariant_valid_;
+	mutable bool time_invariant_;
 
 	/*
  -- ** -- S I G N A L S -------------------------------------------------------
@@ -200,6 +204,10 @@ public:
 	virtual ValueBase operator()(Time /*t*/)const
 		{ return ValueBase(); }
 
+	//! Returns true if the ValueNode has the same value at any time.
+	//! The result is cached until the node or any of its children are changed
+	bool is_time_invariant()const;
+
 	//! \internal Sets the id of the ValueNode
 	void set_id(const String &x);
 
@@ -270,6 +278,12 @@ public:
 	void calc_values(std::map<Time, ValueBase> &x) const;
 	void calc_values(std::map<Time, ValueBase> &x, int begin, int end) const;
 	void calc_values(std::map<Time, ValueBase> &x, int begin, int end, Real fps) const;
+	//! Calculates values of the ValueNode at each of \a times at once,
+	//! values are stored to \a x in the same order.
+	//! Sorted times are the fastest case for animated value nodes.
+	//! Frame ranges of get_values() are calculated here, rendering and
+	//! exporting evaluate one time per frame through Layer::set_time().
+	void calc_values(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
 
 	int time_to_frame(Time t);
 	static int time_to_frame(Time t, Real fps);
@@ -285,7 +299,17 @@ protected:
 
 	virtual void on_changed();
 
+	//! Returns false by default, value nodes which know that their value
+	//! does not depend on time should override it
+	//! \see is_time_invariant()
+	virtual bool is_time_invariant_vfunc()const;
+
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+
+	//! Calls operator() for each time,
+	//! value nodes which can do it faster should override it
+	//! \see calc_values(const std::vector<Time>&, std::vector<ValueBase>&)
+	virtual void calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
 }; // END of class ValueNode
 
 
@@ -441,6 +465,10 @@ protected:
 	//! Returns the cached times values for all the children (linked Value Nodes)
 	virtual void get_times_vfunc(Node::time_set &set) const;
 
+	//! Returns true if all the children are time invariant, value nodes
+	//! which use time directly (linear, random, etc.) should override it
+	virtual bool is_time_invariant_vfunc()const;
+
 	//! Pure Virtual member to get the children vocabulary
 	virtual Vocab get_children_vocab_vfunc()const=0;
 
@@ -166,6 +166,43 @@ synfig::ValueNode_Add::operator()(Time t)const
 	return ValueBase();
 }
 
+void
+synfig::ValueNode_Add::calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+{
+	if(!ref_a || !ref_b)
+		throw runtime_error(strprintf("ValueNode_Add: %s",_("One or both of my parameters aren't set!")));
+
+	std::vector<ValueBase> a, b, s;
+	ref_a->calc_values(times, a);
+	ref_b->calc_values(times, b);
+	scalar->calc_values(times, s);
+
+	Type &type(get_type());
+	const size_t count = times.size();
+	if (type == type_angle)
+		for(size_t i = 0; i < count; ++i) x[i] = (a[i].get(Angle())+b[i].get(Angle()))*s[i].get(Real());
+	else
+	if (type == type_color)
+		for(size_t i = 0; i < count; ++i) x[i] = (a[i].get(Color())+b[i].get(Color()))*s[i].get(Real());
+	else
+	if (type == type_gradient)
+		for(size_t i = 0; i < count; ++i) x[i] = (a[i].get(Gradient())+b[i].get(Gradient()))*s[i].get(Real());
+	else
+	if (type == type_integer)
+		for(size_t i = 0; i < count; ++i) x[i] = round_to_int((a[i].get(int())+b[i].get(int()))*s[i].get(Real()));
+	else
+	if (type == type_real)
+		for(size_t i = 0; i < count; ++i) x[i] = (a[i].get(Vector::value_type())+b[i].get(Vector::value_type()))*s[i].get(Real());
+	else
+	if (type == type_time)
+		for(size_t i = 0; i < count; ++i) x[i] = (a[i].get(Time())+b[i].get(Time()))*s[i].get(Real());
+	else
+	if (type == type_vector)
+		for(size_t i = 0; i < count; ++i) x[i] = (a[i].get(Vector())+b[i].get(Vector()))*s[i].get(Real());
+	else
+		LinkableValueNode::calc_values_vfunc(times, x);
+}
+
 ValueBase
 synfig::ValueNode_Add::get_inverse(Time t, const synfig::Real &target_value) const
 {
@@ -66,7 +66,9 @@ public:
 	ValueBase get_inverse(Time t, const synfig::Real &target_value) const;
 	ValueBase get_inverse(Time t, const synfig::Angle &target_value) const;
 	ValueBase get_inverse(Time t, const synfig::Vector &target_value) const;
-	
+
+protected:
+	virtual void calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
 }; // END of class ValueNode_Add
 
 }; // END of namespace synfig
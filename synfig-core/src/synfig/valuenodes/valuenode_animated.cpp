@@ -112,7 +112,21 @@ void
 ValueNode_Animated::get_values_vfunc(std::map<Time, ValueBase> &x) const
 	{ ValueNode_AnimatedInterface::get_values_vfunc(x); }
 
+void
+ValueNode_Animated::calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+	{ ValueNode_AnimatedInterface::calc_values_vfunc(times, x); }
+
 void
 ValueNode_Animated::get_times_vfunc(Node::time_set &set) const
 	{ ValueNode_AnimatedInterface::get_times_vfunc(set); }
 
+bool
+ValueNode_Animated::is_time_invariant_vfunc() const
+{
+	// single waypoint gives its value at any time
+	const WaypointList &list = waypoint_list();
+	return list.size() == 1
+	    && list.front().get_value_node()
+	    && list.front().get_value_node()->is_time_invariant();
+}
+
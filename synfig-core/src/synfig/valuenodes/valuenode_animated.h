@@ -75,6 +75,8 @@ protected:
 
 	virtual void on_changed();
 	virtual void get_times_vfunc(Node::time_set &set) const;
+	virtual bool is_time_invariant_vfunc()const;
+	virtual void calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
 };
 
 }; // END of namespace synfig
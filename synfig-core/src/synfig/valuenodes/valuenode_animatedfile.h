@@ -83,6 +83,7 @@ protected:
 
 	virtual void on_changed();
 	virtual bool set_link_vfunc(int i, ValueNode::Handle x);
+	virtual bool is_time_invariant_vfunc()const { return false; }
 };
 
 }; // END of namespace synfig
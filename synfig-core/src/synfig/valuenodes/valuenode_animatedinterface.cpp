@@ -44,6 +44,8 @@
 #include <ETL/handle>
 #include <ETL/misc>
 
+#include <glib.h>
+
 #include <synfig/canvas.h>
 #include <synfig/general.h>
 #include <synfig/localization.h>
@@ -233,12 +235,62 @@ clamped_tangent<Gradient>(Gradient p1, Gradient p2, Gradient p3, Time t1, Time t
 
 class ValueNode_AnimatedInterfaceConst::Interpolator
 {
+private:
+	//! Result of previous search, frames usually are rendered sequentially,
+	//! so the next search will be started from here
+	mutable gint cursor;
+
 public:
 	ValueNode_AnimatedInterfaceConst &animated;
 
-	explicit Interpolator(ValueNode_AnimatedInterfaceConst &animated): animated(animated) { }
+	explicit Interpolator(ValueNode_AnimatedInterfaceConst &animated): cursor(0), animated(animated) { }
 	virtual ~Interpolator() { }
 
+	//! Returns index of first item of \a list sorted by time
+	//! which time (returned by \a get_time) is greater than \a t,
+	//! or size of list if there is no such item
+	template<typename T, typename TimeFunc>
+	int find_next(const std::vector<T> &list, const Time &t, TimeFunc get_time) const
+	{
+		const int size = (int)list.size();
+		int i = g_atomic_int_get(&cursor);
+		if (i < 0 || i > size) i = 0;
+
+		// check the item from previous search and the next one
+		if (i == 0 || t >= get_time(list[i-1]))
+		{
+			if (i < size && t >= get_time(list[i]))
+				++i;
+			if (i < size && t >= get_time(list[i]))
+				i = -1;
+		}
+		else
+		{
+			i = -1;
+		}
+
+		// binary search
+		if (i < 0)
+		{
+			int begin = 0, end = size;
+			while(begin < end)
+			{
+				int middle = (begin + end)/2;
+				if (t >= get_time(list[middle]))
+					begin = middle + 1;
+				else
+					end = middle;
+			}
+			i = begin;
+		}
+
+		g_atomic_int_set(&cursor, i);
+		return i;
+	}
+
+	static Time get_waypoint_time(const Waypoint &waypoint)
+		{ return waypoint.get_time(); }
+
 	virtual Interpolator* create(ValueNode_AnimatedInterfaceConst &node) const = 0;
 	virtual WaypointList::iterator new_waypoint(Time t, ValueBase value) = 0;
 	virtual WaypointList::iterator new_waypoint(Time t, ValueNode::Handle value_node) = 0;
@@ -337,6 +389,9 @@ public:
 		typedef vector<PathSegment> curve_list_type;
 		curve_list_type curve_list;
 
+		static Time get_segment_end(const PathSegment &segment)
+			{ return segment.first.get_s(); }
+
 		// Bounds of this curve
 		Time r,s;
 
@@ -648,15 +703,11 @@ public:
 			if(t>=s)
 				return animated.waypoint_list_.back().get_value(t);
 
-			typename curve_list_type::const_iterator iter;
-
-			// This next line will set iter to the
-			// correct iterator for the given time.
-			for(iter=curve_list.begin();iter<curve_list.end() && t>=iter->first.get_s();++iter)
-				continue;
-			if(iter==curve_list.end())
+			// find the segment for the given time
+			int index = Interpolator::find_next(curve_list, t, get_segment_end);
+			if(index>=(int)curve_list.size())
 				return animated.waypoint_list_.back().get_value(t);
-			return iter->resolve(t);
+			return curve_list[index].resolve(t);
 		}
 	}; // END of class Hermite
 
@@ -739,15 +790,12 @@ public:
 			if(t>=s)
 				return animated.waypoint_list_.back().get_value(t);
 
-			WaypointList::const_iterator iter;
-			WaypointList::const_iterator next;
-
-			// This next line will set iter to the
-			// correct iterator for the given time.
-			for(next=animated.waypoint_list_.begin(),iter=next++;next!=animated.waypoint_list_.end() && t>=next->get_time();iter=next++)
-				continue;
+			// find the last waypoint before the given time
+			int index = Interpolator::find_next(animated.waypoint_list_, t, Interpolator::get_waypoint_time);
+			if(index>0)
+				--index;
 
-			return iter->get_value(t);
+			return animated.waypoint_list_[index].get_value(t);
 		}
 
 		virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const
@@ -830,14 +878,12 @@ public:
 			if(t>s)
 				return animated.waypoint_list_.back().get_value(t);
 
-			WaypointList::const_iterator iter;
-			WaypointList::const_iterator next;
-
-			// This next line will set iter to the
-			// correct iterator for the given time.
-			for(next=animated.waypoint_list_.begin(),iter=next++;next!=animated.waypoint_list_.end() && t>=next->get_time();iter=next++)
-				if(iter->get_time()==t)
-					return iter->get_value(t);
+			// find the last waypoint before the given time and the next one
+			int index = Interpolator::find_next(animated.waypoint_list_, t, Interpolator::get_waypoint_time);
+			WaypointList::const_iterator next = animated.waypoint_list_.begin() + index;
+			WaypointList::const_iterator iter = next;
+			if(iter!=animated.waypoint_list_.begin())
+				--iter;
 
 			if(iter->get_time()==t)
 				return iter->get_value(t);
@@ -962,6 +1008,15 @@ void
 ValueNode_AnimatedInterfaceConst::get_values_vfunc(std::map<Time, ValueBase> &x) const
 	{ interpolator_->get_values_vfunc(x); }
 
+void
+ValueNode_AnimatedInterfaceConst::calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+{
+	// interpolators start searching from the previous segment,
+	// so sorted times are processed without searching
+	for(size_t i = 0; i < times.size(); ++i)
+		x[i] = (*interpolator_)(times[i]);
+}
+
 Waypoint
 ValueNode_AnimatedInterfaceConst::new_waypoint_at_time(const Time& time)const
 {
@@ -121,6 +121,7 @@ protected:
 	ValueBase operator()(Time t) const;
 	void get_times_vfunc(Node::time_set &set) const;
 	void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	void calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
 
 	void assign(const ValueNode_AnimatedInterfaceConst &animated, const synfig::GUID& deriv_guid);
 
@@ -305,6 +305,72 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	return (*components[0])(t);
 }
 
+void
+ValueNode_Composite::calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+{
+	Type &type(get_type());
+	int count = 0;
+	if (type == type_vector) count = 2; else
+	if (type == type_color) count = 4; else
+	if (type == type_bline_point) count = 8; else
+	if (type == type_transformation) count = 4;
+
+	if (!count)
+	{
+		// other types are rare, just call operator() for each time
+		LinkableValueNode::calc_values_vfunc(times, x);
+		return;
+	}
+
+	std::vector<ValueBase> c[MAX_LINKS];
+	for(int i = 0; i < count; ++i)
+	{
+		assert(components[i]);
+		components[i]->calc_values(times, c[i]);
+	}
+
+	for(size_t i = 0; i < times.size(); ++i)
+	{
+		if (type == type_vector)
+		{
+			x[i] = Vector(c[0][i].get(Vector::value_type()), c[1][i].get(Vector::value_type()));
+		}
+		else
+		if (type == type_color)
+		{
+			x[i] = Color(
+				c[0][i].get(Vector::value_type()),
+				c[1][i].get(Vector::value_type()),
+				c[2][i].get(Vector::value_type()),
+				c[3][i].get(Vector::value_type()) );
+		}
+		else
+		if (type == type_bline_point)
+		{
+			BLinePoint ret;
+			ret.set_vertex(c[0][i].get(Point()));
+			ret.set_width(c[1][i].get(Real()));
+			ret.set_origin(c[2][i].get(Real()));
+			ret.set_split_tangent_both(c[3][i].get(bool()));
+			ret.set_split_tangent_radius(c[6][i].get(bool()));
+			ret.set_split_tangent_angle(c[7][i].get(bool()));
+			ret.set_tangent1(c[4][i].get(Vector()));
+			ret.set_tangent2(c[5][i].get(Vector()));
+			x[i] = ret;
+		}
+		else
+		if (type == type_transformation)
+		{
+			Transformation ret;
+			ret.offset     = c[0][i].get(Vector());
+			ret.angle      = c[1][i].get(Angle());
+			ret.skew_angle = c[2][i].get(Angle());
+			ret.scale      = c[3][i].get(Vector());
+			x[i] = ret;
+		}
+	}
+}
+
 bool
 ValueNode_Composite::set_link_vfunc(int i,ValueNode::Handle x)
 {
@@ -61,6 +61,7 @@ protected:
 	virtual bool set_link_vfunc(int i,ValueNode::Handle x);
 
 	LinkableValueNode* create_new()const;
+	virtual void calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
 
 public:
 	using synfig::LinkableValueNode::set_link_vfunc;
@@ -29,6 +29,8 @@
 #	include <config.h>
 #endif
 
+#include <algorithm>
+
 #include "valuenode_const.h"
 #include "valuenode_bone.h"
 #include "valuenode_boneweightpair.h"
@@ -129,6 +131,12 @@ ValueNode_Const::operator()(Time /*t*/)const
 }
 
 
+void
+ValueNode_Const::calc_values_vfunc(const std::vector<Time> &/*times*/, std::vector<ValueBase> &x) const
+{
+	std::fill(x.begin(), x.end(), value);
+}
+
 const ValueBase &
 ValueNode_Const::get_value()const
 {
@@ -180,6 +188,15 @@ void ValueNode_Const::get_times_vfunc(Node::time_set &/*set*/) const
 {
 }
 
+bool ValueNode_Const::is_time_invariant_vfunc() const
+{
+	// content of canvas may be animated,
+	// referenced bones may be animated and changed without notification of this node
+	return value.get_type() != type_canvas
+	    && value.get_type() != type_bone_valuenode
+	    && value.get_type() != type_bone_weight_pair;
+}
+
 void ValueNode_Const::get_values_vfunc(std::map<Time, ValueBase> &x) const
 {
 	add_value_to_map(x, 0, value);
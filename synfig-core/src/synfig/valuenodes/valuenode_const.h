@@ -74,7 +74,9 @@ public:
 
 protected:
 	virtual void get_times_vfunc(Node::time_set &set) const;
+	virtual bool is_time_invariant_vfunc()const;
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	virtual void calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
 };
 
 }; // END of namespace synfig
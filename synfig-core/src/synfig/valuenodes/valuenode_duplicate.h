@@ -66,6 +66,8 @@ public:
 protected:
 	LinkableValueNode* create_new()const;
 	virtual bool set_link_vfunc(int i,ValueNode::Handle x);
+	//! value is changed by Layer_Duplicate
+	virtual bool is_time_invariant_vfunc()const { return false; }
 
 public:
 	using synfig::LinkableValueNode::get_link_vfunc;
@@ -846,6 +846,16 @@ const synfig::Node::time_set	& ValueNode_DynamicList::ListEntry::get_times() con
 	return times;
 }
 
+bool
+ValueNode_DynamicList::is_time_invariant_vfunc()const
+{
+	// entries may be enabled or disabled by activepoints
+	for(std::vector<ListEntry>::const_iterator i = list.begin(); i != list.end(); ++i)
+		if (!i->timing_info.empty())
+			return false;
+	return LinkableValueNode::is_time_invariant_vfunc();
+}
+
 void ValueNode_DynamicList::get_times_vfunc(Node::time_set &set) const
 {
 	//add in the active points
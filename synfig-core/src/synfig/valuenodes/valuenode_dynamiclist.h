@@ -230,6 +230,7 @@ protected:
 	LinkableValueNode* create_new()const;
 
 	virtual void get_times_vfunc(Node::time_set &set) const;
+	virtual bool is_time_invariant_vfunc()const;
 
 public:
 	/*! \note The construction parameter (\a id) is the type that the list
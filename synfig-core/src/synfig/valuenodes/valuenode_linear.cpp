@@ -147,6 +147,36 @@ ValueNode_Linear::operator()(Time t)const
 	return ValueBase();
 }
 
+void
+ValueNode_Linear::calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+{
+	std::vector<ValueBase> m, b;
+	m_->calc_values(times, m);
+	b_->calc_values(times, b);
+
+	Type &type(get_type());
+	const size_t count = times.size();
+	if (type == type_angle)
+		for(size_t i = 0; i < count; ++i) x[i] = m[i].get( Angle())*times[i]+b[i].get( Angle());
+	else
+	if (type == type_color)
+		for(size_t i = 0; i < count; ++i) x[i] = m[i].get( Color())*times[i]+b[i].get( Color());
+	else
+	if (type == type_integer)
+		for(size_t i = 0; i < count; ++i) x[i] = round_to_int(m[i].get(int())*times[i]+b[i].get(int()));
+	else
+	if (type == type_real)
+		for(size_t i = 0; i < count; ++i) x[i] = m[i].get(  Real())*times[i]+b[i].get(  Real());
+	else
+	if (type == type_time)
+		for(size_t i = 0; i < count; ++i) x[i] = m[i].get(  Time())*times[i]+b[i].get(  Time());
+	else
+	if (type == type_vector)
+		for(size_t i = 0; i < count; ++i) x[i] = m[i].get(Vector())*times[i]+b[i].get(Vector());
+	else
+		LinkableValueNode::calc_values_vfunc(times, x);
+}
+
 bool
 ValueNode_Linear::check_type(Type &type)
 {
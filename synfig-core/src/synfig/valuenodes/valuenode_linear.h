@@ -62,6 +62,8 @@ public:
 protected:
 	LinkableValueNode* create_new()const;
 	virtual bool set_link_vfunc(int i,ValueNode::Handle x);
+	virtual void calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const;
+	virtual bool is_time_invariant_vfunc()const { return false; }
 
 public:
 	using synfig::LinkableValueNode::get_link_vfunc;
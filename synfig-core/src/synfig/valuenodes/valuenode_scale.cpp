@@ -146,6 +146,41 @@ synfig::ValueNode_Scale::operator()(Time t)const
 	return ValueBase();
 }
 
+void
+synfig::ValueNode_Scale::calc_values_vfunc(const std::vector<Time> &times, std::vector<ValueBase> &x) const
+{
+	if(!value_node || !scalar)
+		throw runtime_error(strprintf("ValueNode_Scale: %s",_("One or both of my parameters aren't set!")));
+
+	std::vector<ValueBase> v, s;
+	value_node->calc_values(times, v);
+	scalar->calc_values(times, s);
+
+	const size_t count = times.size();
+	if(get_type()==type_angle)
+		for(size_t i = 0; i < count; ++i) x[i] = v[i].get(Angle())*s[i].get(Real());
+	else if(get_type()==type_color)
+		for(size_t i = 0; i < count; ++i)
+		{
+			Color ret(v[i].get(Color()));
+			Real k(s[i].get(Real()));
+			ret.set_r(ret.get_r()*k);
+			ret.set_g(ret.get_g()*k);
+			ret.set_b(ret.get_b()*k);
+			x[i] = ret;
+		}
+	else if(get_type()==type_integer)
+		for(size_t i = 0; i < count; ++i) x[i] = round_to_int(v[i].get(int())*s[i].get(Real()));
+	else if(get_type()==type_real)
+		for(size_t i = 0; i < count; ++i) x[i] = v[i].get(Real())*s[i].get(Real());
+	else if(get_type()==type_time)
+		for(size_t i = 0; i < count; ++i) x[i] = v[i].get(Time())*s[i].get(Time());
+	else if(get_type()==type_vector)
+		for(size_t i = 0; i < count; ++i) x[i] = v[i].get(Vector())*s[i].get(Real());
+	else
+		LinkableValueNode::calc_values_vfunc(times, x);
+}
+
 synfig::ValueBase
 synfig::ValueNode_Scale::get_inverse(Time t, const synfig::Vector &target_value) const
 {
@@ -70,6 +70,7 @@ public:
 protected:
 
 	virtual LinkableValueNode* create_new()const;
+	virtual bool is_time_invariant_vfunc()const { return false; }
 
 public:
 	using synfig::LinkableValueNode::get_link_vfunc;
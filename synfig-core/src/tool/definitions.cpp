@@ -55,6 +55,9 @@ SynfigToolGeneralOptions::SynfigToolGeneralOptions(const char* argv0)
 	_should_be_quiet = false;
 	_should_print_benchmarks = false;
 	_threads = 1;
+	_pipeline_frames = 0;
+	_pipeline_memory = 0;
+	_write_threads = 0;
 }
 
 boost::filesystem::path SynfigToolGeneralOptions::get_binary_path() const
@@ -72,6 +75,36 @@ void SynfigToolGeneralOptions::set_threads(size_t threads)
 	_threads = threads;
 }
 
+int SynfigToolGeneralOptions::get_pipeline_frames() const
+{
+	return _pipeline_frames;
+}
+
+void SynfigToolGeneralOptions::set_pipeline_frames(int frames)
+{
+	_pipeline_frames = frames;
+}
+
+size_t SynfigToolGeneralOptions::get_pipeline_memory() const
+{
+	return _pipeline_memory;
+}
+
+void SynfigToolGeneralOptions::set_pipeline_memory(size_t memory)
+{
+	_pipeline_memory = memory;
+}
+
+int SynfigToolGeneralOptions::get_write_threads() const
+{
+	return _write_threads;
+}
+
+void SynfigToolGeneralOptions::set_write_threads(int threads)
+{
+	_write_threads = threads;
+}
+
 int SynfigToolGeneralOptions::get_verbosity() const
 {
 	return _verbosity;
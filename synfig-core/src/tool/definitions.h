@@ -90,6 +90,18 @@ public:
 
 	void set_threads(size_t threads);
 
+	int get_pipeline_frames() const;
+
+	void set_pipeline_frames(int frames);
+
+	size_t get_pipeline_memory() const;
+
+	void set_pipeline_memory(size_t memory);
+
+	int get_write_threads() const;
+
+	void set_write_threads(int threads);
+
 	int get_verbosity() const;
 
 	void set_verbosity(int verbosity);
@@ -108,6 +120,9 @@ private:
 	boost::filesystem::path _binary_path;
 	int _verbosity;
 	size_t _threads;
+	int _pipeline_frames;
+	size_t _pipeline_memory;
+	int _write_threads;
 	bool _should_be_quiet,
 		 _should_print_benchmarks;
 
@@ -44,6 +44,15 @@ struct Job
 	bool list_canvases;
 	bool extract_alpha;
 
+	//! Job renders only frames from frame_start to frame_end (see --shard and --frames)
+	bool partial;
+	int frame_start;
+	int frame_end;
+
+	//! Output filename of shards which should be merged into the target (see --merge)
+	std::string merge_filename;
+	std::string sequence_separator;
+
 	bool
 		canvas_info,
 		canvas_info_all,
@@ -79,6 +88,9 @@ struct Job
 		sifout(false),
 		list_canvases(),
 		extract_alpha(false),
+		partial(false),
+		frame_start(),
+		frame_end(),
 		canvas_info(),
 		canvas_info_all(),
 		canvas_info_time_start(),
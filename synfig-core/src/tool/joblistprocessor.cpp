@@ -29,8 +29,11 @@
 #	include <config.h>
 #endif
 
+#include <cstdio>
 #include <iostream>
 #include <list>
+#include <map>
+#include <vector>
 #include <algorithm>
 #include <errno.h>
 #include <cstring>
@@ -42,12 +45,14 @@
 #include <boost/chrono.hpp>
 
 #include <autorevision.h>
+#include <ETL/stringf>
 #include <synfig/general.h>
 #include <synfig/localization.h>
 #include <synfig/canvas.h>
 #include <synfig/target.h>
 #include <synfig/layer.h>
 #include <synfig/time.h>
+#include <synfig/surface.h>
 #include <synfig/target_scanline.h>
 #include <synfig/paramdesc.h>
 #include <synfig/module.h>
@@ -68,6 +73,199 @@
 using namespace synfig;
 namespace bfs=boost::filesystem;
 
+//! Sets canvas, quality and alpha mode on the target of job
+static void configure_target(Job& job)
+{
+	VERBOSE_OUT(4) << _("Setting the canvas on the target...") << std::endl;
+	job.target->set_canvas(job.canvas);
+
+	VERBOSE_OUT(4) << _("Setting the quality of the target...") << std::endl;
+	job.target->set_quality(job.quality);
+
+	if (job.alpha_mode!=TARGET_ALPHA_MODE_KEEP)
+	{
+		VERBOSE_OUT(4) << _("Setting the alpha mode of the target...") << std::endl;
+		job.target->set_alpha_mode(job.alpha_mode);
+	}
+}
+
+//! Restricts the target of sharded job by its frames
+static bool setup_partial_job(Job& job, const TargetParam& target_parameters)
+{
+	// Targets which write each frame into separate file keep names of frames,
+	// so shards together write the same image sequence as the whole job.
+	// Single frame of sequence is named by the target in other way,
+	// and other targets write separate segment for each run of frames.
+	bool sequence = job.target->writes_frame_per_file();
+	if (!sequence || job.frame_start == job.frame_end)
+	{
+		if (sequence)
+			job.outfilename = Target::get_sequence_filename(
+				job.outfilename, target_parameters.sequence_separator, job.frame_start );
+		else
+			job.outfilename = etl::filename_sans_extension(job.outfilename)
+			                + target_parameters.sequence_separator
+			                + etl::strprintf("%04d-%04d", job.frame_start, job.frame_end)
+			                + etl::filename_extension(job.outfilename);
+
+		job.target = Target::create(job.target_name, job.outfilename, target_parameters);
+		if (!job.target)
+		{
+			synfig::error(_("Unable to create target for \"%s\""), job.outfilename.c_str());
+			return false;
+		}
+		configure_target(job);
+	}
+
+	RendDesc desc = job.target->rend_desc();
+	desc.set_frame_start(job.frame_start);
+	desc.set_frame_end(job.frame_end);
+	job.target->set_rend_desc(&desc);
+
+	VERBOSE_OUT(1) << (boost::format(_("Frames %d-%d will be written to %s"))
+						% job.frame_start % job.frame_end % job.outfilename).str()
+				   << std::endl;
+	return true;
+}
+
+//! Passes frames which are written by shards into the target of job
+static bool merge_frames(Job& job, ProgressCallback *cb)
+{
+	Target_Scanline::Handle target = Target_Scanline::Handle::cast_dynamic(job.target);
+	if (!target)
+	{
+		synfig::error(_("Target \"%s\" can't merge frames"), job.target_name.c_str());
+		return false;
+	}
+
+	// segments written by shards for targets without image sequences
+	std::map<int, std::pair<int, std::string> > segments;
+	find_segments(job.merge_filename, job.sequence_separator, segments);
+
+	if (!target->init(cb))
+	{
+		if (cb) cb->error(_("Target initialization failure"));
+		return false;
+	}
+
+	const RendDesc &desc = target->rend_desc();
+	int first = desc.get_frame_start();
+	int last = std::max(first, desc.get_frame_end());
+
+	// Importer::open() keeps only loose handles of importers,
+	// so importer of current segment is held here to read its frames sequentially
+	std::string segment_filename;
+	Importer::Handle segment_importer;
+
+	for(int frame = first; frame <= last; ++frame)
+	{
+		if (cb && !cb->amount_complete(frame - first, last - first + 1))
+			return false;
+
+		// frame of image sequence or frame inside of segment
+		std::string filename = Target::get_sequence_filename(job.merge_filename, job.sequence_separator, frame);
+		Time time = 0;
+		Importer::Handle importer;
+		if (bfs::exists(filename))
+		{
+			importer = Importer::open(FileSystemNative::instance()->get_identifier(filename));
+		}
+		else
+		{
+			std::map<int, std::pair<int, std::string> >::const_iterator i = segments.upper_bound(frame);
+			if (i == segments.begin() || (--i)->second.first < frame)
+			{
+				synfig::error(_("Frame %d is not found in \"%s\""), frame, job.merge_filename.c_str());
+				return false;
+			}
+			filename = i->second.second;
+			time = Time(frame - i->first)/desc.get_frame_rate();
+
+			if (!segment_importer || segment_filename != filename)
+			{
+				segment_filename = filename;
+				segment_importer = Importer::open(FileSystemNative::instance()->get_identifier(filename));
+			}
+			importer = segment_importer;
+		}
+
+		Surface surface;
+		if (!importer || !importer->get_frame(surface, desc, time, cb))
+		{
+			synfig::error(_("Unable to import frame %d from \"%s\""), frame, filename.c_str());
+			return false;
+		}
+		if (surface.get_w() != desc.get_w() || surface.get_h() != desc.get_h())
+		{
+			synfig::error(_("Frame %d in \"%s\" has size %dx%d instead of %dx%d"),
+				frame, filename.c_str(), surface.get_w(), surface.get_h(), desc.get_w(), desc.get_h());
+			return false;
+		}
+
+		try
+		{
+			if (!target->add_frame(&surface))
+				return false;
+		}
+		catch(const std::string &message)
+		{
+			synfig::error(message);
+			return false;
+		}
+	}
+	return true;
+}
+
+void find_segments(const std::string& filename,
+				   const std::string& sequence_separator,
+				   std::map<int, std::pair<int, std::string> >& segments)
+{
+	segments.clear();
+	const std::string prefix = etl::filename_sans_extension(filename) + sequence_separator;
+	const std::string extension = etl::filename_extension(filename);
+
+	bfs::path dir = bfs::path(prefix).parent_path();
+	if (dir.empty())
+		dir = ".";
+	const std::string name_prefix = bfs::path(prefix).filename().string();
+	if (!bfs::is_directory(dir))
+		return;
+
+	for(bfs::directory_iterator i(dir); i != bfs::directory_iterator(); ++i)
+	{
+		std::string name = i->path().filename().string();
+		if ( name.size() <= name_prefix.size() + extension.size()
+		  || name.compare(0, name_prefix.size(), name_prefix) != 0
+		  || name.compare(name.size() - extension.size(), extension.size(), extension) != 0 )
+			continue;
+
+		std::string range = name.substr(name_prefix.size(), name.size() - name_prefix.size() - extension.size());
+		int start, end;
+		char c;
+		if (sscanf(range.c_str(), "%d-%d%c", &start, &end, &c) == 2 && start <= end)
+			segments[start] = std::make_pair(end, i->path().string());
+	}
+}
+
+void split_job_list(std::list<Job>& job_list, const std::vector<int>& frames)
+{
+	std::list<Job> jobs;
+	for(std::list<Job>::const_iterator i = job_list.begin(); i != job_list.end(); ++i)
+	{
+		std::vector<int>::const_iterator j = frames.begin();
+		while(j != frames.end())
+		{
+			Job job = *i;
+			job.partial = true;
+			job.frame_start = job.frame_end = *j;
+			for(++j; j != frames.end() && *j == job.frame_end + 1; ++j)
+				job.frame_end = *j;
+			jobs.push_back(job);
+		}
+	}
+	job_list.swap(jobs);
+}
+
 void process_job_list(std::list<Job>& job_list, const TargetParam& target_params)
 {
 	if(!job_list.size())
@@ -175,24 +373,29 @@ bool setup_job(Job& job, const TargetParam& target_parameters)
 
 	// Set the Canvas on the Target
 	if(job.target)
+		configure_target(job);
+
+	// Sharded job renders only its own frames
+	if(job.target && job.partial && !setup_partial_job(job, target_parameters))
 	{
-		VERBOSE_OUT(4) << _("Setting the canvas on the target...") << std::endl;
-		job.target->set_canvas(job.canvas);
+		synfig::error(_("Throwing out job..."));
+		return false;
+	}
 
-		VERBOSE_OUT(4) << _("Setting the quality of the target...") << std::endl;
-		job.target->set_quality(job.quality);
+	job.sequence_separator = target_parameters.sequence_separator;
 
-		if (job.alpha_mode!=TARGET_ALPHA_MODE_KEEP)
-		{
-			VERBOSE_OUT(4) << _("Setting the alpha mode of the target...") << std::endl;
-			job.target->set_alpha_mode(job.alpha_mode);
-		}
+	// Set the threads, frames pipelining and writing threads for the target
+	if (Target_Scanline::Handle target = Target_Scanline::Handle::cast_dynamic(job.target))
+	{
+		target->set_threads(SynfigToolGeneralOptions::instance()->get_threads());
+		if (SynfigToolGeneralOptions::instance()->get_pipeline_frames() > 0)
+			target->set_pipeline_frames(SynfigToolGeneralOptions::instance()->get_pipeline_frames());
+		if (SynfigToolGeneralOptions::instance()->get_pipeline_memory() > 0)
+			target->set_pipeline_memory(SynfigToolGeneralOptions::instance()->get_pipeline_memory());
+		if (SynfigToolGeneralOptions::instance()->get_write_threads() > 0)
+			target->set_write_threads(SynfigToolGeneralOptions::instance()->get_write_threads());
 	}
 
-	// Set the threads for the target
-	if (job.target && Target_Scanline::Handle::cast_dynamic(job.target))
-		Target_Scanline::Handle::cast_dynamic(job.target)->set_threads(SynfigToolGeneralOptions::instance()->get_threads());
-
 	return true;
 }
 
@@ -229,6 +432,13 @@ void process_job (Job& job)
 			throw (SynfigToolException(SYNFIGTOOL_RENDERFAILURE, _("Render Failure.")));
 	}
 	else
+	if(!job.merge_filename.empty())
+	{
+		VERBOSE_OUT(1) << _("Merging...") << std::endl;
+		if(!merge_frames(job, &p))
+			throw (SynfigToolException(SYNFIGTOOL_RENDERFAILURE, _("Merge Failure.")));
+	}
+	else
 	{
 		VERBOSE_OUT(1) << _("Rendering...") << std::endl;
 		boost::chrono::system_clock::time_point start_timepoint =
@@ -26,6 +26,9 @@
 #define __SYNFIG_JOBLISTPROCESSOR_H
 
 #include <list>
+#include <map>
+#include <string>
+#include <vector>
 #include <synfig/targetparam.h>
 #include "job.h"
 
@@ -33,6 +36,15 @@
 void process_job_list(std::list<Job>& job_list,
 						const synfig::TargetParam& target_parameters);
 
+/// Replace each job by jobs which render contiguous runs of given frames
+void split_job_list(std::list<Job>& job_list, const std::vector<int>& frames);
+
+/// Find segments written by shards of a job with output into filename (see --merge)
+/// \param segments first frame -> (last frame, name of segment file)
+void find_segments(const std::string& filename,
+					const std::string& sequence_separator,
+					std::map<int, std::pair<int, std::string> >& segments);
+
 /// Prepare a job to be processed
 /// \return whether the preparation was OK or not
 bool setup_job(Job& job, const synfig::TargetParam& target_parameters);
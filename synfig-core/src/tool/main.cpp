@@ -34,6 +34,7 @@
 #include <iostream>
 #include <string>
 #include <list>
+#include <vector>
 
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
@@ -121,6 +122,9 @@ int main(int argc, char* argv[])
 		named_type<int>* quality_arg_desc = new named_type<int>("0..10");
 		named_type<float>* gamma_arg_desc = new named_type<float>("NUM (=2.2)");
 		named_type<int>* threads_arg_desc = new named_type<int>("NUM");
+		named_type<int>* pipeline_arg_desc = new named_type<int>("NUM");
+		named_type<int>* pipeline_memory_arg_desc = new named_type<int>("MB");
+		named_type<int>* write_threads_arg_desc = new named_type<int>("NUM");
 		named_type<int>* verbosity_arg_desc = new named_type<int>("NUM");
 		named_type<std::string>* canvas_arg_desc = new named_type<std::string>("canvas-id");
 		named_type<std::string>* output_file_arg_desc = new named_type<std::string>("filename");
@@ -139,6 +143,16 @@ int main(int argc, char* argv[])
 		named_type<std::string>* layer_info_field_arg_desc = new named_type<std::string>("layer-name");
 		named_type<std::string>* video_codec_arg_desc = new named_type<std::string>("codec");
 		named_type<int>* video_bitrate_arg_desc = new named_type<int>("bitrate");
+		named_type<int>* encoder_threads_arg_desc = new named_type<int>("NUM");
+		named_type<std::string>* raw_pixel_format_arg_desc = new named_type<std::string>("format");
+		named_type<std::string>* frames_arg_desc = new named_type<std::string>("list");
+		named_type<std::string>* shard_arg_desc = new named_type<std::string>("i/N");
+		named_type<std::string>* shard_mode_arg_desc = new named_type<std::string>("mode");
+		named_type<std::string>* merge_arg_desc = new named_type<std::string>("filename");
+		named_type<int>* compression_level_arg_desc = new named_type<int>("0..9");
+		named_type<std::string>* compression_strategy_arg_desc = new named_type<std::string>("strategy");
+		named_type<std::string>* png_filter_arg_desc = new named_type<std::string>("filter");
+		named_type<int>* bit_depth_arg_desc = new named_type<int>("8|16");
 
         po::options_description po_settings(_("Settings"));
         po_settings.add_options()
@@ -150,6 +164,9 @@ int main(int argc, char* argv[])
             ("quality,Q", quality_arg_desc->default_value(DEFAULT_QUALITY), (boost::format(_("Specify image quality for accelerated renderer (Default: %d)")) % DEFAULT_QUALITY).str().c_str())
             ("gamma,g", gamma_arg_desc, _("Gamma"))
             ("threads,T", threads_arg_desc, _("Enable multithreaded renderer using the specified number of threads"))
+            ("pipeline", pipeline_arg_desc, _("Keep up to NUM frames in flight (evaluation, rendering and writing of frames overlap)"))
+            ("pipeline-memory", pipeline_memory_arg_desc, _("Limit memory for frames in flight (in megabytes)"))
+            ("write-threads", write_threads_arg_desc, _("Write frames of image sequences by NUM threads (1 disables, default is number of processors)"))
             ("input-file,i", input_file_arg_desc, _("Specify input filename"))
             ("output-file,o", output_file_arg_desc, _("Specify output filename"))
             ("sequence-separator", sequence_separator_arg_desc, _("Output file sequence separator string (Use double quotes if you want to use spaces)"))
@@ -164,6 +181,14 @@ int main(int argc, char* argv[])
 			("dpi-y", dpi_y_arg_desc, _("Set the physical Y resolution (Dots-per-inch)"))
             ;
 
+        po::options_description po_shard(_("Distributed rendering options"));
+        po_shard.add_options()
+			("frames", frames_arg_desc, _("Render only listed frames, i.e. \"0,5,10-20\""))
+			("shard", shard_arg_desc, _("Render only i-th of N parts of frames (0 <= i < N)"))
+			("shard-mode", shard_mode_arg_desc, _("Split frames into contiguous (Default) or interleaved parts"))
+			("merge", merge_arg_desc, _("Write frames rendered by shards to <filename> into the target instead of rendering"))
+            ;
+
         po::options_description po_switchopts(_("Switch options"));
         po_switchopts.add_options()
             ("verbose,v", verbosity_arg_desc, _("Output verbosity level"))
@@ -183,6 +208,16 @@ int main(int argc, char* argv[])
         po_ffmpeg.add_options()
 			("video-codec", video_codec_arg_desc, _("Set the codec for the video. See --ffmpeg-video-codecs"))
             ("video-bitrate", video_bitrate_arg_desc, _("Set the bitrate for the output video"))
+            ("encoder-threads", encoder_threads_arg_desc, _("Set the number of threads of the video encoder (Default: number of processors)"))
+            ("raw-pixel-format", raw_pixel_format_arg_desc, _("Send frames to ffmpeg as raw video: rgb24, rgba, rgb48 or rgba64 (Default: PPM images)"))
+            ;
+
+        po::options_description po_png(_("PNG target options"));
+        po_png.add_options()
+			("compression-level", compression_level_arg_desc, _("Set the zlib compression level (0 is the fastest, 9 gives the smallest files)"))
+			("compression-strategy", compression_strategy_arg_desc, _("Set the zlib strategy: default, filtered, huffman, rle or fixed"))
+			("png-filter", png_filter_arg_desc, _("Set the row filter: none (Default, fastest), sub, up, avg, paeth or all (adaptive, smallest files)"))
+			("bit-depth", bit_depth_arg_desc, _("Set the bits per channel (Default: 8)"))
             ;
 
         po::options_description po_info(_("Synfig info options"));
@@ -220,7 +255,7 @@ int main(int argc, char* argv[])
         // Declare an options description instance which will include
         // all the options
         po::options_description po_all("");
-        po_all.add(po_settings).add(po_switchopts).add(po_misc).add(po_info).add(po_ffmpeg).add(po_hidden);
+        po_all.add(po_settings).add(po_switchopts).add(po_misc).add(po_info).add(po_ffmpeg).add(po_png).add(po_shard).add(po_hidden);
 
 #ifdef _DEBUG
 		po_all.add(po_debug);
@@ -229,7 +264,7 @@ int main(int argc, char* argv[])
         // Declare an options description instance which will be shown
         // to the user
         po::options_description po_visible("");
-        po_visible.add(po_settings).add(po_switchopts).add(po_misc).add(po_ffmpeg);
+        po_visible.add(po_settings).add(po_switchopts).add(po_misc).add(po_ffmpeg).add(po_png).add(po_shard);
 
 #ifdef _DEBUG
 		po_visible.add(po_debug);
@@ -284,6 +319,17 @@ int main(int argc, char* argv[])
 			job_list.push_front(job);
 		}
 
+		std::vector<int> frames;
+		if (op.extract_frames(job.desc, frames))
+		{
+			if (frames.empty())
+			{
+				VERBOSE_OUT(1) << _("No frames to render.") << std::endl;
+				return SYNFIGTOOL_OK;
+			}
+			split_job_list(job_list, frames);
+		}
+
 		process_job_list(job_list, op.extract_targetparam());
 
 		return SYNFIGTOOL_OK;
@@ -29,7 +29,10 @@
 #	include <config.h>
 #endif
 
+#include <cstdio>
 #include <iostream>
+#include <set>
+#include <sstream>
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
 
@@ -178,6 +181,26 @@ void OptionsProcessor::process_settings_options()
 
 	VERBOSE_OUT(1) << _("Threads set to ")
 				   << SynfigToolGeneralOptions::instance()->get_threads() << std::endl;
+
+	if (_vm.count("pipeline"))
+	{
+		SynfigToolGeneralOptions::instance()->set_pipeline_frames(_vm["pipeline"].as<int>());
+		VERBOSE_OUT(1) << _("Frames in flight set to ")
+					   << SynfigToolGeneralOptions::instance()->get_pipeline_frames() << std::endl;
+	}
+
+	if (_vm.count("pipeline-memory"))
+	{
+		int memory = _vm["pipeline-memory"].as<int>();
+		SynfigToolGeneralOptions::instance()->set_pipeline_memory(memory > 0 ? (size_t)memory*1024*1024 : 0);
+	}
+
+	if (_vm.count("write-threads"))
+	{
+		SynfigToolGeneralOptions::instance()->set_write_threads(_vm["write-threads"].as<int>());
+		VERBOSE_OUT(1) << _("Writing threads set to ")
+					   << SynfigToolGeneralOptions::instance()->get_write_threads() << std::endl;
+	}
 }
 
 void OptionsProcessor::process_info_options()
@@ -437,6 +460,86 @@ RendDesc OptionsProcessor::extract_renddesc(const RendDesc& renddesc)
 	return desc;
 }
 
+bool OptionsProcessor::extract_frames(const RendDesc& renddesc, std::vector<int>& frames)
+{
+	frames.clear();
+	if (!_vm.count("frames") && !_vm.count("shard"))
+		return false;
+
+	int first = renddesc.get_frame_start();
+	int last = std::max(first, renddesc.get_frame_end());
+
+	std::vector<int> selected;
+	if (_vm.count("frames"))
+	{
+		// comma separated frames and ranges, i.e. "1,5,10-20"
+		std::string list = _vm["frames"].as<std::string>();
+		std::set<int> unique;
+		std::stringstream stream(list);
+		std::string item;
+		while(std::getline(stream, item, ','))
+		{
+			int a, b;
+			char c;
+			if (sscanf(item.c_str(), "%d-%d%c", &a, &b, &c) != 2)
+			{
+				if (sscanf(item.c_str(), "%d%c", &a, &c) != 1)
+					throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+						(boost::format(_("Invalid frame list \"%s\".")) % list).str());
+				b = a;
+			}
+			if (b < a)
+				throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+					(boost::format(_("Invalid frame range \"%s\", first frame is greater than last one.")) % item).str());
+			for(int i = std::max(a, first); i <= std::min(b, last); ++i)
+				unique.insert(i);
+		}
+		selected.assign(unique.begin(), unique.end());
+	}
+	else
+	{
+		for(int i = first; i <= last; ++i)
+			selected.push_back(i);
+	}
+
+	if (_vm.count("shard"))
+	{
+		std::string shard = _vm["shard"].as<std::string>();
+		int index, count;
+		char c;
+		if (sscanf(shard.c_str(), "%d/%d%c", &index, &count, &c) != 2 || count < 1 || index < 0 || index >= count)
+			throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+				(boost::format(_("Invalid shard \"%s\", expected i/N where 0 <= i < N.")) % shard).str());
+
+		std::string mode = _vm.count("shard-mode") ? _vm["shard-mode"].as<std::string>() : "contiguous";
+		std::vector<int> part;
+		if (mode == "interleaved")
+		{
+			for(size_t i = index; i < selected.size(); i += count)
+				part.push_back(selected[i]);
+		}
+		else
+		if (mode == "contiguous")
+		{
+			part.assign(selected.begin() + selected.size()*index/count,
+						selected.begin() + selected.size()*(index + 1)/count);
+		}
+		else
+		{
+			throw SynfigToolException(SYNFIGTOOL_UNKNOWNARGUMENT,
+				(boost::format(_("Unknown shard mode \"%s\".")) % mode).str());
+		}
+		selected.swap(part);
+
+		VERBOSE_OUT(1) << (boost::format(_("Shard %d of %d (%s) renders %d frames"))
+							% index % count % mode % selected.size()).str()
+					   << std::endl;
+	}
+
+	frames.swap(selected);
+	return true;
+}
+
 TargetParam OptionsProcessor::extract_targetparam()
 {
 	TargetParam params;
@@ -483,6 +586,18 @@ TargetParam OptionsProcessor::extract_targetparam()
 		VERBOSE_OUT(1) << _("Target bitrate set to: ") << params.bitrate << "k."
 					   << std::endl;
 	}
+	if(_vm.count("encoder-threads"))
+	{
+		params.threads = _vm["encoder-threads"].as<int>();
+		VERBOSE_OUT(1) << _("Target encoder threads set to: ") << params.threads
+					   << std::endl;
+	}
+	if(_vm.count("raw-pixel-format"))
+	{
+		params.pixel_format = _vm["raw-pixel-format"].as<std::string>();
+		VERBOSE_OUT(1) << _("Target raw pixel format set to: ") << params.pixel_format
+					   << std::endl;
+	}
 	if(_vm.count("sequence-separator"))
 	{
 		params.sequence_separator = _vm["sequence-separator"].as<std::string>();
@@ -491,6 +606,30 @@ TargetParam OptionsProcessor::extract_targetparam()
                        << "'."
 					   << std::endl;
 	}
+	if(_vm.count("compression-level"))
+	{
+		params.compression_level = _vm["compression-level"].as<int>();
+		VERBOSE_OUT(1) << _("Target compression level set to: ") << params.compression_level
+					   << std::endl;
+	}
+	if(_vm.count("compression-strategy"))
+	{
+		params.compression_strategy = _vm["compression-strategy"].as<std::string>();
+		VERBOSE_OUT(1) << _("Target compression strategy set to: ") << params.compression_strategy
+					   << std::endl;
+	}
+	if(_vm.count("png-filter"))
+	{
+		params.filter = _vm["png-filter"].as<std::string>();
+		VERBOSE_OUT(1) << _("Target filter set to: ") << params.filter
+					   << std::endl;
+	}
+	if(_vm.count("bit-depth"))
+	{
+		params.bit_depth = _vm["bit-depth"].as<int>();
+		VERBOSE_OUT(1) << _("Target bit depth set to: ") << params.bit_depth
+					   << std::endl;
+	}
 
 	return params;
 }
@@ -558,6 +697,15 @@ Job OptionsProcessor::extract_job()
 		job.extract_alpha = true;
 	}
 
+	if (_vm.count("merge"))
+	{
+		if (_vm.count("shard") || _vm.count("frames"))
+			throw SynfigToolException(SYNFIGTOOL_INVALIDJOB,
+				_("Merging can't be combined with --shard or --frames options."));
+		job.merge_filename = _vm["merge"].as<std::string>();
+		VERBOSE_OUT(1) << _("Merge frames of ") << job.merge_filename << std::endl;
+	}
+
 	if (_vm.count("quality"))
 		job.quality = _vm["quality"].as<int>();
 	else
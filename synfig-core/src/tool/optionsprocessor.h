@@ -59,6 +59,11 @@ public:
 	/// Overwrite the input RendDesc object with the options given in the command line
 	synfig::RendDesc extract_renddesc(const synfig::RendDesc& renddesc);
 
+	/// Select frames of the RendDesc which should be rendered by this process
+	/// frames, shard, shard-mode
+	/// \return false if all frames should be rendered
+	bool extract_frames(const synfig::RendDesc& renddesc, std::vector<int>& frames);
+
 	/// Extract the target parameters from the options given in the command line
 	/// video-codec, bitrate, sequence-separator
 	synfig::TargetParam extract_targetparam();
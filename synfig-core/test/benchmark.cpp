@@ -0,0 +1,382 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file benchmark.cpp
+**	\brief Benchmarks of optimized code paths, not a part of tests
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <new>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+#include <ETL/stringf>
+#include <synfig/angle.h>
+#include <synfig/canvas.h>
+#include <synfig/color.h>
+#include <synfig/compiledgradient.h>
+#include <synfig/filesystemnative.h>
+#include <synfig/gamma.h>
+#include <synfig/layer.h>
+#include <synfig/loadcanvas.h>
+#include <synfig/time.h>
+#include <synfig/type.h>
+#include <synfig/value.h>
+#include <synfig/vector.h>
+#include <synfig/color/pixelformat.h>
+#include <synfig/rendering/primitive/contour.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+static long long allocations = 0;
+
+/* === P R O C E D U R E S ================================================= */
+
+void* operator new(size_t size)
+{
+	++allocations;
+	if (void *p = malloc(size ? size : 1)) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+	{ free(p); }
+
+static Real random_real()
+	{ return (Real)rand()/RAND_MAX; }
+
+// compiled gradient against Gradient::operator()
+static void benchmark_gradient()
+{
+	const int count = 2000000;
+	srand(2);
+	Gradient gradient;
+	for(int i = 0; i < 8; ++i)
+	{
+		Real pos = random_real()*1.5 - 0.25;
+		gradient.push_back(Gradient::CPoint(pos, Color(random_real(), random_real(), random_real(), random_real())));
+		if (i%3 == 0)
+			gradient.push_back(Gradient::CPoint(pos, Color(random_real(), random_real(), random_real(), 1.0)));
+	}
+	gradient.sort();
+	Real supersample = 0.001;
+
+	Real sum = 0.0;
+	clock_t t0 = clock();
+	for(int i = 0; i < count; ++i)
+		sum += gradient((Real)i/count, supersample).get_a();
+	clock_t t1 = clock();
+	CompiledGradient compiled(gradient, supersample);
+	clock_t t2 = clock();
+	for(int i = 0; i < count; ++i)
+		sum += compiled((Real)i/count, supersample).get_a();
+	clock_t t3 = clock();
+
+	printf("gradient:          %8.2f ns per pixel\n", 1e9*(t1 - t0)/CLOCKS_PER_SEC/count);
+	printf("compiled gradient: %8.2f ns per pixel (%g ms to compile)\n",
+		1e9*(t3 - t2)/CLOCKS_PER_SEC/count, 1e3*(t2 - t1)/CLOCKS_PER_SEC);
+	if (std::isnan(sum)) printf("nan\n");
+}
+
+// adaptive flattening of outline curves against fixed count of segments
+static void benchmark_flattening()
+{
+	const int count = 1000;
+	srand(2);
+	printf("flattening:\n");
+	printf("  size (px)  vertices (adaptive / fixed 50)  time (adaptive / fixed 50)\n");
+	for(Real size = 20.0; size <= 6000.0; size *= 4.0)
+	{
+		vector<Vector> points;
+		for(int i = 0; i < 4*count; ++i)
+			points.push_back(Vector(random_real(), random_real())*size);
+
+		Real offset = size*0.05;
+		long long adaptive_vertices = 0, fixed_vertices = 0;
+		Vector sum;
+		clock_t t0 = clock();
+		for(int i = 0; i < count; ++i)
+		{
+			const Vector *p = &points[4*i];
+			int segments = Contour::cubic_segments(p[0], p[3], p[1], p[2], offset, 0.25, 1000);
+			for(int j = 0; j < segments; ++j)
+			{
+				Real t = (Real)j/segments, s = 1.0 - t;
+				sum += p[0]*(s*s*s) + p[1]*(3.0*s*s*t) + p[2]*(3.0*s*t*t) + p[3]*(t*t*t);
+			}
+			adaptive_vertices += segments;
+		}
+		clock_t t1 = clock();
+		for(int i = 0; i < count; ++i)
+		{
+			const Vector *p = &points[4*i];
+			for(int j = 0; j < 50; ++j)
+			{
+				Real t = (Real)j/50, s = 1.0 - t;
+				sum += p[0]*(s*s*s) + p[1]*(3.0*s*s*t) + p[2]*(3.0*s*t*t) + p[3]*(t*t*t);
+			}
+			fixed_vertices += 50;
+		}
+		clock_t t2 = clock();
+
+		printf("  %9g  %14.1f / %-14.1f  %9.2f / %-9.2f us per curve\n",
+			size,
+			(Real)adaptive_vertices/count, (Real)fixed_vertices/count,
+			1e6*(t1 - t0)/CLOCKS_PER_SEC/count, 1e6*(t2 - t1)/CLOCKS_PER_SEC/count );
+		if (std::isnan(sum[0])) printf("nan\n");
+	}
+}
+
+// emulates ValueNode::operator()(Time), which returns new value for each call
+static ValueBase evaluate(int index, Real k)
+{
+	switch(index % 6)
+	{
+		case 0: return k;
+		case 1: return Vector(k, 1.0 - k);
+		case 2: return Color(k, k, k, 1.0);
+		case 3: return Angle::deg(360.0*k);
+		case 4: return Time(k);
+		default: break;
+	}
+	return k > 0.5;
+}
+
+// emulates evaluation of dynamic parameters by Layer::set_time()
+static void benchmark_value()
+{
+	const int frames = 10000;
+	const int count = 8;
+
+	vector<String> names;
+	for(int i = 0; i < count; ++i)
+		names.push_back(etl::strprintf("param%d", i));
+
+	map<String, ValueBase> layer_params;
+	for(int i = 0; i < count; ++i)
+		layer_params[names[i]] = evaluate(i, 0.0);
+
+	long long a0 = allocations;
+	clock_t t0 = clock();
+	for(int frame = 0; frame < frames; ++frame)
+	{
+		Real k = (Real)frame/frames;
+		map<String, ValueBase> params;
+		for(int i = 0; i < count; ++i)
+			params[names[i]] = evaluate(i, k);
+		for(map<String, ValueBase>::const_iterator i = params.begin(); i != params.end(); ++i)
+			layer_params[i->first] = i->second;
+	}
+	clock_t t1 = clock();
+	long long a1 = allocations;
+
+	// nodes of params map are allocated anyway
+	long long map_allocations = (long long)count*frames;
+	printf("values: %d parameters: %.1f allocations per value (%.1f of them for the param list), %.2f us per pass\n",
+		count,
+		(Real)(a1 - a0)/frames/count,
+		(Real)map_allocations/frames/count,
+		1e6*(t1 - t0)/CLOCKS_PER_SEC/frames );
+}
+
+// converts rows of Full HD frame by pixels and by spans
+static void benchmark_pixelformat()
+{
+	const int w = 1920;
+	const int h = 1080;
+	const int frames = 10;
+
+	srand(0);
+	vector<Color> colors(w);
+	for(int i = 0; i < w; ++i)
+		colors[i] = Color(random_real(), random_real(), random_real(), random_real());
+	vector<unsigned char> buffer(4*w);
+	Gamma gamma(1.f/2.2f);
+
+	for(int i = 0; i < 2; ++i)
+	{
+		PixelFormat pf = i ? PF_RGB|PF_A : PF_RGB;
+		clock_t t0 = clock();
+		for(int j = 0; j < frames*h; ++j)
+		{
+			unsigned char *dest = &buffer.front();
+			for(int x = 0; x < w; ++x)
+				dest = Color2PixelFormat(colors[x].clamped(), pf, dest, gamma);
+		}
+		clock_t t1 = clock();
+		for(int j = 0; j < frames*h; ++j)
+			convert_color_format(&buffer.front(), &colors.front(), w, pf, gamma);
+		clock_t t2 = clock();
+
+		printf("pixel format: %s %dx%d frame: %.2f ms by pixels, %.2f ms by spans\n",
+			i ? "RGBA" : "RGB ",
+			w, h,
+			1e3*(t1 - t0)/CLOCKS_PER_SEC/frames,
+			1e3*(t2 - t1)/CLOCKS_PER_SEC/frames );
+	}
+}
+
+// writes file with many groups of animated layers
+static long generate_canvas(const char *filename, int groups, int layers)
+{
+	FILE *f = fopen(filename, "w");
+	if (!f) return 0;
+
+	fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	fprintf(f, "<canvas version=\"1.0\" width=\"480\" height=\"270\" view-box=\"-4.0 2.25 4.0 -2.25\""
+	           " fps=\"24.000\" begin-time=\"0f\" end-time=\"5s\">\n");
+	fprintf(f, "  <defs>\n");
+	fprintf(f, "    <real id=\"amount\" value=\"1.0\"/>\n");
+	fprintf(f, "  </defs>\n");
+	for(int i = 0; i < groups; ++i)
+	{
+		fprintf(f, "  <layer type=\"group\" active=\"true\" version=\"0.2\" desc=\"group %d\">\n", i);
+		fprintf(f, "    <param name=\"canvas\">\n");
+		fprintf(f, "      <canvas>\n");
+		for(int j = 0; j < layers; ++j)
+		{
+			Real k = (Real)j/layers;
+			fprintf(f, "        <layer type=\"SolidColor\" active=\"true\" version=\"0.1\" desc=\"layer %d.%d\">\n", i, j);
+			fprintf(f, "          <param name=\"amount\" use=\"amount\"/>\n");
+			fprintf(f, "          <param name=\"color\">\n");
+			fprintf(f, "            <animated type=\"color\">\n");
+			fprintf(f, "              <waypoint time=\"0s\" before=\"clamped\" after=\"clamped\">"
+			           "<color><r>%.6f</r><g>0.250000</g><b>0.500000</b><a>1.000000</a></color></waypoint>\n", k);
+			fprintf(f, "              <waypoint time=\"2s\" before=\"clamped\" after=\"clamped\">"
+			           "<color><r>0.250000</r><g>%.6f</g><b>0.500000</b><a>1.000000</a></color></waypoint>\n", k);
+			fprintf(f, "            </animated>\n");
+			fprintf(f, "          </param>\n");
+			fprintf(f, "        </layer>\n");
+		}
+		fprintf(f, "      </canvas>\n");
+		fprintf(f, "    </param>\n");
+		fprintf(f, "  </layer>\n");
+	}
+	fprintf(f, "</canvas>\n");
+
+	long size = ftell(f);
+	fclose(f);
+	return size;
+}
+
+// every parser runs in separate process to get its own peak of memory usage
+static void benchmark_loadcanvas()
+{
+#ifndef _WIN32
+	const char filename[] = "benchmark_loadcanvas.sif";
+	long size = generate_canvas(filename, 1000, 10);
+	printf("loading of %ld KB file with 11000 layers:\n", size/1024);
+
+	for(int streaming = 0; streaming < 2; ++streaming)
+	{
+		fflush(stdout);
+		fflush(stderr);
+
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		long base_rss = usage.ru_maxrss;
+
+		struct timeval t0, t1;
+		gettimeofday(&t0, NULL);
+		pid_t pid = fork();
+		if (pid == 0)
+		{
+			String errors;
+			CanvasParser parser;
+			parser.set_streaming(streaming);
+			_exit(parser.parse_from_file_as(FileSystemNative::instance()->get_identifier(filename), filename, errors) ? 0 : 1);
+		}
+
+		int status = 1;
+		if (pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+			break;
+		gettimeofday(&t1, NULL);
+
+		printf("  %-9s parser: %.3f s, peak RSS %ld KB (%ld KB before loading)%s\n",
+			streaming ? "streaming" : "DOM",
+			(t1.tv_sec - t0.tv_sec) + 1e-6*(t1.tv_usec - t0.tv_usec),
+			usage.ru_maxrss,
+			base_rss,
+			WIFEXITED(status) && WEXITSTATUS(status) == 0 ? "" : ", failed" );
+	}
+
+	remove(filename);
+#endif
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+//! Runs benchmarks given by names in command line, or all of them
+int main(int argc, char *argv[])
+{
+	Type::subsys_init();
+	Layer::subsys_init();
+
+	struct { const char *name; void (*func)(); } benchmarks[] = {
+		{ "gradient",    &benchmark_gradient    },
+		{ "flattening",  &benchmark_flattening  },
+		{ "value",       &benchmark_value       },
+		{ "pixelformat", &benchmark_pixelformat },
+		{ "loadcanvas",  &benchmark_loadcanvas  } };
+	const int count = (int)(sizeof(benchmarks)/sizeof(benchmarks[0]));
+
+	for(int i = 0; i < count; ++i)
+	{
+		bool selected = argc < 2;
+		for(int j = 1; j < argc; ++j)
+			if (0 == strcmp(argv[j], benchmarks[i].name))
+				selected = true;
+		if (selected)
+			benchmarks[i].func();
+	}
+
+	Layer::subsys_stop();
+	Type::subsys_stop();
+	return 0;
+}
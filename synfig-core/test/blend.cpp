@@ -0,0 +1,164 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file blend.cpp
+**	\brief Blend Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <synfig/color/colorblendspan.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+static const Color::BlendMethod blend_methods[] = {
+	Color::BLEND_COMPOSITE,
+	Color::BLEND_STRAIGHT,
+	Color::BLEND_ONTO,
+	Color::BLEND_BEHIND,
+	Color::BLEND_ADD,
+	Color::BLEND_MULTIPLY,
+	Color::BLEND_SCREEN,
+	Color::BLEND_ALPHA_OVER };
+
+static const float amounts[] = { 1.f, 0.5f, 0.f, -0.5f, -1.f, 1e-7f, 1.25f };
+
+/* === P R O C E D U R E S ================================================= */
+
+static float random_channel()
+{
+	// mostly valid values, some out of range and some special ones
+	switch(rand()%16)
+	{
+	case 0: return 0.f;
+	case 1: return 1.f;
+	case 2: return -0.f;
+	case 3: return 1e-7f;
+	case 4: return (float)rand()/RAND_MAX*4.f - 2.f;
+	default: break;
+	}
+	return (float)rand()/RAND_MAX;
+}
+
+static void fill_random(vector<Color> &colors)
+{
+	for(vector<Color>::iterator i = colors.begin(); i != colors.end(); ++i)
+		*i = Color(random_channel(), random_channel(), random_channel(), random_channel());
+}
+
+static bool same(const Color &a, const Color &b)
+	{ return 0 == memcmp(&a, &b, sizeof(Color)); }
+
+// blends or fills spans by given instructions and compares them with Color::blend()
+static int check_spans(ColorBlendSpan::Instructions instructions, bool fill)
+{
+	const int count = 1027; // odd to check tails
+	int failures = 0;
+
+	ColorBlendSpan::set_instructions(instructions);
+	const char *name = ColorBlendSpan::get_instructions_name(ColorBlendSpan::get_instructions());
+
+	srand(1);
+	vector<Color> src(count), dest(count), expected(count);
+	for(size_t m = 0; m < sizeof(blend_methods)/sizeof(blend_methods[0]); ++m)
+	{
+		Color::BlendMethod method = blend_methods[m];
+		for(size_t k = 0; k < sizeof(amounts)/sizeof(amounts[0]); ++k)
+		{
+			float amount = amounts[k];
+			fill_random(src);
+			fill_random(dest);
+
+			for(int i = 0; i < count; ++i)
+				expected[i] = Color::blend(src[fill ? 0 : i], dest[i], amount, method);
+
+			if (fill)
+				ColorBlendSpan::fill(&dest.front(), src.front(), count, amount, method);
+			else
+				ColorBlendSpan::blend(&dest.front(), &src.front(), count, amount, method);
+
+			for(int i = 0; i < count; ++i)
+			{
+				if (!same(dest[i], expected[i]))
+				{
+					fprintf(stderr,
+						"%s %s: method %d, amount %g, pixel %d: (%g %g %g %g) expected (%g %g %g %g)\n",
+						name, fill ? "fill" : "blend", (int)method, amount, i,
+						dest[i].get_r(), dest[i].get_g(), dest[i].get_b(), dest[i].get_a(),
+						expected[i].get_r(), expected[i].get_g(), expected[i].get_b(), expected[i].get_a() );
+					++failures;
+					break;
+				}
+			}
+		}
+	}
+
+	return failures;
+}
+
+// blending of spans by each supported instruction set
+int blend_test1()
+{
+	int failures = 0;
+	ColorBlendSpan::Instructions supported = ColorBlendSpan::get_supported_instructions();
+	for(int i = ColorBlendSpan::INSTRUCTIONS_SCALAR; i <= supported; ++i)
+		failures += check_spans((ColorBlendSpan::Instructions)i, false);
+	return failures;
+}
+
+// filling of spans by single color
+int blend_test2()
+{
+	int failures = 0;
+	ColorBlendSpan::Instructions supported = ColorBlendSpan::get_supported_instructions();
+	for(int i = ColorBlendSpan::INSTRUCTIONS_SCALAR; i <= supported; ++i)
+		failures += check_spans((ColorBlendSpan::Instructions)i, true);
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += blend_test1();
+	failures += blend_test2();
+
+	return failures;
+}
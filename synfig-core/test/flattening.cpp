@@ -0,0 +1,174 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file flattening.cpp
+**	\brief Curve Flattening Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <synfig/rendering/primitive/contour.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+// quarter of pixel, all sizes below are in pixels
+static const Real tolerance = 0.25;
+static const int max_segments = 1000;
+
+/* === P R O C E D U R E S ================================================= */
+
+struct Curve
+{
+	Vector p0, p1, pp0, pp1;
+
+	Vector operator()(Real t) const
+	{
+		Real s = 1.0 - t;
+		return p0*(s*s*s) + pp0*(3.0*s*s*t) + pp1*(3.0*s*t*t) + p1*(t*t*t);
+	}
+
+	Vector normal(Real t) const
+	{
+		Real s = 1.0 - t;
+		Vector d = (pp0 - p0)*(3.0*s*s) + (pp1 - pp0)*(6.0*s*t) + (p1 - pp1)*(3.0*t*t);
+		return d.perp().norm();
+	}
+
+	Vector side(Real t, Real offset) const
+		{ return (*this)(t) + normal(t)*offset; }
+
+	int segments(Real offset) const
+		{ return Contour::cubic_segments(p0, p1, pp0, pp1, offset, tolerance, max_segments); }
+};
+
+static Real distance_to_segment(const Vector &p, const Vector &a, const Vector &b)
+{
+	Vector ab = b - a;
+	Real len2 = ab.mag_squared();
+	Real k = len2 > 1e-12 ? std::max(0.0, std::min(1.0, ((p - a)*ab)/len2)) : 0.0;
+	return (a + ab*k - p).mag();
+}
+
+// max distance from the side of curve to polyline with given count of segments
+static Real deviation(const Curve &curve, Real offset, int segments)
+{
+	const int substeps = 32;
+	Real max_dist = 0.0;
+	for(int i = 0; i < segments; ++i)
+	{
+		Real t0 = (Real)i/segments, t1 = (Real)(i + 1)/segments;
+		Vector a = curve.side(t0, offset), b = curve.side(t1, offset);
+		for(int j = 1; j < substeps; ++j)
+			max_dist = std::max(max_dist, distance_to_segment(curve.side(t0 + (t1 - t0)*j/substeps, offset), a, b));
+	}
+	return max_dist;
+}
+
+// quarter of circle of given radius
+static Curve arc(Real radius)
+{
+	const Real k = 0.5522847498;
+	Curve curve;
+	curve.p0  = Vector(radius, 0.0);
+	curve.pp0 = Vector(radius, radius*k);
+	curve.pp1 = Vector(radius*k, radius);
+	curve.p1  = Vector(0.0, radius);
+	return curve;
+}
+
+static Curve random_curve(Real size)
+{
+	Curve curve;
+	Vector *points[] = { &curve.p0, &curve.pp0, &curve.pp1, &curve.p1 };
+	for(int i = 0; i < 4; ++i)
+		*points[i] = Vector((Real)rand()/RAND_MAX, (Real)rand()/RAND_MAX)*size;
+	return curve;
+}
+
+// centerline of any curve
+int flattening_test1()
+{
+	int failures = 0;
+	srand(1);
+	for(int i = 0; i < 1000; ++i)
+	{
+		Curve curve = random_curve(20.0*(1 + i%200));
+		int segments = curve.segments(0.0);
+		Real dist = deviation(curve, 0.0, segments);
+		if (segments < max_segments && dist > tolerance)
+		{
+			fprintf(stderr, "curve %d: deviation %g with %d segments\n", i, dist, segments);
+			++failures;
+		}
+	}
+	return failures;
+}
+
+// sides of round outlines
+int flattening_test2()
+{
+	int failures = 0;
+	for(Real radius = 2.0; radius < 5000.0; radius *= 1.5)
+	{
+		Curve curve = arc(radius);
+		for(Real width = 0.0; width <= radius; width += radius*0.25)
+		{
+			int segments = curve.segments(width);
+			Real dist = std::max(deviation(curve, width, segments), deviation(curve, -width, segments));
+			if (segments < max_segments && dist > tolerance)
+			{
+				fprintf(stderr, "arc %g, width %g: deviation %g with %d segments\n", radius, width, dist, segments);
+				++failures;
+			}
+		}
+	}
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += flattening_test1();
+	failures += flattening_test2();
+
+	return failures;
+}
@@ -0,0 +1,187 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file gradient.cpp
+**	\brief Compiled Gradient Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <synfig/compiledgradient.h>
+#include <synfig/rendering/software/surfacesw.h>
+#include <synfig/rendering/software/task/taskgradientsw.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+// one pixel of 1000 pixels wide gradient
+static const Real pixel = 0.001;
+
+/* === P R O C E D U R E S ================================================= */
+
+// horizontal gradient from 0 to 1
+class HorizontalShape: public TaskGradient::Shape
+{
+public:
+	virtual Real get_position(const Point &point, Real &/*supersample*/) const
+		{ return point[0]; }
+};
+
+static Real random_real()
+	{ return (Real)rand()/RAND_MAX; }
+
+static Gradient random_gradient(int count, bool hard_stops)
+{
+	Gradient gradient;
+	for(int i = 0; i < count; ++i)
+	{
+		Real pos = random_real()*1.5 - 0.25;
+		Color color(random_real(), random_real(), random_real(), random_real());
+		gradient.push_back(Gradient::CPoint(pos, color));
+		if (hard_stops && i%3 == 0)
+			gradient.push_back(Gradient::CPoint(pos, Color(random_real(), random_real(), random_real(), 1.0)));
+	}
+	gradient.sort();
+	return gradient;
+}
+
+static Real difference(const Color &a, const Color &b)
+{
+	// compare premultiplied colors, color of transparent pixel is not important
+	return max( max( fabs(a.get_r()*a.get_a() - b.get_r()*b.get_a()),
+	                 fabs(a.get_g()*a.get_a() - b.get_g()*b.get_a()) ),
+	            max( fabs(b.get_b()*b.get_a() - a.get_b()*a.get_a()),
+	                 fabs(a.get_a() - b.get_a()) ) );
+}
+
+// compares compiled gradient with original one, returns count of bad gradients
+static int check_gradients(bool hard_stops, bool supersampled)
+{
+	int failures = 0;
+	srand(1);
+	for(int g = 0; g < 50; ++g)
+	{
+		// lone hard stop is not supersampled by Gradient itself, so it can't be the reference
+		Gradient gradient = random_gradient(hard_stops ? 2 + g%7 : 1 + g%8, hard_stops);
+		CompiledGradient compiled(gradient, pixel);
+
+		Real max_diff = 0.0;
+		Real max_x = 0.0, max_supersample = 0.0;
+		for(int i = 0; i < 2000; ++i)
+		{
+			Real x = random_real()*2.0 - 0.5;
+			Real supersample = supersampled ? pixel*(1 + i%5) : 0.0;
+			Real diff = difference(gradient(x, supersample), compiled(x, supersample));
+			if (diff > max_diff)
+				{ max_diff = diff; max_x = x; max_supersample = supersample; }
+		}
+
+		// one table cell is a half of pixel
+		if (max_diff > 0.5/255.0)
+		{
+			fprintf(stderr, "gradient %d: difference %g at %g (supersample %g)\n",
+				g, max_diff, max_x, max_supersample );
+			++failures;
+		}
+	}
+	return failures;
+}
+
+// smooth gradients without supersampling
+int gradient_test1()
+{
+	return check_gradients(false, false);
+}
+
+// smooth gradients with supersampling
+int gradient_test2()
+{
+	return check_gradients(false, true);
+}
+
+// hard stops, they are smoothed by one table cell when point sampled,
+// so check them with supersampling only
+int gradient_test3()
+{
+	return check_gradients(true, true);
+}
+
+// rendering task samples gradient at the same points as software rendering of layers,
+// i.e. at top left corners of pixels
+int gradient_test4()
+{
+	const int size = 4;
+
+	SurfaceSW::Handle surface(new SurfaceSW());
+	surface->set_size(size, size);
+	surface->create();
+
+	TaskGradientSW::Handle task(new TaskGradientSW());
+	task->gradient = CompiledGradient(Gradient(Color(0.0, 0.0, 0.0, 1.0), Color(1.0, 1.0, 1.0, 1.0)), 1.0/size);
+	task->shape = new HorizontalShape();
+	task->target_surface = surface;
+	task->init_target_rect(RectInt(0, 0, size, size), Point(0.0, 0.0), Point(1.0, 1.0));
+	Task::RunParams params;
+	task->run(params);
+
+	int failures = 0;
+	for(int x = 1; x < size; ++x)
+	{
+		Real expected = (Real)x/size;
+		Real r = surface->get_surface()[0][x].get_r();
+		if (fabs(r - expected) > 1.0/255.0)
+		{
+			fprintf(stderr, "gradient_test4: pixel %d is %g, expected %g\n", x, r, expected);
+			++failures;
+		}
+	}
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += gradient_test1();
+	failures += gradient_test2();
+	failures += gradient_test3();
+	failures += gradient_test4();
+
+	return failures;
+}
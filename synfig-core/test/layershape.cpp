@@ -0,0 +1,188 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file layershape.cpp
+**	\brief Layer_Shape Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <synfig/canvas.h>
+#include <synfig/context.h>
+#include <synfig/matrix.h>
+#include <synfig/type.h>
+#include <synfig/layers/layer_shape.h>
+#include <synfig/valuenodes/valuenode_animated.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === C L A S S E S ======================================================= */
+
+//! Shape which remembers the radius and the flatness tolerance of the last sync, like Circle does
+class TestShape : public Layer_Shape
+{
+private:
+	ValueBase param_radius;
+
+protected:
+	virtual void sync_vfunc()
+	{
+		synced_radius = param_radius.get(Real());
+		synced_flatness_tolerance = get_flatness_tolerance();
+	}
+
+public:
+	Real synced_radius;
+	Real synced_flatness_tolerance;
+
+	TestShape(): param_radius(Real(1.0)), synced_radius(0.0), synced_flatness_tolerance(0.0) { }
+
+	virtual bool set_shape_param(const String &param, const ValueBase &value)
+	{
+		IMPORT_VALUE(param_radius);
+		return Layer_Shape::set_shape_param(param, value);
+	}
+
+	virtual ValueBase get_param(const String &param)const
+	{
+		EXPORT_VALUE(param_radius);
+		return Layer_Shape::get_param(param);
+	}
+
+	Real get_synced_radius()const
+		{ sync(); return synced_radius; }
+
+	rendering::Task::Handle build_composite_task(const ContextParams &context_params)const
+		{ return build_composite_task_vfunc(context_params); }
+};
+
+/* === P R O C E D U R E S ================================================= */
+
+// changes animated radius and sets the same time again
+int layershape_test1()
+{
+	Time time(1.0);
+
+	ValueNode_Animated::Handle radius = ValueNode_Animated::create(type_real);
+	radius->new_waypoint(Time(0.0), Real(1.0));
+	radius->new_waypoint(time, Real(2.0));
+
+	etl::handle<TestShape> layer(new TestShape());
+	layer->connect_dynamic_param("radius", ValueNode::LooseHandle(radius));
+	Canvas::Handle canvas = Canvas::create();
+	canvas->push_back(layer);
+
+	canvas->get_independent_context().set_time(time);
+	if (layer->get_synced_radius() != 2.0)
+	{
+		cerr << "layershape_test1: radius " << layer->get_synced_radius() << " expected 2.0" << endl;
+		return 1;
+	}
+
+	// the first call of set_time() bound parameters,
+	// the second one assigns them directly where it is possible
+	canvas->get_independent_context().set_time(Time(0.0));
+	canvas->get_independent_context().set_time(time);
+
+	radius->find(time)->set_value(Real(3.0));
+	radius->changed();
+	canvas->get_independent_context().set_time(time);
+	if (layer->get_synced_radius() != 3.0)
+	{
+		cerr << "layershape_test1: radius " << layer->get_synced_radius() << " expected 3.0" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// flatness tolerance follows pixel size of rendering
+int layershape_test2()
+{
+	Canvas::Handle canvas = Canvas::create();
+	canvas->rend_desc().set_w(60);
+	canvas->rend_desc().set_h(60);
+	canvas->rend_desc().set_tl(Point(-0.5, 0.5));
+	canvas->rend_desc().set_br(Point(0.5, -0.5));
+
+	etl::handle<TestShape> layer(new TestShape());
+	canvas->push_back(layer);
+	layer->set_canvas(canvas);
+
+	// not rendered yet, pixel size of canvas is used
+	layer->get_synced_radius();
+	if (fabs(layer->synced_flatness_tolerance - 0.25/60.0) > 1e-10)
+	{
+		cerr << "layershape_test2: tolerance " << layer->synced_flatness_tolerance << " expected " << 0.25/60.0 << endl;
+		return 1;
+	}
+
+	// rendering zoomed in 4 times, like when group scales its content
+	ContextParams params;
+	params.set_pixel_size(canvas->rend_desc());
+	params = params.transformed(Matrix().set_scale(4.0));
+	layer->build_composite_task(params);
+	Real expected = 0.25/60.0/(4.0*sqrt(2.0));
+	if (fabs(layer->synced_flatness_tolerance - expected) > 1e-10)
+	{
+		cerr << "layershape_test2: tolerance " << layer->synced_flatness_tolerance << " expected " << expected << endl;
+		return 1;
+	}
+
+	// unknown pixel size keeps the last one
+	layer->build_composite_task(ContextParams());
+	if (fabs(layer->synced_flatness_tolerance - expected) > 1e-10)
+	{
+		cerr << "layershape_test2: tolerance " << layer->synced_flatness_tolerance << " expected " << expected << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	Type::subsys_init();
+
+	int failures = 0;
+
+	failures += layershape_test1();
+	failures += layershape_test2();
+
+	Type::subsys_stop();
+	return failures;
+}
@@ -0,0 +1,324 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file loadcanvas.cpp
+**	\brief Canvas Loading Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <synfig/canvas.h>
+#include <synfig/filesystemnative.h>
+#include <synfig/layer.h>
+#include <synfig/loadcanvas.h>
+#include <synfig/savecanvas.h>
+#include <synfig/type.h>
+#include <synfig/valuenodes/valuenode_animated.h>
+#include <synfig/valuenodes/valuenode_bone.h>
+#include <synfig/valuenodes/valuenode_bonelink.h>
+#include <synfig/valuenodes/valuenode_const.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+// canvases are cached by file name, so every parser reads its own copy
+static const char dom_filename[] = "loadcanvas_test_dom.sif";
+static const char stream_filename[] = "loadcanvas_test_stream.sif";
+
+/* === P R O C E D U R E S ================================================= */
+
+// writes file with structure similar to generated documents:
+// exported values and many groups of animated layers
+static long generate(const char *filename, int groups, int layers)
+{
+	FILE *f = fopen(filename, "w");
+	if (!f) return 0;
+
+	fprintf(f, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	fprintf(f, "<canvas version=\"1.0\" width=\"480\" height=\"270\" xres=\"2834.645669\" yres=\"2834.645669\""
+	           " view-box=\"-4.0 2.25 4.0 -2.25\" antialias=\"1\" fps=\"24.000\" begin-time=\"0f\" end-time=\"5s\""
+	           " bgcolor=\"0.5 0.5 0.5 1.0\">\n");
+	fprintf(f, "  <name>Generated</name>\n");
+	fprintf(f, "  <desc>Canvas for loading test</desc>\n");
+	fprintf(f, "  <meta name=\"grid_size\" content=\"0.25 0.25\"/>\n");
+	fprintf(f, "  <keyframe time=\"1s\" active=\"true\">first</keyframe>\n");
+	fprintf(f, "  <defs>\n");
+	fprintf(f, "    <real id=\"amount\" value=\"1.0\"/>\n");
+	fprintf(f, "  </defs>\n");
+	for(int i = 0; i < groups; ++i)
+	{
+		fprintf(f, "  <layer type=\"group\" active=\"true\" version=\"0.2\" desc=\"group %d\">\n", i);
+		fprintf(f, "    <param name=\"origin\"><vector><x>%.6f</x><y>0.000000</y></vector></param>\n", 0.01*i);
+		fprintf(f, "    <param name=\"canvas\">\n");
+		fprintf(f, "      <canvas>\n");
+		for(int j = 0; j < layers; ++j)
+		{
+			Real k = (Real)j/layers;
+			fprintf(f, "        <layer type=\"SolidColor\" active=\"true\" version=\"0.1\" desc=\"layer %d.%d\">\n", i, j);
+			fprintf(f, "          <param name=\"z_depth\"><real value=\"0.0\"/></param>\n");
+			fprintf(f, "          <param name=\"amount\" use=\"amount\"/>\n");
+			fprintf(f, "          <param name=\"blend_method\"><integer value=\"0\"/></param>\n");
+			fprintf(f, "          <param name=\"color\">\n");
+			fprintf(f, "            <animated type=\"color\">\n");
+			fprintf(f, "              <waypoint time=\"0s\" before=\"clamped\" after=\"clamped\">"
+			           "<color><r>%.6f</r><g>0.250000</g><b>0.500000</b><a>1.000000</a></color></waypoint>\n", k);
+			fprintf(f, "              <waypoint time=\"2s\" before=\"clamped\" after=\"clamped\">"
+			           "<color><r>0.250000</r><g>%.6f</g><b>0.500000</b><a>1.000000</a></color></waypoint>\n", k);
+			fprintf(f, "            </animated>\n");
+			fprintf(f, "          </param>\n");
+			fprintf(f, "        </layer>\n");
+		}
+		fprintf(f, "      </canvas>\n");
+		fprintf(f, "    </param>\n");
+		fprintf(f, "  </layer>\n");
+	}
+	fprintf(f, "</canvas>\n");
+
+	long size = ftell(f);
+	fclose(f);
+	return size;
+}
+
+static Canvas::Handle load(bool streaming)
+{
+	const char *filename = streaming ? stream_filename : dom_filename;
+	String errors;
+	CanvasParser parser;
+	parser.set_streaming(streaming);
+	return parser.parse_from_file_as(FileSystemNative::instance()->get_identifier(filename), filename, errors);
+}
+
+static bool equal(const Canvas::Handle &a, const Canvas::Handle &b)
+{
+	if (!a || !b || a->size() != b->size())
+		return false;
+
+	for(Canvas::const_iterator i = a->begin(), j = b->begin(); i != a->end(); ++i, ++j)
+	{
+		if ( (*i)->get_name() != (*j)->get_name()
+		  || (*i)->get_description() != (*j)->get_description()
+		  || (*i)->dynamic_param_list().size() != (*j)->dynamic_param_list().size() )
+			return false;
+
+		Layer::ParamList params_a = (*i)->get_param_list();
+		Layer::ParamList params_b = (*j)->get_param_list();
+		for(Layer::ParamList::const_iterator p = params_a.begin(); p != params_a.end(); ++p)
+		{
+			Layer::ParamList::const_iterator q = params_b.find(p->first);
+			if (q == params_b.end() || p->second.get_type() != q->second.get_type())
+				return false;
+			if (p->second.get_type() == type_canvas)
+			{
+				if (!equal(p->second.get(Canvas::LooseHandle()), q->second.get(Canvas::LooseHandle())))
+					return false;
+			}
+			else
+			if (p->second != q->second)
+				return false;
+		}
+
+		for(Layer::DynamicParamList::const_iterator p = (*i)->dynamic_param_list().begin(); p != (*i)->dynamic_param_list().end(); ++p)
+		{
+			Layer::DynamicParamList::const_iterator q = (*j)->dynamic_param_list().find(p->first);
+			if (q == (*j)->dynamic_param_list().end() || (*p->second)(Time(1.0)) != (*q->second)(Time(1.0)))
+				return false;
+		}
+	}
+	return true;
+}
+
+// loads the same document by both parsers
+static bool load_both(Canvas::Handle &dom, Canvas::Handle &stream)
+{
+	if (generate(dom_filename, 20, 5) <= 0 || generate(stream_filename, 20, 5) <= 0)
+		return false;
+	dom = load(false);
+	stream = load(true);
+	remove(dom_filename);
+	remove(stream_filename);
+	return dom && stream && dom != stream;
+}
+
+// writes file with skeleton of two bones, where only the leaf bone
+// is animated and the origin of polygon is linked to it
+static bool generate_bones(const char *filename)
+{
+	Canvas::Handle canvas = Canvas::create();
+
+	Bone root_bone;
+	root_bone.set_name("root");
+	ValueNode_Bone::Handle parent = ValueNode_Bone::create(root_bone, canvas);
+
+	Bone leaf_bone;
+	leaf_bone.set_name("leaf");
+	ValueNode_Bone::Handle leaf = ValueNode_Bone::create(leaf_bone, canvas);
+	leaf->set_link("parent", ValueNode_Const::create(ValueNode_Bone::Handle(parent)));
+
+	ValueNode_Animated::Handle origin = ValueNode_Animated::create(type_vector);
+	origin->new_waypoint(Time(0.0), Vector(0.0, 0.0));
+	origin->new_waypoint(Time(1.0), Vector(1.0, 0.0));
+	leaf->set_link("origin", origin);
+
+	ValueNode_BoneLink::Handle link = ValueNode_BoneLink::create(Vector(0.0, 0.0));
+	link->set_link("bone", ValueNode_Const::create(ValueNode_Bone::Handle(leaf)));
+
+	Layer::Handle layer = Layer::create("polygon");
+	layer->connect_dynamic_param("origin", ValueNode::LooseHandle(link));
+	canvas->push_back(layer);
+	layer->set_canvas(canvas);
+
+	return save_canvas(FileSystemNative::instance()->get_identifier(filename), canvas);
+}
+
+// origin of polygon linked to the leaf bone at time 1
+static bool check_bones(const Canvas::Handle &canvas)
+{
+	if (!canvas || canvas->size() != 1)
+		return false;
+
+	Layer::DynamicParamList::const_iterator i = canvas->front()->dynamic_param_list().find("origin");
+	if (i == canvas->front()->dynamic_param_list().end())
+		return false;
+
+	ValueNode_BoneLink::Handle link = ValueNode_BoneLink::Handle::cast_dynamic(i->second);
+	if (!link)
+		return false;
+
+	ValueNode_Bone::Handle bone = (*link->get_link("bone"))(Time(0.0)).get(ValueNode_Bone::Handle());
+	if (!bone || (*bone->get_link("name"))(Time(0.0)).get(String()) != "leaf")
+		return false;
+
+	Vector origin = (*link)(Time(1.0)).get(Vector());
+	return fabs(origin[0] - 1.0) < 1e-8 && fabs(origin[1]) < 1e-8;
+}
+
+// properties of canvas
+int loadcanvas_test1()
+{
+	Canvas::Handle dom, stream;
+	if (!load_both(dom, stream))
+	{
+		cerr << "loadcanvas_test1: canvas is not loaded" << endl;
+		return 1;
+	}
+
+	if ( stream->get_name() != "Generated"
+	  || stream->get_description() != dom->get_description()
+	  || stream->get_meta_data("grid_size") != dom->get_meta_data("grid_size")
+	  || stream->keyframe_list().size() != 1
+	  || stream->value_node_list().size() != dom->value_node_list().size() )
+	{
+		cerr << "loadcanvas_test1: different properties of canvas" << endl;
+		return 1;
+	}
+
+	const RendDesc &a = dom->rend_desc(), &b = stream->rend_desc();
+	if ( b.get_w() != 480
+	  || b.get_frame_rate() != a.get_frame_rate()
+	  || b.get_time_end() != a.get_time_end()
+	  || b.get_bg_color() != a.get_bg_color() )
+	{
+		cerr << "loadcanvas_test1: different render description of canvas" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// layers and their parameters
+int loadcanvas_test2()
+{
+	Canvas::Handle dom, stream;
+	if (!load_both(dom, stream))
+	{
+		cerr << "loadcanvas_test2: canvas is not loaded" << endl;
+		return 1;
+	}
+
+	if (stream->size() != 20 || !equal(dom, stream))
+	{
+		cerr << "loadcanvas_test2: different layers" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// bones are alive until layers are linked to them
+int loadcanvas_test3()
+{
+	if (!generate_bones(dom_filename) || !generate_bones(stream_filename))
+	{
+		cerr << "loadcanvas_test3: canvas with bones is not saved" << endl;
+		return 1;
+	}
+
+	Canvas::Handle dom = load(false);
+	Canvas::Handle stream = load(true);
+	remove(dom_filename);
+	remove(stream_filename);
+
+	if (!check_bones(dom))
+	{
+		cerr << "loadcanvas_test3: wrong bones loaded by DOM parser" << endl;
+		return 1;
+	}
+	if (!check_bones(stream))
+	{
+		cerr << "loadcanvas_test3: wrong bones loaded by streaming parser" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	Type::subsys_init();
+	Layer::subsys_init();
+
+	int failures = 0;
+
+	failures += loadcanvas_test1();
+	failures += loadcanvas_test2();
+	failures += loadcanvas_test3();
+
+	Layer::subsys_stop();
+	Type::subsys_stop();
+	return failures;
+}
@@ -0,0 +1,218 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file packedsurface.cpp
+**	\brief Packed Surface Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <synfig/rendering/software/function/packedsurface.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+using namespace rendering;
+using namespace software;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+// big enough to be packed into chunks, and not a multiple of chunk size
+static const int width = 1101;
+static const int height = 1093;
+
+/* === P R O C E D U R E S ================================================= */
+
+enum Kind {
+	KindDiscreteRGBA, // four one-byte channels
+	KindDiscreteGray, // one one-byte channel, constant alpha
+	KindFloatGray,    // gray and alpha channels of floats, noise makes them not discrete
+	KindFloatRGBA,    // four channels of floats
+	KindCount
+};
+
+// flat top left quarter is packed by RLE, noisy bottom right corner is stored as is
+static void fill(vector<Color> &pixels, int w, int h, Kind kind)
+{
+	srand(1);
+	pixels.resize(w*h);
+	for(int y = 0; y < h; ++y)
+	{
+		for(int x = 0; x < w; ++x)
+		{
+			bool flat = x < w/2 && y < h/2;
+			bool noise = x >= w - 40 && y >= h - 40;
+			Color &c = pixels[y*w + x];
+			switch(kind)
+			{
+			case KindDiscreteRGBA:
+				c.set_r(flat ? 0.25 : noise ? (rand()%4)/4.0 : (x/50%4)/4.0);
+				c.set_g(flat ? 0.50 : noise ? (rand()%4)/4.0 : (y/50%4)/4.0);
+				c.set_b(flat ? 0.75 : noise ? (rand()%4)/4.0 : ((x + y)/50%4)/4.0);
+				c.set_a(flat ? 1.00 : noise ? (rand()%4)/4.0 : 0.25 + (x/100%3)/4.0);
+				break;
+			case KindDiscreteGray:
+				c.set_r(flat ? 0.5 : noise ? (rand()%8)/8.0 : (x/50%8)/8.0);
+				c.set_g(c.get_r());
+				c.set_b(c.get_r());
+				c.set_a(1.0);
+				break;
+			case KindFloatGray:
+				c.set_r(flat ? 0.5 : noise ? (Real)rand()/RAND_MAX : (Real)x/w);
+				c.set_g(c.get_r());
+				c.set_b(c.get_r());
+				c.set_a(flat ? 1.0 : noise ? (Real)rand()/RAND_MAX : (Real)y/h);
+				break;
+			default:
+				c.set_r(flat ? 0.1 : noise ? (Real)rand()/RAND_MAX : (Real)x/w);
+				c.set_g(flat ? 0.2 : noise ? (Real)rand()/RAND_MAX : (Real)y/h);
+				c.set_b(flat ? 0.3 : noise ? (Real)rand()/RAND_MAX : (Real)(x + y)/(w + h));
+				c.set_a(flat ? 0.4 : noise ? (Real)rand()/RAND_MAX : 0.5 + 0.5*x/w);
+				break;
+			}
+		}
+	}
+}
+
+static bool equal(const Color &a, const Color &b)
+{
+	return fabs(a.get_r() - b.get_r()) < 1e-4
+	    && fabs(a.get_g() - b.get_g()) < 1e-4
+	    && fabs(a.get_b() - b.get_b()) < 1e-4
+	    && fabs(a.get_a() - b.get_a()) < 1e-4;
+}
+
+// packs and unpacks pixels, returns count of different pixels
+static int round_trip(const char *test, int w, int h, Kind kind, bool chunks)
+{
+	vector<Color> pixels;
+	fill(pixels, w, h, kind);
+
+	PackedSurface surface;
+	surface.set_pixels(&pixels.front(), w, h);
+	if (chunks && surface.get_codec() != PackedSurface::CodecRLE)
+	{
+		cerr << test << ": surface " << w << "x" << h << " of kind " << kind << " is not packed" << endl;
+		return 1;
+	}
+
+	vector<Color> unpacked(w*h);
+	surface.get_pixels(&unpacked.front());
+	for(int i = 0; i < w*h; ++i)
+	{
+		if (!equal(pixels[i], unpacked[i]))
+		{
+			cerr << test << ": surface " << w << "x" << h << " of kind " << kind
+			     << ", pixel " << i%w << ", " << i/w << " differs "
+			     << pixels[i].get_r() << " " << pixels[i].get_g() << " " << pixels[i].get_b() << " " << pixels[i].get_a() << " / "
+			     << unpacked[i].get_r() << " " << unpacked[i].get_g() << " " << unpacked[i].get_b() << " " << unpacked[i].get_a() << endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// chunks packed by RLE, with pixels of each size
+int packedsurface_test1()
+{
+	int failures = 0;
+	for(int kind = 0; kind < KindCount; ++kind)
+		failures += round_trip("packedsurface_test1", width, height, (Kind)kind, true);
+	return failures;
+}
+
+// small surfaces of odd sizes are stored without chunks
+int packedsurface_test2()
+{
+	int failures = 0;
+	for(int kind = 0; kind < KindCount; ++kind)
+	{
+		failures += round_trip("packedsurface_test2", 1, 1, (Kind)kind, false);
+		failures += round_trip("packedsurface_test2", 3, 5, (Kind)kind, false);
+		failures += round_trip("packedsurface_test2", 33, 1, (Kind)kind, false);
+	}
+	return failures;
+}
+
+// chunks unpacked by one reader are taken by others from shared cache,
+// until they are evicted by other chunks
+int packedsurface_test3()
+{
+	vector<Color> pixels;
+	fill(pixels, width, height, KindDiscreteRGBA);
+	PackedSurface surface;
+	surface.set_pixels(&pixels.front(), width, height);
+
+	PackedSurface::Reader a(surface);
+	a.get_pixel(0, 0);
+
+	long long hits = PackedSurface::get_chunk_cache_hits();
+	PackedSurface::Reader b(surface);
+	if (!equal(b.get_pixel(0, 0), pixels[0]) || PackedSurface::get_chunk_cache_hits() != hits + 1)
+	{
+		cerr << "packedsurface_test3: chunk is not taken from shared cache" << endl;
+		return 1;
+	}
+
+	// cache is limited by 1 megabyte, it's less than unpacked surface
+	for(int y = 0; y < height; ++y)
+		for(int x = 0; x < width; ++x)
+			a.get_pixel(x, y);
+
+	long long misses = PackedSurface::get_chunk_cache_misses();
+	PackedSurface::Reader c(surface);
+	if (!equal(c.get_pixel(0, 0), pixels[0]) || PackedSurface::get_chunk_cache_misses() != misses + 1)
+	{
+		cerr << "packedsurface_test3: chunk is not evicted from shared cache" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	setenv("SYNFIG_PACK_IMAGES_CODEC", "rle", 1);
+	setenv("SYNFIG_PACK_IMAGES_CACHE_SIZE", "1", 1);
+
+	int failures = 0;
+
+	failures += packedsurface_test1();
+	failures += packedsurface_test2();
+	failures += packedsurface_test3();
+
+	return failures;
+}
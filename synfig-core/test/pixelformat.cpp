@@ -0,0 +1,149 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file pixelformat.cpp
+**	\brief PixelFormat Conversion Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include <synfig/color.h>
+#include <synfig/gamma.h>
+#include <synfig/color/pixelformat.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+
+/* === P R O C E D U R E S ================================================= */
+
+static void fill(vector<Color> &colors)
+{
+	srand(0);
+	for(size_t i = 0; i < colors.size(); ++i)
+		colors[i] = Color(
+			1.2f*rand()/RAND_MAX - 0.1f,
+			1.2f*rand()/RAND_MAX - 0.1f,
+			1.2f*rand()/RAND_MAX - 0.1f,
+			1.2f*rand()/RAND_MAX - 0.1f );
+
+	// special values which should be clamped in the same way as Color::clamped() does
+	const float nan = numeric_limits<float>::quiet_NaN();
+	colors[0] = Color(nan, nan, nan, nan);
+	colors[1] = Color(-1.f, 2.f, 0.f, 1.f);
+	colors[2] = Color(1.f, 1.f, 1.f, 0.f);
+}
+
+// reference conversion, the same as convert_color_format() did before fast path
+static void convert_reference(unsigned char *dest, const Color *src, int w, PixelFormat pf, const Gamma &gamma)
+{
+	while(w--)
+		dest = Color2PixelFormat((*(src++)).clamped(), pf, dest, gamma);
+}
+
+// spans of each format should be converted as by pixels
+int pixelformat_test1()
+{
+	int failures = 0;
+
+	// odd count to check the tail of the last block
+	vector<Color> colors(1000 + 37);
+	fill(colors);
+	int w = (int)colors.size();
+
+	const PixelFormat formats[] = { PF_RGB, PF_RGB|PF_A, PF_BGR, PF_BGR|PF_A, PF_RGB|PF_A|PF_A_START, PF_GRAY };
+	const float gammas[] = { 1.f, 1.f/2.2f };
+	for(int g = 0; g < (int)(sizeof(gammas)/sizeof(gammas[0])); ++g)
+	{
+		Gamma gamma(gammas[g]);
+		for(int f = 0; f < (int)(sizeof(formats)/sizeof(formats[0])); ++f)
+		{
+			vector<unsigned char> a(w*channels(formats[f])), b(a.size());
+			convert_color_format(&a.front(), &colors.front(), w, formats[f], gamma);
+			convert_reference(&b.front(), &colors.front(), w, formats[f], gamma);
+			if (a != b)
+			{
+				fprintf(stderr, "pixelformat_test1: format %d, gamma %g: span differs from pixels\n", (int)formats[f], gammas[g]);
+				++failures;
+			}
+		}
+	}
+
+	return failures;
+}
+
+// 16-bit values should be close to 8-bit values
+int pixelformat_test2()
+{
+	int failures = 0;
+
+	vector<Color> colors(1000 + 37);
+	fill(colors);
+	int w = (int)colors.size();
+
+	const float gammas[] = { 1.f, 1.f/2.2f };
+	for(int g = 0; g < (int)(sizeof(gammas)/sizeof(gammas[0])); ++g)
+	{
+		Gamma gamma(gammas[g]);
+		vector<unsigned short> wide(4*w);
+		vector<unsigned char> narrow(4*w);
+		convert_color_format_u16(&wide.front(), &colors.front(), w, PF_RGB|PF_A, gamma);
+		convert_color_format(&narrow.front(), &colors.front(), w, PF_RGB|PF_A, gamma);
+		int max_diff = 0;
+		for(size_t i = 0; i < wide.size(); ++i)
+			max_diff = max(max_diff, abs((int)wide[i]/257 - (int)narrow[i]));
+		if (max_diff > 1)
+		{
+			fprintf(stderr, "pixelformat_test2: gamma %g: 16-bit values differ by %d\n", gammas[g], max_diff);
+			++failures;
+		}
+	}
+
+	return failures;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	int failures = 0;
+
+	failures += pixelformat_test1();
+	failures += pixelformat_test2();
+
+	return failures;
+}
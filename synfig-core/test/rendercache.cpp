@@ -0,0 +1,214 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file rendercache.cpp
+**	\brief RenderCache Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cstdlib>
+#include <iostream>
+#include <synfig/gradient.h>
+#include <synfig/real.h>
+#include <synfig/type.h>
+#include <synfig/rendering/software/function/rendercache.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+static const int renderer = 0;
+
+// key of layer with one parameter
+static software::RenderCache::Key create_key(const void *layer, Real param)
+{
+	software::RenderCache::Key key;
+	key.renderer = &renderer;
+	key.fingerprint = new TaskCache::Fingerprint();
+	key.fingerprint->add_object(layer);
+	key.fingerprint->add_value(param);
+	key.transformations.push_back(Matrix());
+	key.source_rect_lt = Vector(-1.0, 1.0);
+	key.source_rect_rb = Vector(1.0, -1.0);
+	key.target_size = VectorInt(64, 64);
+	return key;
+}
+
+static software::RenderCache::Entry::Handle create_entry(int size)
+{
+	software::RenderCache::Entry::Handle entry(new software::RenderCache::Entry());
+	entry->rect = RectInt(0, 0, size, size);
+	entry->surface.set_wh(size, size);
+	return entry;
+}
+
+// hits and misses
+int rendercache_test1()
+{
+	software::RenderCache::clear();
+	long long hits = software::RenderCache::get_hits();
+	long long misses = software::RenderCache::get_misses();
+	int layers[2];
+
+	software::RenderCache::Entry::Handle entry = create_entry(64);
+	software::RenderCache::put(create_key(&layers[0], 1.0), entry);
+
+	// equal keys are created separately, so fingerprints are compared by contents
+	if (software::RenderCache::get(create_key(&layers[0], 1.0)) != entry)
+	{
+		cerr << "rendercache_test1: entry not found by equal key" << endl;
+		return 1;
+	}
+
+	// keys with other value or other layer differ
+	if ( software::RenderCache::get(create_key(&layers[0], 2.0))
+	  || software::RenderCache::get(create_key(&layers[1], 1.0)) )
+	{
+		cerr << "rendercache_test1: entry found by different key" << endl;
+		return 1;
+	}
+
+	software::RenderCache::Key key = create_key(&layers[0], 1.0);
+	key.target_size = VectorInt(32, 32);
+	if (software::RenderCache::get(key))
+	{
+		cerr << "rendercache_test1: entry found for different target size" << endl;
+		return 1;
+	}
+
+	if ( software::RenderCache::get_hits() - hits != 1
+	  || software::RenderCache::get_misses() - misses != 3 )
+	{
+		cerr << "rendercache_test1: wrong count of hits or misses" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// replacing, eviction of least recently used entries and clearing
+int rendercache_test2()
+{
+	software::RenderCache::clear();
+	int layers[3];
+
+	software::RenderCache::Entry::Handle entry = create_entry(64);
+	software::RenderCache::put(create_key(&layers[0], 1.0), create_entry(64));
+	software::RenderCache::put(create_key(&layers[0], 1.0), entry);
+	if ( software::RenderCache::get(create_key(&layers[0], 1.0)) != entry
+	  || software::RenderCache::get_size() != entry->get_size() )
+	{
+		cerr << "rendercache_test2: entry is not replaced" << endl;
+		return 1;
+	}
+
+	// each big entry takes about a half of the cache (1 megabyte)
+	software::RenderCache::put(create_key(&layers[1], 1.0), create_entry(180));
+	software::RenderCache::get(create_key(&layers[0], 1.0));
+	software::RenderCache::put(create_key(&layers[2], 1.0), create_entry(180));
+	if ( !software::RenderCache::get(create_key(&layers[0], 1.0))
+	  || software::RenderCache::get(create_key(&layers[1], 1.0))
+	  || !software::RenderCache::get(create_key(&layers[2], 1.0)) )
+	{
+		cerr << "rendercache_test2: wrong entry is evicted" << endl;
+		return 1;
+	}
+
+	software::RenderCache::clear();
+	if ( software::RenderCache::get(create_key(&layers[0], 1.0))
+	  || software::RenderCache::get_size() != 0 )
+	{
+		cerr << "rendercache_test2: cache is not cleared" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// fingerprints compare values exactly, so small animated changes are not missed
+int rendercache_test3()
+{
+	software::RenderCache::clear();
+	int layer;
+
+	software::RenderCache::put(create_key(&layer, 1.0), create_entry(64));
+	if (software::RenderCache::get(create_key(&layer, 1.0 + 1e-12)))
+	{
+		cerr << "rendercache_test3: entry found for slightly different value" << endl;
+		return 1;
+	}
+
+	Gradient gradient(Color(0.0, 0.0, 0.0, 1.0), Color(1.0, 1.0, 1.0, 1.0));
+	TaskCache::Fingerprint a, b;
+	a.add_value(gradient);
+	gradient.begin()->color.set_r(1e-6);
+	b.add_value(gradient);
+	if (a == b)
+	{
+		cerr << "rendercache_test3: fingerprints equal for slightly different gradients" << endl;
+		return 1;
+	}
+
+	TaskCache::Fingerprint c;
+	c.add_value(String("layer"));
+	c.add_value(ValueBase::List(1, ValueBase(Vector(1.0, 2.0))));
+	TaskCache::Fingerprint d(c);
+	if (c != d || c.get_hash() != d.get_hash())
+	{
+		cerr << "rendercache_test3: copies of fingerprint differ" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	setenv("SYNFIG_RENDER_CACHE_SIZE", "1", 1);
+	Type::subsys_init();
+	software::RenderCache::initialize();
+
+	int failures = 0;
+
+	failures += rendercache_test1();
+	failures += rendercache_test2();
+	failures += rendercache_test3();
+
+	software::RenderCache::deinitialize();
+	Type::subsys_stop();
+	return failures;
+}
@@ -0,0 +1,147 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file snapshot.cpp
+**	\brief Canvas Snapshot Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <synfig/canvas.h>
+#include <synfig/layer.h>
+#include <synfig/type.h>
+#include <synfig/valuenodes/valuenode_animated.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// layer with amount animated from 0 at time 0 to 1 at time 1
+static Layer::Handle create_animated_layer()
+{
+	ValueNode_Animated::Handle amount = ValueNode_Animated::create(type_real);
+	amount->new_waypoint(Time(0.0), Real(0.0));
+	amount->new_waypoint(Time(1.0), Real(1.0));
+
+	Layer::Handle layer = Layer::create("SolidColor");
+	layer->connect_dynamic_param("amount", ValueNode::LooseHandle(amount));
+	return layer;
+}
+
+static Real get_amount(const Layer::Handle &layer)
+	{ return layer->get_param("amount").get(Real()); }
+
+// snapshot is evaluated at its own time and original canvas stays unchanged
+int snapshot_test1()
+{
+	Canvas::Handle canvas = Canvas::create();
+	Layer::Handle layer = create_animated_layer();
+	canvas->push_back(layer);
+	layer->set_canvas(canvas);
+	canvas->set_time(Time(0.0));
+
+	Canvas::Handle snapshot = canvas->snapshot(Time(0.5));
+	if (snapshot->size() != 1 || snapshot->front()->get_snapshot_source() != layer)
+	{
+		cerr << "snapshot_test1: snapshot has wrong layers" << endl;
+		return 1;
+	}
+	if (fabs(get_amount(snapshot->front()) - 0.5) > 1e-8)
+	{
+		cerr << "snapshot_test1: amount " << get_amount(snapshot->front()) << " expected 0.5" << endl;
+		return 1;
+	}
+	if (fabs(get_amount(layer)) > 1e-8 || !layer->get_time_mark().is_equal(Time(0.0)))
+	{
+		cerr << "snapshot_test1: original layer is changed" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// sub-canvas of group gets its own snapshot with time offset of group
+int snapshot_test2()
+{
+	Canvas::Handle canvas = Canvas::create();
+	Canvas::Handle sub_canvas = Canvas::create_inline(canvas);
+	Layer::Handle layer = create_animated_layer();
+	sub_canvas->push_back(layer);
+	layer->set_canvas(sub_canvas);
+
+	Layer::Handle group = Layer::create("group");
+	group->set_param("canvas", ValueBase(sub_canvas));
+	group->set_param("time_offset", ValueBase(Time(0.25)));
+	canvas->push_back(group);
+	group->set_canvas(canvas);
+	canvas->set_time(Time(0.0));
+
+	Canvas::Handle snapshot = canvas->snapshot(Time(0.5));
+	Canvas::Handle sub_snapshot = snapshot->front()->get_param("canvas").get(Canvas::Handle());
+	if (!sub_snapshot || sub_snapshot == sub_canvas || sub_snapshot->size() != 1)
+	{
+		cerr << "snapshot_test2: sub-canvas is not a snapshot" << endl;
+		return 1;
+	}
+	if (fabs(get_amount(sub_snapshot->front()) - 0.75) > 1e-8)
+	{
+		cerr << "snapshot_test2: amount " << get_amount(sub_snapshot->front()) << " expected 0.75" << endl;
+		return 1;
+	}
+	if (fabs(get_amount(layer) - 0.25) > 1e-8)
+	{
+		cerr << "snapshot_test2: original layer is changed" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	Type::subsys_init();
+	Layer::subsys_init();
+
+	int failures = 0;
+
+	failures += snapshot_test1();
+	failures += snapshot_test2();
+
+	Layer::subsys_stop();
+	Type::subsys_stop();
+	return failures;
+}
@@ -0,0 +1,141 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file timeinvariant.cpp
+**	\brief Time Invariant Layers Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <synfig/bone.h>
+#include <synfig/canvas.h>
+#include <synfig/layer.h>
+#include <synfig/type.h>
+#include <synfig/valuenodes/valuenode_animated.h>
+#include <synfig/valuenodes/valuenode_bone.h>
+#include <synfig/valuenodes/valuenode_bonelink.h>
+#include <synfig/valuenodes/valuenode_const.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+static ValueNode::Handle create_animated_origin()
+{
+	ValueNode_Animated::Handle origin = ValueNode_Animated::create(type_vector);
+	origin->new_waypoint(Time(0.0), Vector(0.0, 0.0));
+	origin->new_waypoint(Time(1.0), Vector(1.0, 0.0));
+	return origin;
+}
+
+// polygon with origin linked to bone
+static Layer::Handle create_layer(const Canvas::Handle &canvas, const ValueNode_Bone::Handle &bone)
+{
+	ValueNode_BoneLink::Handle link = ValueNode_BoneLink::create(Vector(0.0, 0.0));
+	link->set_link("bone", ValueNode_Const::create(ValueNode_Bone::Handle(bone)));
+
+	Layer::Handle layer = Layer::create("polygon");
+	layer->connect_dynamic_param("origin", ValueNode::LooseHandle(link));
+	canvas->push_back(layer);
+	layer->set_canvas(canvas);
+	return layer;
+}
+
+static int check_origin(const char *test, const Layer::Handle &layer, Real expected)
+{
+	Vector origin = layer->get_param("origin").get(Vector());
+	if (fabs(origin[0] - expected) > 1e-8)
+	{
+		cerr << test << ": origin " << origin[0] << " expected " << expected << endl;
+		return 1;
+	}
+	return 0;
+}
+
+// layer bound to animated bone follows the bone
+int timeinvariant_test1()
+{
+	ValueNode_Bone::Handle bone = ValueNode_Bone::create(Bone());
+	bone->set_link("origin", create_animated_origin());
+
+	Canvas::Handle canvas = Canvas::create();
+	Layer::Handle layer = create_layer(canvas, bone);
+	if (layer->is_time_invariant())
+	{
+		cerr << "timeinvariant_test1: layer bound to animated bone is time invariant" << endl;
+		return 1;
+	}
+
+	canvas->set_time(Time(0.0));
+	if (check_origin("timeinvariant_test1", layer, 0.0)) return 1;
+	canvas->set_time(Time(1.0));
+	if (check_origin("timeinvariant_test1", layer, 1.0)) return 1;
+
+	return 0;
+}
+
+// bone animated after the layer was evaluated is still followed
+int timeinvariant_test2()
+{
+	ValueNode_Bone::Handle bone = ValueNode_Bone::create(Bone());
+
+	Canvas::Handle canvas = Canvas::create();
+	Layer::Handle layer = create_layer(canvas, bone);
+	canvas->set_time(Time(0.0));
+	if (check_origin("timeinvariant_test2", layer, 0.0)) return 1;
+
+	bone->set_link("origin", create_animated_origin());
+	canvas->set_time(Time(1.0));
+	if (check_origin("timeinvariant_test2", layer, 1.0)) return 1;
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	Type::subsys_init();
+	Layer::subsys_init();
+
+	int failures = 0;
+
+	failures += timeinvariant_test1();
+	failures += timeinvariant_test2();
+
+	Layer::subsys_stop();
+	Type::subsys_stop();
+	return failures;
+}
@@ -0,0 +1,240 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file tool.cpp
+**	\brief Synfig Tool Frames Selection Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cstdio>
+#include <iostream>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <synfig/renddesc.h>
+#include <tool/definitions.h>
+#include <tool/job.h>
+#include <tool/joblistprocessor.h>
+#include <tool/optionsprocessor.h>
+#include <tool/synfigtoolexception.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace etl;
+using namespace synfig;
+namespace po=boost::program_options;
+namespace bfs=boost::filesystem;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// frames 0-20
+static RendDesc create_renddesc()
+{
+	RendDesc desc;
+	desc.set_frame_rate(24);
+	desc.set_time_start(0);
+	desc.set_frame_end(20);
+	return desc;
+}
+
+// selects frames by command line options, returns false if options are rejected
+static bool extract_frames(const map<string, string> &options, vector<int> &frames)
+{
+	po::variables_map vm;
+	for(map<string, string>::const_iterator i = options.begin(); i != options.end(); ++i)
+		vm.insert(make_pair(i->first, po::variable_value(i->second, false)));
+	OptionsProcessor op(vm, po::options_description());
+	try
+	{
+		op.extract_frames(create_renddesc(), frames);
+	}
+	catch(SynfigToolException &)
+	{
+		return false;
+	}
+	return true;
+}
+
+// --frames
+int tool_test1()
+{
+	map<string, string> options;
+	vector<int> frames;
+
+	options["frames"] = "15,1,5,10-12,19-25";
+	int expected[] = { 1, 5, 10, 11, 12, 15, 19, 20 };
+	if (!extract_frames(options, frames)
+	 || frames != vector<int>(expected, expected + sizeof(expected)/sizeof(expected[0])))
+	{
+		cerr << "tool_test1: wrong frames of \"" << options["frames"] << "\"" << endl;
+		return 1;
+	}
+
+	const char *invalid[] = { "20-10", "1,a", "1-" };
+	for(int i = 0; i < (int)(sizeof(invalid)/sizeof(invalid[0])); ++i)
+	{
+		options["frames"] = invalid[i];
+		if (extract_frames(options, frames))
+		{
+			cerr << "tool_test1: frames \"" << options["frames"] << "\" should be rejected" << endl;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+// --shard and --shard-mode
+int tool_test2()
+{
+	const char *modes[] = { "contiguous", "interleaved" };
+	for(int m = 0; m < 2; ++m)
+	{
+		// shards together should render each frame once
+		multiset<int> all;
+		for(int i = 0; i < 3; ++i)
+		{
+			map<string, string> options;
+			options["frames"] = "2-18";
+			options["shard"] = strprintf("%d/3", i);
+			options["shard-mode"] = modes[m];
+			vector<int> frames;
+			if (!extract_frames(options, frames) || frames.size() < 5 || frames.size() > 6)
+			{
+				cerr << "tool_test2: wrong " << modes[m] << " shard " << i << endl;
+				return 1;
+			}
+			if (m == 0 && frames.back() - frames.front() + 1 != (int)frames.size())
+			{
+				cerr << "tool_test2: contiguous shard " << i << " has gaps" << endl;
+				return 1;
+			}
+			all.insert(frames.begin(), frames.end());
+		}
+		for(int i = 2; i <= 18; ++i)
+		{
+			if (all.count(i) != 1)
+			{
+				cerr << "tool_test2: frame " << i << " is rendered by " << all.count(i)
+					 << " " << modes[m] << " shards" << endl;
+				return 1;
+			}
+		}
+	}
+
+	map<string, string> options;
+	vector<int> frames;
+	const char *invalid[] = { "3/3", "-1/3", "1/0", "1" };
+	for(int i = 0; i < (int)(sizeof(invalid)/sizeof(invalid[0])); ++i)
+	{
+		options["shard"] = invalid[i];
+		if (extract_frames(options, frames))
+		{
+			cerr << "tool_test2: shard \"" << options["shard"] << "\" should be rejected" << endl;
+			return 1;
+		}
+	}
+	options["shard"] = "0/2";
+	options["shard-mode"] = "random";
+	if (extract_frames(options, frames))
+	{
+		cerr << "tool_test2: shard mode \"random\" should be rejected" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// jobs of shard and segments for --merge
+int tool_test3()
+{
+	int frames[] = { 1, 2, 3, 7, 8, 10 };
+	list<Job> jobs(1);
+	split_job_list(jobs, vector<int>(frames, frames + sizeof(frames)/sizeof(frames[0])));
+	int ranges[][2] = { { 1, 3 }, { 7, 8 }, { 10, 10 } };
+	int index = 0;
+	for(list<Job>::const_iterator i = jobs.begin(); i != jobs.end(); ++i, ++index)
+	{
+		if ( index >= 3 || !i->partial
+		  || i->frame_start != ranges[index][0]
+		  || i->frame_end != ranges[index][1] )
+		{
+			cerr << "tool_test3: wrong job " << index << " of shard" << endl;
+			return 1;
+		}
+	}
+	if (index != 3)
+	{
+		cerr << "tool_test3: " << index << " jobs instead of 3" << endl;
+		return 1;
+	}
+
+	// segments are named like setup of partial job does
+	bfs::path dir = bfs::temp_directory_path() / bfs::unique_path();
+	bfs::create_directories(dir);
+	const char *names[] = { "out.0001-0003.avi", "out.0007-0008.avi", "out.0010.avi", "out.0005-0004.avi", "other.0011-0012.avi" };
+	for(int i = 0; i < (int)(sizeof(names)/sizeof(names[0])); ++i)
+		fclose(fopen((dir / names[i]).string().c_str(), "w"));
+
+	map<int, pair<int, string> > segments;
+	find_segments((dir / "out.avi").string(), ".", segments);
+	bfs::remove_all(dir);
+
+	if ( segments.size() != 2
+	  || segments[1].first != 3 || segments[1].second != (dir / names[0]).string()
+	  || segments[7].first != 8 || segments[7].second != (dir / names[1]).string() )
+	{
+		cerr << "tool_test3: wrong segments found" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main(int /* argc */, char *argv[])
+{
+	SynfigToolGeneralOptions::create_singleton_instance(argv[0]);
+
+	int failures = 0;
+
+	failures += tool_test1();
+	failures += tool_test2();
+	failures += tool_test3();
+
+	return failures;
+}
@@ -0,0 +1,150 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file value.cpp
+**	\brief ValueBase Test File
+**
+**	$Id$
+**
+**	\legal
+**	Copyright (c) 2026 agent
+**
+**	This package is free software; you can redistribute it and/or
+**	modify it under the terms of the GNU General Public License as
+**	published by the Free Software Foundation; either version 2 of
+**	the License, or (at your option) any later version.
+**
+**	This package is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+**	General Public License for more details.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <iostream>
+#include <synfig/value.h>
+#include <synfig/type.h>
+#include <synfig/vector.h>
+#include <synfig/color.h>
+#include <synfig/angle.h>
+#include <synfig/time.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace std;
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+// copies and assignments of small values stored inside of ValueBase
+int value_test1()
+{
+	ValueBase a(Real(1.5));
+	ValueBase b(a);
+	b = Real(2.5);
+	if (a.get(Real()) != 1.5 || b.get(Real()) != 2.5)
+	{
+		cerr << "value_test1: copy of real is not independent" << endl;
+		return 1;
+	}
+
+	ValueBase c;
+	c = a;
+	a = Real(3.5);
+	if (c.get(Real()) != 1.5 || !a.is_valid() || !c.is_valid())
+	{
+		cerr << "value_test1: assignment of real is not independent" << endl;
+		return 1;
+	}
+
+	ValueBase t(Time(2.0));
+	t = c;
+	if (t.get_type() != type_time || t.get(Time()) != Time(1.5))
+	{
+		cerr << "value_test1: real is not converted into time" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// lists of values of different types
+int value_test2()
+{
+	ValueBase v(Vector(1.0, 2.0));
+	ValueBase::List list(3, v);
+	list[1] = Color(0.1f, 0.2f, 0.3f, 0.4f);
+	list[2] = String("string");
+	list.push_back(Angle::deg(90.0));
+	ValueBase l(list);
+	ValueBase::List copy = l.get_list();
+	if ( copy[0].get(Vector()) != Vector(1.0, 2.0)
+	  || copy[1].get(Color()) != Color(0.1f, 0.2f, 0.3f, 0.4f)
+	  || copy[2].get(String()) != "string"
+	  || copy[3].get(Angle()) != Angle::deg(90.0)
+	  || l != ValueBase(copy) )
+	{
+		cerr << "value_test2: list is not copied" << endl;
+		return 1;
+	}
+
+	copy[2] = Real(1.0);
+	copy[0] = copy[2];
+	if (copy[0].get_type() != type_real || copy[0] != copy[2])
+	{
+		cerr << "value_test2: item of list changes type wrong" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+// default values and clearing
+int value_test3()
+{
+	ValueBase d(type_bool);
+	if (!d.is_valid() || d.get(bool()))
+	{
+		cerr << "value_test3: wrong default value of bool" << endl;
+		return 1;
+	}
+
+	d.clear();
+	if (d.is_valid())
+	{
+		cerr << "value_test3: value is valid after clear()" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main()
+{
+	Type::subsys_init();
+
+	int failures = 0;
+
+	failures += value_test1();
+	failures += value_test2();
+	failures += value_test3();
+
+	Type::subsys_stop();
+	return failures;
+}